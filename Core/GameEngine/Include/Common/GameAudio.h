@@ -296,6 +296,9 @@ class AudioManager : public SubsystemInterface
 		// For the file cache to know when to remove files.
 		virtual void closeAnySamplesUsingFile( const void *fileToClose ) = 0;
 
+		// TheSuperHackers @performance 19/10/2026 Lets the device load the samples of an event before it is first played.
+		virtual void preloadAudioEvent( const AudioEventRTS *eventToPreload ) {}
+
 		virtual Bool isMusicAlreadyLoaded(void) const;
 
 		Bool getDisallowSpeech( void ) const { return m_disallowSpeech; }
@@ -373,6 +373,9 @@ public:
 	/// return the high-water mark for getUsedBlockCount()
 	Int getPeakBlockCount();
 
+	/// restart the high-water mark for getUsedBlockCount() at the current count
+	void resetPeakBlockCount();
+
 	/// return the initial allocation count for this pool
 	Int getInitialBlockCount();
 
@@ -537,6 +540,9 @@ public:
 	/// return the pool with the given name. if no such pool exists, return null.
 	MemoryPool *findMemoryPool(const char *poolName);
 
+	/// return the first pool in the list of pools, use MemoryPool::getNextPoolInList() for the next.
+	MemoryPool *getFirstMemoryPool() { return m_firstPoolInFactory; }
+
 	/// destroy the given pool.
 	void destroyMemoryPool(MemoryPool *pMemoryPool);
 
@@ -784,6 +790,7 @@ inline Int MemoryPool::getFreeBlockCount() { return getTotalBlockCount() - getUs
 inline Int MemoryPool::getUsedBlockCount() { return m_usedBlocksInPool; }
 inline Int MemoryPool::getTotalBlockCount() { return m_totalBlocksInPool; }
 inline Int MemoryPool::getPeakBlockCount() { return m_peakUsedBlocksInPool; }
+inline void MemoryPool::resetPeakBlockCount() { m_peakUsedBlocksInPool = m_usedBlocksInPool; }
 inline Int MemoryPool::getInitialBlockCount() { return m_initialAllocationCount; }
 
 // ----------------------------------------------------------------------------
@@ -824,6 +831,10 @@ extern void shutdownMemoryManager();
 extern MemoryPoolFactory *TheMemoryPoolFactory;
 extern DynamicMemoryAllocator *TheDynamicMemoryAllocator;
 
+// TheSuperHackers @performance 19/10/2026 Counts the allocations made through the game memory, for load
+// profiling. It is not synchronized between threads, so allocations on other threads may be missed.
+extern UnsignedInt TheMemoryAllocationCount;
+
 /**
 	This function is declared in this header, but is not defined anywhere -- you must provide
 	it in your code. It is called by initMemoryManager() or preMainInitMemoryManager() in order
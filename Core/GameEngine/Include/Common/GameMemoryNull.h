@@ -141,6 +141,7 @@ extern void shutdownMemoryManager();
 
 extern MemoryPoolFactory *TheMemoryPoolFactory;
 extern DynamicMemoryAllocator *TheDynamicMemoryAllocator;
+extern UnsignedInt TheMemoryAllocationCount;
 
 
 // TheSuperHackers @info
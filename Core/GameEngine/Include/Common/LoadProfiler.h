@@ -0,0 +1,55 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LoadProfiler.h ///////////////////////////////////////////////////////////////////////////
+// Measures the phases of a map load.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+// TheSuperHackers @performance 19/10/2026 A map load is split into phases at its load progress
+// milestones. Each phase records its wall time, the number of game memory allocations and the
+// bytes read from archive files. The phases also show up as scopes in the PerfTrace.
+// The result of every load is logged, and can be appended as one JSON line per load to a file,
+// for example with the -loadProfile <file> command line argument, to benchmark a set of maps.
+
+//-------------------------------------------------------------------------------------------------
+class LoadProfiler
+{
+public:
+
+	enum
+	{
+		MAX_PHASES = 32,
+	};
+
+	/// The file the results are appended to by end()
+	static void setOutputFile( const char *fileName );
+
+	static void begin( const char *mapName );		///< starts profiling a map load
+	static void endPhase( const char *name );		///< ends the current phase with this name, the next phase starts
+	static void end( Bool printResults );				///< ends the map load and reports it, also to stdout if printResults and an output file is set
+
+	static Bool isActive( void ) { return s_active; }
+
+private:
+
+	static Bool s_active;
+};
@@ -0,0 +1,104 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LogicBenchmark.h /////////////////////////////////////////////////////////////////////////
+// Measures the logic frame times of simulated replays by subsystem.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/PerfTrace.h"
+
+// TheSuperHackers @performance 19/10/2026 The benchmark is switched on with the -logicBenchmark <file>
+// command line argument and measures the replays simulated with -headless -replay. The phases of
+// GameLogic::update are timed by subsystem for every logic frame. At the end of each replay one JSON
+// line with the frame time percentiles, the peak process memory and the memory pool high-water marks
+// is appended to the file, so the results of different builds can be compared.
+// When no replay is measured, a scope costs a single test of a static flag.
+
+//-------------------------------------------------------------------------------------------------
+enum LogicBenchmarkSubsystem CPP_11(: Int)
+{
+	LOGIC_BENCHMARK_SCRIPTS,
+	LOGIC_BENCHMARK_TERRAIN,
+	LOGIC_BENCHMARK_CRC,
+	LOGIC_BENCHMARK_COMMANDS,
+	LOGIC_BENCHMARK_OBJECTS,
+	LOGIC_BENCHMARK_AI,						///< includes the pathfinder
+	LOGIC_BENCHMARK_PARTITION,
+	LOGIC_BENCHMARK_WEAPONS,				///< delayed weapon damage, weapons fired by object updates count as objects
+
+	LOGIC_BENCHMARK_SUBSYSTEM_COUNT
+};
+
+//-------------------------------------------------------------------------------------------------
+class LogicBenchmark
+{
+public:
+
+	/// The file the results are appended to, enables the benchmark
+	static void setOutputFile( const char *fileName );
+	static Bool isEnabled( void ) { return s_enabled; }
+
+	static void begin( const char *replayName, UnsignedInt frameCount );	///< starts measuring a replay of about frameCount frames
+	static void end( Bool crcMismatch, Bool printResults );				///< ends the replay and reports it, also to stdout if printResults
+
+	static Bool isActive( void ) { return s_active; }
+
+	static void beginFrame( void ) { if (s_active) startFrame(); }
+	static void endFrame( void ) { if (s_active) finishFrame(); }
+
+	static void addTime( LogicBenchmarkSubsystem subsystem, Int64 ticks ) { s_frameTicks[subsystem] += ticks; }
+
+private:
+
+	static void startFrame( void );
+	static void finishFrame( void );
+
+	static Bool s_enabled;
+	static Bool s_active;
+	static Int64 s_frameTicks[LOGIC_BENCHMARK_SUBSYSTEM_COUNT];
+};
+
+//-------------------------------------------------------------------------------------------------
+class LogicBenchmarkScope
+{
+public:
+	LogicBenchmarkScope( LogicBenchmarkSubsystem subsystem ) : m_active(LogicBenchmark::isActive())
+	{
+		if (m_active)
+		{
+			m_subsystem = subsystem;
+			m_startTime = PerfTrace::getTime();
+		}
+	}
+
+	~LogicBenchmarkScope()
+	{
+		if (m_active)
+			LogicBenchmark::addTime(m_subsystem, PerfTrace::getTime() - m_startTime);
+	}
+
+private:
+	Bool m_active;
+	LogicBenchmarkSubsystem m_subsystem;
+	Int64 m_startTime;
+};
+
+//-------------------------------------------------------------------------------------------------
+#define LOGIC_BENCHMARK_SCOPE(subsystem)		LogicBenchmarkScope t_logicBenchmark(subsystem);
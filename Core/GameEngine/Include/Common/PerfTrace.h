@@ -0,0 +1,111 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PerfTrace.h //////////////////////////////////////////////////////////////////////////////
+// Low overhead runtime tracing of timed scopes, exported as Chrome/Perfetto JSON trace.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+// TheSuperHackers @performance 19/10/2026 The trace is available in all build configurations and
+// is switched on at runtime, for example with the -perfTrace <file> command line argument.
+// Each thread records into its own ring buffer, so only the most recent events are kept.
+// A thread releases its buffer when it exits, so up to MAX_THREADS threads can record at the same time.
+// Timed scopes, subsystem updates, PerfGather timers and Profile ranges all feed the trace.
+// When the trace is off, a scope costs a single test of a static flag.
+//
+// The event names are not copied. Pass string literals or names returned by internName().
+
+//-------------------------------------------------------------------------------------------------
+class PerfTrace
+{
+public:
+
+	enum
+	{
+		MAX_THREADS = 8,
+		EVENTS_PER_THREAD = 1 << 16,	///< must be a power of two
+	};
+
+	static void setEnabled( Bool enabled );
+	static Bool isEnabled( void ) { return s_enabled; }
+
+	/// The file the trace is written to by exportToOutputFile()
+	static void setOutputFile( const char *fileName );
+
+	/// Returns the current trace time in ticks
+	static Int64 getTime( void );
+
+	/// Returns a copy of the name that lives until the process ends
+	static const char *internName( const char *name );
+
+	/// Records a scope that ran from startTime to endTime
+	static void addScope( const char *name, Int64 startTime, Int64 endTime );
+
+	/// Records the begin and end of a range that is not bound to a single scope
+	static void beginRange( const char *name );
+	static void endRange( const char *name );
+
+	/// Releases the buffer of the calling thread. Only needed in VC6 builds, the others release it at thread exit.
+	static void releaseThread( void );
+
+	/// Marks the start of a logic frame in the trace
+	static void markLogicFrame( UnsignedInt frame ) { if (s_enabled) addLogicFrame(frame); }
+
+	/// Discards all recorded events
+	static void reset( void );
+
+	/// Writes all recorded events as Chrome/Perfetto JSON trace
+	static Bool exportJson( const char *fileName );
+	static Bool exportToOutputFile( void );
+
+private:
+
+	static void addLogicFrame( UnsignedInt frame );
+
+	static Bool s_enabled;
+};
+
+//-------------------------------------------------------------------------------------------------
+class PerfTraceScope
+{
+public:
+	PerfTraceScope( const char *name ) : m_name(nullptr)
+	{
+		if (PerfTrace::isEnabled())
+		{
+			m_name = name;
+			m_startTime = PerfTrace::getTime();
+		}
+	}
+
+	~PerfTraceScope()
+	{
+		if (m_name)
+			PerfTrace::addScope(m_name, m_startTime, PerfTrace::getTime());
+	}
+
+private:
+	const char *m_name;
+	Int64 m_startTime;
+};
+
+//-------------------------------------------------------------------------------------------------
+#define PERF_TRACE_SCOPE(id)		PerfTraceScope t_##id(#id);
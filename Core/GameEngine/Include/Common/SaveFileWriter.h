@@ -0,0 +1,63 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: SaveFileWriter.h /////////////////////////////////////////////////////////////////////////
+// Writes serialized save files to disk on a worker thread.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <stdio.h>
+#include <vector>
+
+// TheSuperHackers @performance 19/10/2026 The game thread serializes a save into memory and hands
+// the data to this writer, which writes it to disk on a worker thread. Writes complete in the order
+// they were queued and the queue is bounded, queueing into a full queue waits for the oldest write.
+// The completion callbacks always run on the game thread, from update() or flush().
+// Builds without std::thread write synchronously and still report through the callbacks.
+
+//-------------------------------------------------------------------------------------------------
+class SaveFileWriter
+{
+public:
+
+	enum
+	{
+		MAX_QUEUED_WRITES = 1,
+	};
+
+	typedef void (*CompletionCallback)( const char *filePath, Bool success, void *userData );
+
+	/** Writes data to 'file', which is open for writing at tempFilePath, and renames it to filePath.
+		* Takes ownership of the file and of the contents of data. */
+	static void write( FILE *file, const char *tempFilePath, const char *filePath,
+										 std::vector<UnsignedByte> &data, CompletionCallback callback, void *userData );
+
+	/// Same as write, but writes on the calling thread and returns TRUE on success
+	static Bool writeNow( FILE *file, const char *tempFilePath, const char *filePath,
+												const UnsignedByte *data, UnsignedInt dataSize );
+
+	static Bool isBusy( void );		///< is a write queued or in progress
+
+	static void update( void );		///< runs the callbacks of completed writes
+	static void flush( void );		///< waits for all queued writes and runs their callbacks
+	static void shutdown( void );	///< flushes and stops the worker thread
+
+};
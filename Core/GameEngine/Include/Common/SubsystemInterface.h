@@ -30,6 +30,7 @@
 #pragma once
 
 #include "Common/INI.h"
+#include "Common/PerfTrace.h"
 #include "Common/STLTypedefs.h"
 
 class Xfer;
@@ -128,14 +129,19 @@ protected:
 	Bool m_dumpUpdate;
 	Bool m_dumpDraw;
 #else
-	void UPDATE(void) {update();}
-	void DRAW(void) {draw();}
+	void UPDATE(void) {if (PerfTrace::isEnabled()) tracedUpdate(); else update();}
+	void DRAW(void) {if (PerfTrace::isEnabled()) tracedDraw(); else draw();}
 #endif
 protected:
 	AsciiString m_name;
+	const char *m_traceName;	///< name of this subsystem in the PerfTrace, set on first use
+	const char *getTraceName(void);
+private:
+	void tracedUpdate(void);
+	void tracedDraw(void);
 public:
 	AsciiString getName(void) {return m_name;}
-	void setName(AsciiString name) {m_name = name;}
+	void setName(AsciiString name) {m_name = name; m_traceName = nullptr;}
 
 };
 
@@ -46,6 +46,7 @@ public:
 	virtual ~XferLoad( void );
 
 	virtual void open( AsciiString identifier );				///< open file for writing
+	void openBuffer( AsciiString identifier, const UnsignedByte *data, Int dataSize );	///< open data in memory for reading
 	virtual void close( void );													///< close file
 	virtual Int beginBlock( void );														///< read placeholder block size
 	virtual void endBlock( void );											///< reading an end block is a no-op
@@ -62,5 +63,8 @@ protected:
 	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
 
 	FILE * m_fileFP;																					///< pointer to file
+	const UnsignedByte *m_bufferData;													///< data from openBuffer, read instead of the file
+	Int m_bufferSize;
+	Int m_bufferPos;																					///< read position in m_bufferData
 
 };
@@ -31,6 +31,7 @@
 
 // USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
 #include "Common/Xfer.h"
+#include "Common/SaveFileWriter.h"
 
 // FORWARD REFERENCES /////////////////////////////////////////////////////////////////////////////
 class XferBlockData;
@@ -51,10 +52,14 @@ public:
 
 	// Xfer methods
 	virtual void open( AsciiString identifier );		///< open file for writing
-	virtual void close( void );											///< close file
+	virtual void close( void );											///< write the buffered data and close file
+	void closeAsync( SaveFileWriter::CompletionCallback callback, void *userData );	///< close file, the data is written on a worker thread
+	void discard( void );														///< close file without writing anything
+	void openBuffer( AsciiString identifier );			///< open for writing into memory only
+	void closeBuffer( std::vector<UnsignedByte> &data );	///< close a buffer from openBuffer and take its data
 	virtual Int beginBlock( void );									///< write placeholder block size
 	virtual void endBlock( void );									///< backup to last begin block and write size
-	virtual void skip( Int dataSize );							///< skipping during a write is a no-op
+	virtual void skip( Int dataSize );							///< skip forward, skipped bytes are zero
 
 	virtual void xferSnapshot( Snapshot *snapshot );		///< entry point for xfering a snapshot
 
@@ -66,7 +71,16 @@ protected:
 
 	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
 
-	FILE * m_fileFP;																			///< pointer to file
+	void deleteBlockStack( void );
+
+	// TheSuperHackers @performance 19/10/2026 Everything is serialized into m_buffer and block sizes are
+	// patched in place, the file is then written with one write to a temporary file that replaces the
+	// target on close. This avoids thousands of small writes and seeks, and a failed save keeps the old file.
+	FILE * m_fileFP;																			///< pointer to the temporary file
+	AsciiString m_tempFilePath;														///< file written before it replaces the target
+	std::vector<UnsignedByte> m_buffer;										///< the data to write
+	Bool m_bufferOnly;																		///< opened with openBuffer, there is no file
+	XferFilePos m_bufferPos;															///< write position in m_buffer
 	XferBlockData *m_blockStack;													///< stack of block data
 
 };
@@ -26,18 +26,18 @@
 
 #include "Common/GameMemory.h"
 #include "GameNetwork/NetCommandRef.h"
+#include <vector>
 
 /**
  * The NetCommandList is a ordered linked list of NetCommandRef objects.
  * The list is ordered based on the command id, player id, and command type.
  * It is ordered in this way to aid in constructing the packets efficiently.
- * The list keeps track of the last message inserted in order to accommodate
- * adding commands in order more efficiently since that is whats going to be
- * done most of the time.  If the new message doesn't go after the last message
- * inserted, then the list will be traversed linearly until the proper spot is
- * found.  We can get away with this inefficient method since these occurrences
- * will be rare.  Also, the list is not expected to ever have more than 30 or so
- * commands on it at a time.  Five commands would probably be a normal amount.
+ *
+ * TheSuperHackers @performance 19/10/2026 The list is now accompanied by two indices:
+ * a small sorted table of (command type, player id) groups that remembers the first and
+ * last node of each group, and a hash table over all commands that can be duplicates of
+ * each other. Inserting a command in order, duplicate detection and the lookup by command
+ * id no longer walk the list. Iteration order of the list is unchanged.
  */
 
 class NetCommandList : public MemoryPoolObject
@@ -62,7 +62,31 @@ public:
 	Int length();									///< Returns the number of nodes in this list.  This is inefficient and is meant to be a debug tool.
 
 protected:
+	/// The first and last node of all commands with the same command type and player id.
+	struct CommandGroup
+	{
+		UnsignedInt key;							///< Command type and player id, see getGroupKey.
+		NetCommandRef *first;
+		NetCommandRef *last;
+	};
+	typedef std::vector<CommandGroup> CommandGroupVec;
+	typedef std::vector<NetCommandRef *> CommandBucketVec;
+
+	static UnsignedInt getGroupKey(NetCommandMsg *msg);
+	static Bool isIndexedCommandMsg(NetCommandMsg *msg);	///< Can this message be equal to another message?
+	static UnsignedInt getIndexHash(NetCommandMsg *msg);	///< Hash that agrees with isEqualCommandMsg.
+
+	size_t findGroupIndex(UnsignedInt key) const;	///< Index of the first group with a key that is not less than the given key.
+	NetCommandRef * findIndexedMessage(NetCommandMsg *msg);
+	void addToIndex(NetCommandRef *ref);
+	void removeFromIndex(NetCommandRef *ref);
+	void growIndex();
+	void insertBefore(NetCommandRef *ref, NetCommandRef *before);
+	void insertAfter(NetCommandRef *ref, NetCommandRef *after);
+
 	NetCommandRef *m_first;							///< Head of the list.
 	NetCommandRef *m_last;							///< Tail of the list.
-	NetCommandRef *m_lastMessageInserted;			///< The last message that was inserted to this list.
+	CommandGroupVec m_groups;						///< Groups of the list, sorted by key.
+	CommandBucketVec m_buckets;						///< Hash buckets of indexed commands. Size is zero or a power of two.
+	UnsignedInt m_indexedCount;						///< Number of commands in the hash buckets.
 };
@@ -54,6 +54,8 @@ public:
 	NetCommandRef *getPrev();
 	void setNext(NetCommandRef *next);
 	void setPrev(NetCommandRef *prev);
+	NetCommandRef *getIndexNext();
+	void setIndexNext(NetCommandRef *indexNext);
 
 	void setRelay(UnsignedByte relay);
 	UnsignedByte getRelay() const;
@@ -65,6 +67,7 @@ protected:
 	NetCommandMsg *m_msg;
 	NetCommandRef *m_next;
 	NetCommandRef *m_prev;
+	NetCommandRef *m_indexNext; ///< Next reference in the same hash bucket of the owning NetCommandList.
 	UnsignedByte m_relay; ///< Need this in the command reference since the relay value will be different depending on where this particular reference is being sent.
 	time_t m_timeLastSent;
 
@@ -113,6 +116,22 @@ inline void NetCommandRef::setPrev(NetCommandRef *prev)
 	m_prev = prev;
 }
 
+/**
+ * Return the next command ref in the same hash bucket of the list.
+ */
+inline NetCommandRef * NetCommandRef::getIndexNext()
+{
+	return m_indexNext;
+}
+
+/**
+ * Set the next command ref in the same hash bucket of the list.
+ */
+inline void NetCommandRef::setIndexNext(NetCommandRef *indexNext)
+{
+	m_indexNext = indexNext;
+}
+
 /**
  * Return the time for the last time this command was sent from this reference.
  */
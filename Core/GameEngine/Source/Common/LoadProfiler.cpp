@@ -0,0 +1,186 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LoadProfiler.cpp /////////////////////////////////////////////////////////////////////////
+// Measures the phases of a map load.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/LoadProfiler.h"
+#include "Common/ArchiveFileSystem.h"
+#include "Common/PerfTrace.h"
+
+// VC6 has no long long, and its CRT only knows the I64 length modifier.
+#if defined(_MSC_VER) && _MSC_VER < 1300
+typedef Int64 LoadProfilerPrintInt64;
+#define LOAD_PROFILER_INT64_FORMAT "I64d"
+#else
+typedef long long LoadProfilerPrintInt64;
+#define LOAD_PROFILER_INT64_FORMAT "lld"
+#endif
+
+//-------------------------------------------------------------------------------------------------
+struct LoadProfilerPhase
+{
+	const char *name;
+	Int64 time;
+	UnsignedInt allocations;
+	Int64 archiveBytes;
+};
+
+static char s_outputFile[_MAX_PATH] = { 0 };
+static char s_mapName[_MAX_PATH] = { 0 };
+static Int64 s_frequency = 0;
+static Int64 s_beginTime = 0;
+static Int64 s_phaseTime = 0;
+static UnsignedInt s_phaseAllocationCount = 0;
+static Int64 s_phaseBytesRead = 0;
+static LoadProfilerPhase s_phases[LoadProfiler::MAX_PHASES];
+static Int s_phaseCount = 0;
+
+Bool LoadProfiler::s_active = FALSE;
+
+//-------------------------------------------------------------------------------------------------
+static double ticksToMs( Int64 ticks )
+{
+	return (double)ticks * 1000.0 / (double)s_frequency;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the string as JSON string contents */
+//-------------------------------------------------------------------------------------------------
+static void writeJsonString( FILE *fp, const char *str )
+{
+	for (; *str != '\0'; ++str)
+	{
+		if (*str == '\\' || *str == '"')
+			fputc('\\', fp);
+		fputc(*str, fp);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJson( FILE *fp, double totalMs )
+{
+	fprintf(fp, "{\"map\":\"");
+	writeJsonString(fp, s_mapName);
+	fprintf(fp, "\",\"totalMs\":%.3f,\"phases\":[", totalMs);
+
+	for (Int i = 0; i < s_phaseCount; ++i)
+	{
+		const LoadProfilerPhase &phase = s_phases[i];
+		fprintf(fp, "%s{\"name\":\"", i > 0 ? "," : "");
+		writeJsonString(fp, phase.name);
+		fprintf(fp, "\",\"ms\":%.3f,\"allocations\":%u,\"archiveBytes\":%" LOAD_PROFILER_INT64_FORMAT "}",
+			ticksToMs(phase.time), phase.allocations, (LoadProfilerPrintInt64)phase.archiveBytes);
+	}
+
+	fprintf(fp, "]}\n");
+}
+
+//-------------------------------------------------------------------------------------------------
+void LoadProfiler::setOutputFile( const char *fileName )
+{
+	strlcpy(s_outputFile, fileName, ARRAY_SIZE(s_outputFile));
+}
+
+//-------------------------------------------------------------------------------------------------
+void LoadProfiler::begin( const char *mapName )
+{
+	if (s_frequency == 0)
+	{
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		s_frequency = freq.QuadPart;
+	}
+
+	strlcpy(s_mapName, mapName, ARRAY_SIZE(s_mapName));
+	s_phaseCount = 0;
+	s_beginTime = PerfTrace::getTime();
+	s_phaseTime = s_beginTime;
+	s_phaseAllocationCount = TheMemoryAllocationCount;
+	s_phaseBytesRead = ArchiveFileSystem::getBytesRead();
+	s_active = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void LoadProfiler::endPhase( const char *name )
+{
+	if (!s_active)
+		return;
+
+	const Int64 time = PerfTrace::getTime();
+	const Int64 bytesRead = ArchiveFileSystem::getBytesRead();
+
+	if (PerfTrace::isEnabled())
+		PerfTrace::addScope(name, s_phaseTime, time);
+
+	if (s_phaseCount < MAX_PHASES)
+	{
+		LoadProfilerPhase &phase = s_phases[s_phaseCount++];
+		phase.name = name;
+		phase.time = time - s_phaseTime;
+		phase.allocations = TheMemoryAllocationCount - s_phaseAllocationCount;
+		phase.archiveBytes = bytesRead - s_phaseBytesRead;
+	}
+
+	s_phaseTime = time;
+	s_phaseAllocationCount = TheMemoryAllocationCount;
+	s_phaseBytesRead = bytesRead;
+}
+
+//-------------------------------------------------------------------------------------------------
+void LoadProfiler::end( Bool printResults )
+{
+	if (!s_active)
+		return;
+
+	s_active = FALSE;
+
+	const double totalMs = ticksToMs(PerfTrace::getTime() - s_beginTime);
+
+	DEBUG_LOG(("LoadProfiler: Loaded '%s' in %.3f ms", s_mapName, totalMs));
+	for (Int i = 0; i < s_phaseCount; ++i)
+	{
+		const LoadProfilerPhase &phase = s_phases[i];
+		DEBUG_LOG(("LoadProfiler:   %-28s %10.3f ms %10u allocations %12" LOAD_PROFILER_INT64_FORMAT " archive bytes",
+			phase.name, ticksToMs(phase.time), phase.allocations, (LoadProfilerPrintInt64)phase.archiveBytes));
+	}
+
+	if (s_outputFile[0] != '\0')
+	{
+		FILE *fp = fopen(s_outputFile, "a");
+		if (fp != nullptr)
+		{
+			writeJson(fp, totalMs);
+			fclose(fp);
+		}
+		else
+		{
+			DEBUG_LOG(("LoadProfiler: Unable to write results file '%s'", s_outputFile));
+		}
+
+		// only when asked for, so that the output of the replay checks stays unchanged
+		if (printResults)
+		{
+			writeJson(stdout, totalMs);
+			fflush(stdout);
+		}
+	}
+}
@@ -0,0 +1,330 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LogicBenchmark.cpp ///////////////////////////////////////////////////////////////////////
+// Measures the logic frame times of simulated replays by subsystem.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/LogicBenchmark.h"
+
+#include <algorithm>
+
+// The version of the JSON format, increment it when existing fields change their meaning.
+#define LOGIC_BENCHMARK_VERSION 2
+
+// VC6 has no long long, and its CRT only knows the I64 length modifier.
+#if defined(_MSC_VER) && _MSC_VER < 1300
+typedef UnsignedInt64 LogicBenchmarkPrintUInt64;
+#define LOGIC_BENCHMARK_UINT64_FORMAT "I64u"
+#else
+typedef unsigned long long LogicBenchmarkPrintUInt64;
+#define LOGIC_BENCHMARK_UINT64_FORMAT "llu"
+#endif
+
+// The psapi functions are loaded dynamically, so the game does not need to link psapi.lib.
+// The struct is defined here because the Windows headers that VC6 uses do not have it.
+struct LogicBenchmarkMemoryCounters
+{
+	DWORD cb;
+	DWORD PageFaultCount;
+	SIZE_T PeakWorkingSetSize;
+	SIZE_T WorkingSetSize;
+	SIZE_T QuotaPeakPagedPoolUsage;
+	SIZE_T QuotaPagedPoolUsage;
+	SIZE_T QuotaPeakNonPagedPoolUsage;
+	SIZE_T QuotaNonPagedPoolUsage;
+	SIZE_T PagefileUsage;
+	SIZE_T PeakPagefileUsage;
+};
+
+typedef BOOL (WINAPI *PFN_GetProcessMemoryInfo)(HANDLE, LogicBenchmarkMemoryCounters *, DWORD);
+
+//-------------------------------------------------------------------------------------------------
+/** The frame times of one subsystem, or of the whole frame */
+//-------------------------------------------------------------------------------------------------
+struct LogicBenchmarkTimes
+{
+	std::vector<Real> frameMs;
+	double totalMs;
+};
+
+static const char *const s_subsystemNames[LOGIC_BENCHMARK_SUBSYSTEM_COUNT] =
+{
+	"scripts",
+	"terrain",
+	"crc",
+	"commands",
+	"objects",
+	"ai",
+	"partition",
+	"weapons",
+};
+
+static char s_outputFile[_MAX_PATH] = { 0 };
+static char s_replayName[_MAX_PATH] = { 0 };
+static Int64 s_frequency = 0;
+static Int64 s_frameStartTime = 0;
+static LogicBenchmarkTimes s_subsystemTimes[LOGIC_BENCHMARK_SUBSYSTEM_COUNT];
+static LogicBenchmarkTimes s_otherTimes;		///< the part of the frame not in any subsystem
+static LogicBenchmarkTimes s_frameTimes;
+static SIZE_T s_peakWorkingSetBytes = 0;	///< the high-water marks of this replay, sampled every frame
+static SIZE_T s_peakPagefileBytes = 0;
+
+Bool LogicBenchmark::s_enabled = FALSE;
+Bool LogicBenchmark::s_active = FALSE;
+Int64 LogicBenchmark::s_frameTicks[LOGIC_BENCHMARK_SUBSYSTEM_COUNT];
+
+//-------------------------------------------------------------------------------------------------
+static double ticksToMs( Int64 ticks )
+{
+	return (double)ticks * 1000.0 / (double)s_frequency;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void resetTimes( LogicBenchmarkTimes &times )
+{
+	std::vector<Real> empty;
+	times.frameMs.swap(empty);
+	times.totalMs = 0.0;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void reserveTimes( LogicBenchmarkTimes &times, UnsignedInt frameCount )
+{
+	times.frameMs.reserve(frameCount);
+}
+
+//-------------------------------------------------------------------------------------------------
+static void addFrameTime( LogicBenchmarkTimes &times, double ms )
+{
+	times.frameMs.push_back((Real)ms);
+	times.totalMs += ms;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Returns the frame time below which the given percent of the frames are. Reorders the times. */
+//-------------------------------------------------------------------------------------------------
+static Real getPercentile( std::vector<Real> &frameMs, Int percent )
+{
+	if (frameMs.empty())
+		return 0.0f;
+
+	std::vector<Real>::iterator it = frameMs.begin() + (frameMs.size() - 1) * percent / 100;
+	std::nth_element(frameMs.begin(), it, frameMs.end());
+	return *it;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJsonString( FILE *fp, const char *str )
+{
+	for (; *str != '\0'; ++str)
+	{
+		if (*str == '\\' || *str == '"')
+			fputc('\\', fp);
+		fputc(*str, fp);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJsonTimes( FILE *fp, const char *name, LogicBenchmarkTimes &times )
+{
+	const Real maxMs = times.frameMs.empty() ? 0.0f : *std::max_element(times.frameMs.begin(), times.frameMs.end());
+	const Real p50Ms = getPercentile(times.frameMs, 50);
+	const Real p99Ms = getPercentile(times.frameMs, 99);
+
+	fprintf(fp, "\"%s\":{\"totalMs\":%.3f,\"p50Ms\":%.4f,\"p99Ms\":%.4f,\"maxMs\":%.4f}",
+		name, times.totalMs, p50Ms, p99Ms, maxMs);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Raises the memory high-water marks of this replay to the current memory use of the process.
+	* The peak counters of the process cannot be reset, so they would include the earlier replays. */
+//-------------------------------------------------------------------------------------------------
+static void sampleMemory( void )
+{
+	static PFN_GetProcessMemoryInfo getProcessMemoryInfo =
+		(PFN_GetProcessMemoryInfo)GetProcAddress(LoadLibraryA("psapi.dll"), "GetProcessMemoryInfo");
+
+	if (getProcessMemoryInfo == nullptr)
+		return;
+
+	LogicBenchmarkMemoryCounters counters;
+	memset(&counters, 0, sizeof(counters));
+	counters.cb = sizeof(counters);
+	if (!getProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return;
+
+	s_peakWorkingSetBytes = std::max(s_peakWorkingSetBytes, counters.WorkingSetSize);
+	s_peakPagefileBytes = std::max(s_peakPagefileBytes, counters.PagefileUsage);
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJsonMemory( FILE *fp )
+{
+	fprintf(fp, "\"peakWorkingSetBytes\":%" LOGIC_BENCHMARK_UINT64_FORMAT ",\"peakPagefileBytes\":%" LOGIC_BENCHMARK_UINT64_FORMAT ",\"pools\":[",
+		(LogicBenchmarkPrintUInt64)s_peakWorkingSetBytes, (LogicBenchmarkPrintUInt64)s_peakPagefileBytes);
+
+#ifndef DISABLE_GAMEMEMORY
+	Bool first = TRUE;
+	for (MemoryPool *pool = TheMemoryPoolFactory->getFirstMemoryPool(); pool; pool = pool->getNextPoolInList())
+	{
+		if (pool->getPeakBlockCount() == 0)
+			continue;
+
+		fprintf(fp, "%s{\"name\":\"", first ? "" : ",");
+		writeJsonString(fp, pool->getPoolName());
+		fprintf(fp, "\",\"blockSize\":%d,\"peakBlocks\":%d}", pool->getAllocationSize(), pool->getPeakBlockCount());
+		first = FALSE;
+	}
+#endif
+
+	fprintf(fp, "]");
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJson( FILE *fp, Bool crcMismatch )
+{
+	fprintf(fp, "{\"version\":%d,\"replay\":\"", LOGIC_BENCHMARK_VERSION);
+	writeJsonString(fp, s_replayName);
+	fprintf(fp, "\",\"frames\":%u,\"crcMismatch\":%s,", (UnsignedInt)s_frameTimes.frameMs.size(), crcMismatch ? "true" : "false");
+
+	writeJsonTimes(fp, "frame", s_frameTimes);
+	fprintf(fp, ",\"subsystems\":{");
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+	{
+		writeJsonTimes(fp, s_subsystemNames[i], s_subsystemTimes[i]);
+		fprintf(fp, ",");
+	}
+	writeJsonTimes(fp, "other", s_otherTimes);
+	fprintf(fp, "},");
+
+	writeJsonMemory(fp);
+	fprintf(fp, "}\n");
+}
+
+//-------------------------------------------------------------------------------------------------
+void LogicBenchmark::setOutputFile( const char *fileName )
+{
+	strlcpy(s_outputFile, fileName, ARRAY_SIZE(s_outputFile));
+	s_enabled = s_outputFile[0] != '\0';
+}
+
+//-------------------------------------------------------------------------------------------------
+void LogicBenchmark::begin( const char *replayName, UnsignedInt frameCount )
+{
+	if (!s_enabled)
+		return;
+
+	if (s_frequency == 0)
+	{
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		s_frequency = freq.QuadPart;
+	}
+
+	strlcpy(s_replayName, replayName, ARRAY_SIZE(s_replayName));
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+		resetTimes(s_subsystemTimes[i]);
+	resetTimes(s_otherTimes);
+	resetTimes(s_frameTimes);
+
+	// The frame times allocate from the game memory, so they must not grow while the pool peaks are measured.
+	// The playback can run a little past the frame count of the header.
+	const UnsignedInt reserveFrames = frameCount + LOGICFRAMES_PER_SECOND;
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+		reserveTimes(s_subsystemTimes[i], reserveFrames);
+	reserveTimes(s_otherTimes, reserveFrames);
+	reserveTimes(s_frameTimes, reserveFrames);
+
+	s_peakWorkingSetBytes = 0;
+	s_peakPagefileBytes = 0;
+	sampleMemory();
+
+#ifndef DISABLE_GAMEMEMORY
+	// measure the high-water marks of this replay only
+	for (MemoryPool *pool = TheMemoryPoolFactory->getFirstMemoryPool(); pool; pool = pool->getNextPoolInList())
+		pool->resetPeakBlockCount();
+#endif
+
+	s_active = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void LogicBenchmark::startFrame( void )
+{
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+		s_frameTicks[i] = 0;
+
+	s_frameStartTime = PerfTrace::getTime();
+}
+
+//-------------------------------------------------------------------------------------------------
+void LogicBenchmark::finishFrame( void )
+{
+	const Int64 frameTicks = PerfTrace::getTime() - s_frameStartTime;
+	Int64 subsystemTicks = 0;
+
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+	{
+		addFrameTime(s_subsystemTimes[i], ticksToMs(s_frameTicks[i]));
+		subsystemTicks += s_frameTicks[i];
+	}
+
+	addFrameTime(s_otherTimes, ticksToMs(frameTicks - subsystemTicks));
+	addFrameTime(s_frameTimes, ticksToMs(frameTicks));
+
+	// outside of the measured frame time
+	sampleMemory();
+}
+
+//-------------------------------------------------------------------------------------------------
+void LogicBenchmark::end( Bool crcMismatch, Bool printResults )
+{
+	if (!s_active)
+		return;
+
+	s_active = FALSE;
+
+	DEBUG_LOG(("LogicBenchmark: Simulated '%s', %u frames in %.3f ms", s_replayName,
+		(UnsignedInt)s_frameTimes.frameMs.size(), s_frameTimes.totalMs));
+
+	FILE *fp = fopen(s_outputFile, "a");
+	if (fp != nullptr)
+	{
+		writeJson(fp, crcMismatch);
+		fclose(fp);
+	}
+	else
+	{
+		DEBUG_LOG(("LogicBenchmark: Unable to write results file '%s'", s_outputFile));
+	}
+
+	if (printResults)
+	{
+		writeJson(stdout, crcMismatch);
+		fflush(stdout);
+	}
+
+	// release the frame times
+	for (Int i = 0; i < LOGIC_BENCHMARK_SUBSYSTEM_COUNT; ++i)
+		resetTimes(s_subsystemTimes[i]);
+	resetTimes(s_otherTimes);
+	resetTimes(s_frameTimes);
+}
@@ -0,0 +1,395 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PerfTrace.cpp ////////////////////////////////////////////////////////////////////////////
+// Low overhead runtime tracing of timed scopes, exported as Chrome/Perfetto JSON trace.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/PerfTrace.h"
+
+#include "mutex.h"
+
+#ifdef RTS_PROFILE
+#include <rts/profile.h>
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1300
+#define PERF_TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define PERF_TRACE_THREAD_LOCAL thread_local
+#endif
+
+//-------------------------------------------------------------------------------------------------
+enum PerfTraceEventType CPP_11(: UnsignedByte)
+{
+	PERF_TRACE_SCOPE_EVENT,
+	PERF_TRACE_BEGIN_EVENT,
+	PERF_TRACE_END_EVENT,
+	PERF_TRACE_FRAME_EVENT,
+};
+
+//-------------------------------------------------------------------------------------------------
+struct PerfTraceEvent
+{
+	const char *name;
+	Int64 time;
+	Int64 value;	///< duration for scopes, frame number for frame markers
+	PerfTraceEventType type;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Events of one thread. Only the owning thread writes to it. A thread that exits releases its
+	* buffer, and the next new thread continues recording into it. */
+struct PerfTraceBuffer
+{
+	PerfTraceEvent *events;
+	UnsignedInt count;	///< total number of events written, the ring index is count % EVENTS_PER_THREAD
+	Bool inUse;
+};
+
+//-------------------------------------------------------------------------------------------------
+Bool PerfTrace::s_enabled = FALSE;
+
+static PerfTraceBuffer s_buffers[PerfTrace::MAX_THREADS];
+static Int s_bufferCount = 0;
+static PERF_TRACE_THREAD_LOCAL PerfTraceBuffer *s_threadBuffer = nullptr;
+static PERF_TRACE_THREAD_LOCAL Bool s_threadBufferFull = FALSE;
+static Bool s_droppedThreadLogged = FALSE;
+
+#if !(defined(_MSC_VER) && _MSC_VER < 1300)
+//-------------------------------------------------------------------------------------------------
+/** Releases the buffer of a thread when the thread exits. VC6 does not run destructors of thread
+	* local objects, so there the threads must call PerfTrace::releaseThread() themselves. */
+struct PerfTraceThreadExit
+{
+	Bool armed;
+	~PerfTraceThreadExit() { if (armed) PerfTrace::releaseThread(); }
+};
+
+static thread_local PerfTraceThreadExit s_threadExit = { FALSE };
+#endif
+
+static std::vector<char *> s_names;
+static FastCriticalSectionClass s_lock;
+
+static Int64 s_frequency = 0;
+static Int64 s_startTime = 0;
+static char s_outputFile[_MAX_PATH] = { 0 };
+
+//-------------------------------------------------------------------------------------------------
+/** Returns the ring buffer of the calling thread, or null if too many threads record at the same time. */
+static PerfTraceBuffer *getThreadBuffer()
+{
+	if (s_threadBuffer != nullptr || s_threadBufferFull)
+		return s_threadBuffer;
+
+	FastCriticalSectionClass::LockClass lock(s_lock);
+
+	PerfTraceBuffer *buffer = nullptr;
+	for (Int i = 0; i < s_bufferCount; ++i)
+	{
+		if (!s_buffers[i].inUse)
+		{
+			buffer = &s_buffers[i];
+			break;
+		}
+	}
+
+	if (buffer == nullptr && s_bufferCount < PerfTrace::MAX_THREADS)
+	{
+		PerfTraceEvent *events = (PerfTraceEvent *)malloc(PerfTrace::EVENTS_PER_THREAD * sizeof(PerfTraceEvent));
+		if (events != nullptr)
+		{
+			buffer = &s_buffers[s_bufferCount++];
+			buffer->events = events;
+			buffer->count = 0;
+		}
+	}
+
+	if (buffer == nullptr)
+	{
+		s_threadBufferFull = TRUE;
+		if (!s_droppedThreadLogged)
+		{
+			s_droppedThreadLogged = TRUE;
+			DEBUG_LOG(("PerfTrace: More than %d threads record at the same time, the events of the others are dropped", (Int)PerfTrace::MAX_THREADS));
+		}
+		return nullptr;
+	}
+
+	buffer->inUse = TRUE;
+	s_threadBuffer = buffer;
+#if !(defined(_MSC_VER) && _MSC_VER < 1300)
+	s_threadExit.armed = TRUE;
+#endif
+	return buffer;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void addEvent(PerfTraceEventType type, const char *name, Int64 time, Int64 value)
+{
+	PerfTraceBuffer *buffer = getThreadBuffer();
+	if (buffer == nullptr)
+		return;
+
+	PerfTraceEvent &ev = buffer->events[buffer->count & (PerfTrace::EVENTS_PER_THREAD - 1)];
+	ev.name = name;
+	ev.time = time;
+	ev.value = value;
+	ev.type = type;
+	++buffer->count;
+}
+
+#ifdef RTS_PROFILE
+//-------------------------------------------------------------------------------------------------
+/** Forwards the Profile ranges. The range names are owned by the profile module and never freed. */
+static void profileRangeCallback(const char *range, bool start)
+{
+	if (start)
+		PerfTrace::beginRange(range);
+	else
+		PerfTrace::endRange(range);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::setEnabled( Bool enabled )
+{
+	if (s_frequency == 0)
+	{
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		s_frequency = freq.QuadPart;
+		s_startTime = getTime();
+	}
+
+#ifdef RTS_PROFILE
+	Profile::SetRangeCallback(enabled ? profileRangeCallback : nullptr);
+#endif
+
+	s_enabled = enabled;
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::setOutputFile( const char *fileName )
+{
+	strlcpy(s_outputFile, fileName, ARRAY_SIZE(s_outputFile));
+}
+
+//-------------------------------------------------------------------------------------------------
+Int64 PerfTrace::getTime( void )
+{
+	LARGE_INTEGER tick;
+	QueryPerformanceCounter(&tick);
+	return tick.QuadPart;
+}
+
+//-------------------------------------------------------------------------------------------------
+const char *PerfTrace::internName( const char *name )
+{
+	FastCriticalSectionClass::LockClass lock(s_lock);
+
+	for (std::vector<char *>::const_iterator it = s_names.begin(); it != s_names.end(); ++it)
+	{
+		if (strcmp(*it, name) == 0)
+			return *it;
+	}
+
+	const size_t size = strlen(name) + 1;
+	char *copy = (char *)malloc(size);
+	if (copy == nullptr)
+		return "";
+
+	memcpy(copy, name, size);
+	s_names.push_back(copy);
+	return copy;
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::addScope( const char *name, Int64 startTime, Int64 endTime )
+{
+	addEvent(PERF_TRACE_SCOPE_EVENT, name, startTime, endTime - startTime);
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::beginRange( const char *name )
+{
+	if (s_enabled)
+		addEvent(PERF_TRACE_BEGIN_EVENT, name, getTime(), 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::endRange( const char *name )
+{
+	if (s_enabled)
+		addEvent(PERF_TRACE_END_EVENT, name, getTime(), 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::releaseThread( void )
+{
+	if (s_threadBuffer == nullptr)
+		return;
+
+	FastCriticalSectionClass::LockClass lock(s_lock);
+
+	s_threadBuffer->inUse = FALSE;
+	s_threadBuffer = nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+void PerfTrace::addLogicFrame( UnsignedInt frame )
+{
+	addEvent(PERF_TRACE_FRAME_EVENT, "LogicFrame", getTime(), frame);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Must not be called while other threads are recording. */
+void PerfTrace::reset( void )
+{
+	FastCriticalSectionClass::LockClass lock(s_lock);
+
+	for (Int i = 0; i < s_bufferCount; ++i)
+		s_buffers[i].count = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeJsonString(FILE *fp, const char *str)
+{
+	fputc('"', fp);
+	for (; *str; ++str)
+	{
+		const char c = *str;
+		if (c == '"' || c == '\\')
+			fputc('\\', fp);
+		if ((unsigned char)c >= ' ')
+			fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Marks the begin and end events whose other half is not in the events from begin to end. The ring
+	* overwrites the begin of the oldest ranges, and ranges that are still open have no end yet. */
+static void findUnmatchedRangeEvents(const PerfTraceBuffer &buffer, UnsignedInt begin, UnsignedInt end, std::vector<Bool> &unmatched)
+{
+	unmatched.assign(end - begin, FALSE);
+
+	std::vector<UnsignedInt> openRanges;
+	for (UnsignedInt i = begin; i != end; ++i)
+	{
+		const PerfTraceEvent &ev = buffer.events[i & (PerfTrace::EVENTS_PER_THREAD - 1)];
+		if (ev.type == PERF_TRACE_BEGIN_EVENT)
+		{
+			openRanges.push_back(i - begin);
+		}
+		else if (ev.type == PERF_TRACE_END_EVENT)
+		{
+			if (openRanges.empty())
+				unmatched[i - begin] = TRUE;
+			else
+				openRanges.pop_back();
+		}
+	}
+
+	for (size_t r = 0; r < openRanges.size(); ++r)
+		unmatched[openRanges[r]] = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Writes all recorded events. Threads that are still recording may tear the oldest events. */
+Bool PerfTrace::exportJson( const char *fileName )
+{
+	if (fileName == nullptr || fileName[0] == '\0' || s_frequency == 0)
+		return FALSE;
+
+	FILE *fp = fopen(fileName, "w");
+	if (fp == nullptr)
+	{
+		DEBUG_LOG(("PerfTrace: Unable to write trace file '%s'", fileName));
+		return FALSE;
+	}
+
+	const double usecPerTick = 1000000.0 / (double)s_frequency;
+	const Int bufferCount = s_bufferCount;
+	std::vector<Bool> unmatched;
+
+	fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Generals\"}}");
+
+	for (Int t = 0; t < bufferCount; ++t)
+	{
+		const PerfTraceBuffer &buffer = s_buffers[t];
+		const Int tid = t + 1;
+		const UnsignedInt end = buffer.count;
+		const UnsignedInt begin = end > (UnsignedInt)EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+
+		fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Thread %d\"}}", tid, tid);
+
+		findUnmatchedRangeEvents(buffer, begin, end, unmatched);
+
+		for (UnsignedInt i = begin; i != end; ++i)
+		{
+			if (unmatched[i - begin])
+				continue;
+
+			const PerfTraceEvent &ev = buffer.events[i & (EVENTS_PER_THREAD - 1)];
+			const double ts = (double)(ev.time - s_startTime) * usecPerTick;
+
+			fprintf(fp, ",\n{\"name\":");
+			writeJsonString(fp, ev.name);
+
+			switch (ev.type)
+			{
+				case PERF_TRACE_SCOPE_EVENT:
+					fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}", ts, (double)ev.value * usecPerTick, tid);
+					break;
+				case PERF_TRACE_BEGIN_EVENT:
+					fprintf(fp, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", ts, tid);
+					break;
+				case PERF_TRACE_END_EVENT:
+					fprintf(fp, ",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", ts, tid);
+					break;
+				case PERF_TRACE_FRAME_EVENT:
+					fprintf(fp, ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"frame\":%u}}", ts, tid, (UnsignedInt)ev.value);
+					break;
+			}
+		}
+	}
+
+	fprintf(fp, "\n]}\n");
+	fclose(fp);
+
+	DEBUG_LOG(("PerfTrace: Wrote trace file '%s'", fileName));
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool PerfTrace::exportToOutputFile( void )
+{
+	if (s_outputFile[0] == '\0')
+		return FALSE;
+
+	const Bool wasEnabled = s_enabled;
+	s_enabled = FALSE;
+	const Bool success = exportJson(s_outputFile);
+	s_enabled = wasEnabled;
+	return success;
+}
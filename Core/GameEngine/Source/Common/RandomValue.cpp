@@ -148,6 +148,16 @@ UnsignedInt GetGameLogicRandomSeedCRC( void )
 	return c.get();
 }
 
+void GetGameLogicRandomState( UnsignedInt state[6] )
+{
+	memcpy(state, theGameLogicSeed, 6*sizeof(UnsignedInt));
+}
+
+void SetGameLogicRandomState( const UnsignedInt state[6] )
+{
+	memcpy(theGameLogicSeed, state, 6*sizeof(UnsignedInt));
+}
+
 void InitRandom( void )
 {
 #ifdef DETERMINISTIC
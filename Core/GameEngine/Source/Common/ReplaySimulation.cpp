@@ -22,6 +22,7 @@
 
 #include "Common/GameEngine.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/LogicBenchmark.h"
 #include "Common/Recorder.h"
 #include "Common/WorkerProcess.h"
 #include "GameLogic/GameLogic.h"
@@ -45,6 +46,41 @@ int countProcessesRunning(const std::vector<WorkerProcess>& processes)
 	}
 	return numProcessesRunning;
 }
+
+// A replay passed more than once is checked against the checkpoints of its earlier pass.
+Bool reportCheckpointMismatch()
+{
+	const UnsignedInt frame = TheRecorder->getCheckpointMismatchFrame();
+	if (frame == 0)
+		return FALSE;
+	printf("Checkpoint CRC differs from the earlier pass at frame %u\n", frame);
+	fflush(stdout);
+	return TRUE;
+}
+
+// Runs the headless playback until it ends or its CRC mismatches.
+void simulatePlayback(DWORD startTimeMillis, UnsignedInt totalTimeSec)
+{
+	while (TheRecorder->isPlaybackInProgress())
+	{
+		TheGameClient->updateHeadless();
+
+		const int progressFrameInterval = 10*60*LOGICFRAMES_PER_SECOND;
+		if (TheGameLogic->getFrame() != 0 && TheGameLogic->getFrame() % progressFrameInterval == 0)
+		{
+			// Print progress report
+			UnsignedInt gameTimeSec = TheGameLogic->getFrame() / LOGICFRAMES_PER_SECOND;
+			UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
+			printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
+					realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
+			fflush(stdout);
+		}
+		TheRecorder->updateCheckpoints();
+		TheGameLogic->UPDATE();
+		if (TheRecorder->sawCRCMismatch())
+			break;
+	}
+}
 } // namespace
 
 int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString> &filenames)
@@ -61,8 +97,10 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		for (; s_replayIndex < s_replayCount; ++s_replayIndex)
 		{
 			TheRecorder->playbackFile(filenames[s_replayIndex]);
+			if (TheGlobalData->m_replaySeekFrame != 0)
+				TheRecorder->seekToFrame(TheGlobalData->m_replaySeekFrame);
 			TheGameEngine->execute();
-			if (TheRecorder->sawCRCMismatch())
+			if (TheRecorder->sawCRCMismatch() || reportCheckpointMismatch())
 				numErrors++;
 			if (!s_isRunning)
 				break;
@@ -84,32 +122,28 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		if (TheRecorder->simulateReplay(filename))
 		{
 			UnsignedInt totalTimeSec = TheRecorder->getPlaybackFrameCount() / LOGICFRAMES_PER_SECOND;
-			while (TheRecorder->isPlaybackInProgress())
-			{
-				TheGameClient->updateHeadless();
-
-				const int progressFrameInterval = 10*60*LOGICFRAMES_PER_SECOND;
-				if (TheGameLogic->getFrame() != 0 && TheGameLogic->getFrame() % progressFrameInterval == 0)
-				{
-					// Print progress report
-					UnsignedInt gameTimeSec = TheGameLogic->getFrame() / LOGICFRAMES_PER_SECOND;
-					UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
-					printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
-							realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
-					fflush(stdout);
-				}
-				TheGameLogic->UPDATE();
-				if (TheRecorder->sawCRCMismatch())
-				{
-					numErrors++;
-					break;
-				}
-			}
+			LogicBenchmark::begin(filename.str(), TheRecorder->getPlaybackFrameCount());
+			simulatePlayback(startTimeMillis, totalTimeSec);
+			if (TheRecorder->sawCRCMismatch() || reportCheckpointMismatch())
+				numErrors++;
+			LogicBenchmark::end(TheRecorder->sawCRCMismatch(), TRUE);
 			UnsignedInt gameTimeSec = TheGameLogic->getFrame() / LOGICFRAMES_PER_SECOND;
 			UnsignedInt realTimeSec = (GetTickCount()-startTimeMillis) / 1000;
 			printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
 					realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 			fflush(stdout);
+
+			// TheSuperHackers @performance 19/10/2026 Play the replay again from the checkpoint snapshot at or
+			// before the seek frame. Its checkpoints are compared with the straight through pass above.
+			if (TheGlobalData->m_replaySeekFrame != 0 && !TheRecorder->sawCRCMismatch() && TheRecorder->simulateReplay(filename))
+			{
+				printf("Restoring the replay at frame %u\n", TheGlobalData->m_replaySeekFrame);
+				fflush(stdout);
+				TheRecorder->seekToFrame(TheGlobalData->m_replaySeekFrame);
+				simulatePlayback(GetTickCount(), totalTimeSec);
+				if (TheRecorder->sawCRCMismatch() || reportCheckpointMismatch())
+					numErrors++;
+			}
 		}
 		else
 		{
@@ -248,7 +282,9 @@ std::vector<AsciiString> ReplaySimulation::resolveFilenameWildcards(const std::v
 int ReplaySimulation::simulateReplays(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
 	std::vector<AsciiString> filenamesResolved = resolveFilenameWildcards(filenames);
-	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL)
+	// TheSuperHackers @performance 19/10/2026 Worker processes compete for the CPU and would skew
+	// the frame times, so the logic benchmark simulates all replays in this process.
+	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL || LogicBenchmark::isEnabled())
 		return simulateReplaysInThisProcess(filenamesResolved);
 	else
 		return simulateReplaysInWorkerProcesses(filenamesResolved, maxProcesses);
@@ -81,6 +81,8 @@
 
 ArchiveFileSystem *TheArchiveFileSystem = nullptr;
 
+Int64 ArchiveFileSystem::s_bytesRead = 0;
+
 
 //----------------------------------------------------------------------------
 //         Private Prototypes
@@ -510,6 +510,7 @@ public:
 
 MemoryPoolFactory *TheMemoryPoolFactory = nullptr;
 DynamicMemoryAllocator *TheDynamicMemoryAllocator = nullptr;
+UnsignedInt TheMemoryAllocationCount = 0;
 
 // ----------------------------------------------------------------------------
 // INLINES
@@ -1677,6 +1678,7 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 	++m_usedBlocksInPool;
 	if (m_peakUsedBlocksInPool < m_usedBlocksInPool)
 		m_peakUsedBlocksInPool = m_usedBlocksInPool;
+	++TheMemoryAllocationCount;
 
 #ifdef MEMORYPOOL_DEBUG
 	m_factory->adjustTotals(debugLiteralTagString, 1*getAllocationSize(), 0);
@@ -2203,6 +2205,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 #endif
 
 		result = block->getUserData();
+		++TheMemoryAllocationCount;
 
 #ifdef MEMORYPOOL_DEBUG
 		m_factory->adjustTotals(debugLiteralTagString, numBytes, numBytes);
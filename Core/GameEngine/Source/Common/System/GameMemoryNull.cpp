@@ -30,6 +30,7 @@ static Bool theMainInitFlag = false;
 
 MemoryPoolFactory *TheMemoryPoolFactory = nullptr;
 DynamicMemoryAllocator *TheDynamicMemoryAllocator = nullptr;
+UnsignedInt TheMemoryAllocationCount = 0;
 
 //-----------------------------------------------------------------------------
 // METHODS for DynamicMemoryAllocator
@@ -47,6 +48,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes)
 	void *p = malloc(numBytes);
 	if (p == nullptr)
 		throw ERROR_OUT_OF_MEMORY;
+	++TheMemoryAllocationCount;
 	return p;
 }
 
@@ -164,6 +166,7 @@ extern void * __cdecl operator new(size_t size)
 	if (p == nullptr)
 		throw ERROR_OUT_OF_MEMORY;
 	memset(p, 0, size);
+	++TheMemoryAllocationCount;
 	return p;
 }
 
@@ -178,6 +181,7 @@ extern void * __cdecl operator new[](size_t size)
 	if (p == nullptr)
 		throw ERROR_OUT_OF_MEMORY;
 	memset(p, 0, size);
+	++TheMemoryAllocationCount;
 	return p;
 }
 
@@ -193,6 +197,7 @@ extern void* __cdecl operator new(size_t size, const char *, int)
 	if (p == nullptr)
 		throw ERROR_OUT_OF_MEMORY;
 	memset(p, 0, size);
+	++TheMemoryAllocationCount;
 	return p;
 }
 
@@ -207,6 +212,7 @@ extern void* __cdecl operator new[](size_t size, const char *, int)
 	if (p == nullptr)
 		throw ERROR_OUT_OF_MEMORY;
 	memset(p, 0, size);
+	++TheMemoryAllocationCount;
 	return p;
 }
 
@@ -51,6 +51,7 @@
 #include <io.h>
 #include <sys/stat.h>
 
+#include "Common/ArchiveFileSystem.h"
 #include "Common/AsciiString.h"
 #include "Common/FileSystem.h"
 #include "Common/RAMFile.h"
@@ -221,6 +222,7 @@ Bool RAMFile::openFromArchive(File *archiveFile, const AsciiString& filename, In
 	if (archiveFile->read(m_data, size) != size) {
 		return FALSE;
 	}
+	ArchiveFileSystem::addBytesRead(size);
 	m_nameStr = filename;
 
 	return TRUE;
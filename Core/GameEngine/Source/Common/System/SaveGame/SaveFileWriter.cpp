@@ -0,0 +1,257 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: SaveFileWriter.cpp ///////////////////////////////////////////////////////////////////////
+// Writes serialized save files to disk on a worker thread.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/SaveFileWriter.h"
+#include "Common/PerfTrace.h"
+
+#include <deque>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1300
+#define SAVE_FILE_WRITER_SYNCHRONOUS
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+/** One queued write. The worker only touches requests in the pending queue. */
+struct SaveFileWriteRequest
+{
+	FILE *file;
+	std::string tempFilePath;
+	std::string filePath;
+	std::vector<UnsignedByte> data;
+	SaveFileWriter::CompletionCallback callback;
+	void *userData;
+	Bool success;
+	UnsignedInt writeMs;
+};
+
+typedef std::deque<SaveFileWriteRequest *> SaveFileWriteQueue;
+
+static SaveFileWriteQueue s_pending;		///< queued and in progress writes, the front is being written
+static SaveFileWriteQueue s_completed;	///< written, waiting for their callbacks
+
+#ifndef SAVE_FILE_WRITER_SYNCHRONOUS
+static std::mutex s_mutex;
+static std::condition_variable s_condition;
+static std::thread s_thread;
+static Bool s_quit = FALSE;
+#endif
+
+//-------------------------------------------------------------------------------------------------
+static void writeRequest( SaveFileWriteRequest *request )
+{
+	PERF_TRACE_SCOPE(SaveFileWriter_write);
+
+	const UnsignedInt startTime = timeGetTime();
+	request->success = SaveFileWriter::writeNow( request->file, request->tempFilePath.c_str(), request->filePath.c_str(),
+		request->data.empty() ? nullptr : &request->data[ 0 ], (UnsignedInt)request->data.size() );
+	request->file = nullptr;
+	request->writeMs = timeGetTime() - startTime;
+}
+
+#ifndef SAVE_FILE_WRITER_SYNCHRONOUS
+//-------------------------------------------------------------------------------------------------
+static void writerThreadFunction( void )
+{
+	std::unique_lock<std::mutex> lock( s_mutex );
+	for (;;)
+	{
+		s_condition.wait( lock, [] { return s_quit || !s_pending.empty(); } );
+		if (s_pending.empty())
+			break;
+
+		// the request stays in the pending queue while it is written, so it counts towards the bound
+		SaveFileWriteRequest *request = s_pending.front();
+		lock.unlock();
+		writeRequest( request );
+		lock.lock();
+
+		s_pending.pop_front();
+		s_completed.push_back( request );
+		s_condition.notify_all();
+	}
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+void SaveFileWriter::write( FILE *file, const char *tempFilePath, const char *filePath,
+														std::vector<UnsignedByte> &data, CompletionCallback callback, void *userData )
+{
+	SaveFileWriteRequest *request = MSGNEW("SaveFileWriter") SaveFileWriteRequest;
+	request->file = file;
+	request->tempFilePath = tempFilePath;
+	request->filePath = filePath;
+	request->data.swap( data );
+	request->callback = callback;
+	request->userData = userData;
+	request->success = FALSE;
+	request->writeMs = 0;
+
+#ifdef SAVE_FILE_WRITER_SYNCHRONOUS
+	writeRequest( request );
+	s_completed.push_back( request );
+#else
+	std::unique_lock<std::mutex> lock( s_mutex );
+	s_condition.wait( lock, [] { return s_pending.size() < MAX_QUEUED_WRITES; } );
+
+	s_pending.push_back( request );
+	if (!s_thread.joinable())
+	{
+		s_quit = FALSE;
+		s_thread = std::thread( writerThreadFunction );
+	}
+	s_condition.notify_all();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Flushes the file data to the disk. Without it, a crash shortly after the replace could leave the
+	* target file empty, because the rename can reach the disk before the data */
+//-------------------------------------------------------------------------------------------------
+static Bool flushFile( FILE *file )
+{
+	if (fflush( file ) != 0)
+		return FALSE;
+#ifdef _WIN32
+	return _commit( _fileno( file ) ) == 0;
+#else
+	return fsync( fileno( file ) ) == 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Replaces the target file with the temporary file in a single step, so a crash leaves either the
+	* old or the new target file */
+//-------------------------------------------------------------------------------------------------
+static Bool replaceFile( const char *tempFilePath, const char *filePath )
+{
+#ifdef _WIN32
+	// rename does not replace existing files on Windows, MoveFileEx replaces them in one step
+	return MoveFileExA( tempFilePath, filePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+#else
+	return rename( tempFilePath, filePath ) == 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the data to the temporary file and then replaces the target file with it, so the target
+	* file is never left partially written. Returns FALSE and removes the temporary file on failure. */
+//-------------------------------------------------------------------------------------------------
+Bool SaveFileWriter::writeNow( FILE *file, const char *tempFilePath, const char *filePath,
+															 const UnsignedByte *data, UnsignedInt dataSize )
+{
+	Bool written = TRUE;
+	if (dataSize > 0 && fwrite( data, dataSize, 1, file ) != 1)
+		written = FALSE;
+	if (written && !flushFile( file ))
+		written = FALSE;
+	if (fclose( file ) != 0)
+		written = FALSE;
+
+	if (written && !replaceFile( tempFilePath, filePath ))
+		written = FALSE;
+
+	if (!written)
+		remove( tempFilePath );
+
+	return written;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool SaveFileWriter::isBusy( void )
+{
+#ifdef SAVE_FILE_WRITER_SYNCHRONOUS
+	return FALSE;
+#else
+	std::lock_guard<std::mutex> lock( s_mutex );
+	return !s_pending.empty();
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+void SaveFileWriter::update( void )
+{
+	SaveFileWriteQueue completed;
+	{
+#ifndef SAVE_FILE_WRITER_SYNCHRONOUS
+		std::lock_guard<std::mutex> lock( s_mutex );
+#endif
+		completed.swap( s_completed );
+	}
+
+	for (SaveFileWriteQueue::iterator it = completed.begin(); it != completed.end(); ++it)
+	{
+		SaveFileWriteRequest *request = *it;
+
+		DEBUG_LOG(( "SaveFileWriter - %s '%s', %u bytes in %u ms",
+			request->success ? "Wrote" : "Failed to write", request->filePath.c_str(),
+			(UnsignedInt)request->data.size(), request->writeMs ));
+
+		if (request->callback)
+			request->callback( request->filePath.c_str(), request->success, request->userData );
+
+		delete request;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void SaveFileWriter::flush( void )
+{
+#ifndef SAVE_FILE_WRITER_SYNCHRONOUS
+	{
+		std::unique_lock<std::mutex> lock( s_mutex );
+		s_condition.wait( lock, [] { return s_pending.empty(); } );
+	}
+#endif
+
+	update();
+}
+
+//-------------------------------------------------------------------------------------------------
+void SaveFileWriter::shutdown( void )
+{
+	flush();
+
+#ifndef SAVE_FILE_WRITER_SYNCHRONOUS
+	if (s_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock( s_mutex );
+			s_quit = TRUE;
+		}
+		s_condition.notify_all();
+		s_thread.join();
+	}
+#endif
+}
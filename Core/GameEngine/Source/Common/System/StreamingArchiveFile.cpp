@@ -51,6 +51,7 @@
 #include <io.h>
 #include <sys/stat.h>
 
+#include "Common/ArchiveFileSystem.h"
 #include "Common/AsciiString.h"
 #include "Common/FileSystem.h"
 #include "Common/StreamingArchiveFile.h"
@@ -224,6 +225,7 @@ Int StreamingArchiveFile::read( void *buffer, Int bytes )
 		bytes = m_size - m_curPos;
 
 	Int bytesRead = m_file->read(buffer, bytes);
+	ArchiveFileSystem::addBytesRead(bytesRead);
 
 	m_curPos += bytesRead;
 
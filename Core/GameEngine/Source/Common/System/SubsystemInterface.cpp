@@ -39,14 +39,16 @@ Real SubsystemInterface::s_msConsumed = 0;
 
 //-----------------------------------------------------------------------------
 SubsystemInterface::SubsystemInterface()
+:
 #ifdef DUMP_PERF_STATS
-:m_curDrawTime(0),
+m_curDrawTime(0),
 m_startDrawTimeConsumed(0),
 m_startTimeConsumed(0),
 m_curUpdateTime(0),
 m_dumpUpdate(false),
-m_dumpDraw(false)
+m_dumpDraw(false),
 #endif
+m_traceName(nullptr)
 {
 	if (TheSubsystemList) {
 		TheSubsystemList->addSubsystem(this);
@@ -70,7 +72,10 @@ void SubsystemInterface::UPDATE(void)
 	GetPrecisionTimerTicksPerSec(&freq64);
 	GetPrecisionTimer(&startTime64);
 	m_startTimeConsumed = s_msConsumed;
-	update();
+	{
+		PerfTraceScope traceScope(PerfTrace::isEnabled() ? getTraceName() : nullptr);
+		update();
+	}
 	GetPrecisionTimer(&endTime64);
 	m_curUpdateTime = ((double)(endTime64-startTime64))/((double)(freq64));
 	Real subTime = s_msConsumed - m_startTimeConsumed;
@@ -96,7 +101,10 @@ void SubsystemInterface::DRAW(void)
 	GetPrecisionTimerTicksPerSec(&freq64);
 	GetPrecisionTimer(&startTime64);
 	m_startDrawTimeConsumed = s_msConsumed;
-	draw();
+	{
+		PerfTraceScope traceScope(PerfTrace::isEnabled() ? getTraceName() : nullptr);
+		draw();
+	}
 	GetPrecisionTimer(&endTime64);
 	m_curDrawTime = ((double)(endTime64-startTime64))/((double)(freq64));
 	Real subTime = s_msConsumed - m_startDrawTimeConsumed;
@@ -117,6 +125,28 @@ void SubsystemInterface::DRAW(void)
 }
 #endif
 
+//-----------------------------------------------------------------------------
+const char *SubsystemInterface::getTraceName(void)
+{
+	if (m_traceName == nullptr)
+		m_traceName = PerfTrace::internName(m_name.isEmpty() ? "Subsystem" : m_name.str());
+	return m_traceName;
+}
+
+//-----------------------------------------------------------------------------
+void SubsystemInterface::tracedUpdate(void)
+{
+	PerfTraceScope traceScope(getTraceName());
+	update();
+}
+
+//-----------------------------------------------------------------------------
+void SubsystemInterface::tracedDraw(void)
+{
+	PerfTraceScope traceScope(getTraceName());
+	draw();
+}
+
 
 //-----------------------------------------------------------------------------
 SubsystemInterfaceList::SubsystemInterfaceList()
@@ -41,6 +41,9 @@ XferLoad::XferLoad( void )
 
 	m_xferMode = XFER_LOAD;
 	m_fileFP = nullptr;
+	m_bufferData = nullptr;
+	m_bufferSize = 0;
+	m_bufferPos = 0;
 
 }
 
@@ -50,7 +53,7 @@ XferLoad::~XferLoad( void )
 {
 
 	// warn the user if a file was left open
-	if( m_fileFP != nullptr )
+	if( m_fileFP != nullptr || m_bufferData != nullptr )
 	{
 
 		DEBUG_CRASH(( "Warning: Xfer file '%s' was left open", m_identifier.str() ));
@@ -67,7 +70,7 @@ void XferLoad::open( AsciiString identifier )
 {
 
 	// sanity, check to see if we're already open
-	if( m_fileFP != nullptr )
+	if( m_fileFP != nullptr || m_bufferData != nullptr )
 	{
 
 		DEBUG_CRASH(( "Cannot open file '%s' cause we've already got '%s' open",
@@ -91,6 +94,40 @@ void XferLoad::open( AsciiString identifier )
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Open data in memory for reading, 'identifier' just names the data in messages.  The data
+	* must stay valid until close */
+//-------------------------------------------------------------------------------------------------
+void XferLoad::openBuffer( AsciiString identifier, const UnsignedByte *data, Int dataSize )
+{
+
+	// sanity, check to see if we're already open
+	if( m_fileFP != nullptr || m_bufferData != nullptr )
+	{
+
+		DEBUG_CRASH(( "Cannot open buffer '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	if( data == nullptr )
+	{
+
+		DEBUG_CRASH(( "Buffer '%s' has no data", identifier.str() ));
+		throw XFER_INVALID_PARAMETERS;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_bufferData = data;
+	m_bufferSize = dataSize;
+	m_bufferPos = 0;
+
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Close our current file */
 //-------------------------------------------------------------------------------------------------
@@ -98,7 +135,7 @@ void XferLoad::close( void )
 {
 
 	// sanity, if we don't have an open file we can do nothing
-	if( m_fileFP == nullptr )
+	if( m_fileFP == nullptr && m_bufferData == nullptr )
 	{
 
 		DEBUG_CRASH(( "Xfer close called, but no file was open" ));
@@ -107,8 +144,12 @@ void XferLoad::close( void )
 	}
 
 	// close the file
-	fclose( m_fileFP );
+	if( m_fileFP != nullptr )
+		fclose( m_fileFP );
 	m_fileFP = nullptr;
+	m_bufferData = nullptr;
+	m_bufferSize = 0;
+	m_bufferPos = 0;
 
 	// erase the filename
 	m_identifier.clear();
@@ -122,12 +163,26 @@ Int XferLoad::beginBlock( void )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("Xfer begin block - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferData != nullptr, ("Xfer begin block - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
 	// read block size
 	XferBlockSize blockSize;
-	if( fread( &blockSize, sizeof( XferBlockSize ), 1, m_fileFP ) != 1 )
+	if( m_bufferData != nullptr )
+	{
+
+		if( m_bufferPos + (Int)sizeof( XferBlockSize ) > m_bufferSize )
+		{
+
+			DEBUG_CRASH(( "Xfer - Error reading block size for '%s'", m_identifier.str() ));
+			return 0;
+
+		}
+		memcpy( &blockSize, m_bufferData + m_bufferPos, sizeof( XferBlockSize ) );
+		m_bufferPos += sizeof( XferBlockSize );
+
+	}
+	else if( fread( &blockSize, sizeof( XferBlockSize ), 1, m_fileFP ) != 1 )
 	{
 
 		DEBUG_CRASH(( "Xfer - Error reading block size for '%s'", m_identifier.str() ));
@@ -155,7 +210,7 @@ void XferLoad::skip( Int dataSize )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("XferLoad::skip - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferData != nullptr, ("XferLoad::skip - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
 	// sanity
@@ -163,7 +218,15 @@ void XferLoad::skip( Int dataSize )
 										 dataSize) );
 
 	// skip datasize in the file from the current position
-	if( fseek( m_fileFP, dataSize, SEEK_CUR ) != 0 )
+	if( m_bufferData != nullptr )
+	{
+
+		if( dataSize < 0 || m_bufferPos + dataSize > m_bufferSize )
+			throw XFER_SKIP_ERROR;
+		m_bufferPos += dataSize;
+
+	}
+	else if( fseek( m_fileFP, dataSize, SEEK_CUR ) != 0 )
 		throw XFER_SKIP_ERROR;
 
 }
@@ -244,9 +307,26 @@ void XferLoad::xferImplementation( void *data, Int dataSize )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("XferLoad - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferData != nullptr, ("XferLoad - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
+	// read data from memory
+	if( m_bufferData != nullptr )
+	{
+
+		if( dataSize < 0 || m_bufferPos + dataSize > m_bufferSize )
+		{
+
+			DEBUG_CRASH(( "XferLoad - Error reading from buffer '%s'", m_identifier.str() ));
+			throw XFER_READ_ERROR;
+
+		}
+		memcpy( data, m_bufferData + m_bufferPos, dataSize );
+		m_bufferPos += dataSize;
+		return;
+
+	}
+
 	// read data from file
 	if( fread( data, dataSize, 1, m_fileFP ) != 1 )
 	{
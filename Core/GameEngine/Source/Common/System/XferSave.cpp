@@ -32,6 +32,7 @@
 #include "Common/XferSave.h"
 #include "Common/Snapshot.h"
 #include "Common/GameMemory.h"
+#include "Common/SaveFileWriter.h"
 
 // PRIVATE TYPES //////////////////////////////////////////////////////////////////////////////////
 class XferBlockData : public MemoryPoolObject
@@ -46,6 +47,9 @@ public:
 };
 EMPTY_DTOR(XferBlockData)
 
+// PRIVATE DATA ///////////////////////////////////////////////////////////////////////////////////
+static const Int INITIAL_BUFFER_SIZE = 1024 * 1024;		///< save games are a few megabytes
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // PUBLIC METHDOS /////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +61,8 @@ XferSave::XferSave( void )
 
 	m_xferMode = XFER_SAVE;
 	m_fileFP = nullptr;
+	m_bufferOnly = FALSE;
+	m_bufferPos = 0;
 	m_blockStack = nullptr;
 
 }
@@ -67,11 +73,11 @@ XferSave::~XferSave( void )
 {
 
 	// warn the user if a file was left open
-	if( m_fileFP != nullptr )
+	if( m_fileFP != nullptr || m_bufferOnly )
 	{
 
 		DEBUG_CRASH(( "Warning: Xfer file '%s' was left open", m_identifier.str() ));
-		close();
+		discard();
 
 	}
 
@@ -86,15 +92,7 @@ XferSave::~XferSave( void )
 		DEBUG_CRASH(( "Warning: XferSave::~XferSave - m_blockStack was not null!" ));
 
 		// delete the block stack
-		XferBlockData *next;
-		while( m_blockStack )
-		{
-
-			next = m_blockStack->next;
-			deleteInstance(m_blockStack);
-			m_blockStack = next;
-
-		}
+		deleteBlockStack();
 
 	}
 
@@ -107,7 +105,7 @@ void XferSave::open( AsciiString identifier )
 {
 
 	// sanity, check to see if we're already open
-	if( m_fileFP != nullptr )
+	if( m_fileFP != nullptr || m_bufferOnly )
 	{
 
 		DEBUG_CRASH(( "Cannot open file '%s' cause we've already got '%s' open",
@@ -119,20 +117,29 @@ void XferSave::open( AsciiString identifier )
 	// call base class
 	Xfer::open( identifier );
 
-	// open the file
-	m_fileFP = fopen( identifier.str(), "w+b" );
+	// open the temporary file now, so that failing to create files is still reported by open
+	m_tempFilePath = identifier;
+	m_tempFilePath.concat( ".tmp" );
+	m_fileFP = fopen( m_tempFilePath.str(), "wb" );
 	if( m_fileFP == nullptr )
 	{
 
-		DEBUG_CRASH(( "File '%s' not found", identifier.str() ));
+		DEBUG_CRASH(( "File '%s' not found", m_tempFilePath.str() ));
+		m_tempFilePath.clear();
+		m_identifier.clear();
 		throw XFER_FILE_NOT_FOUND;
 
 	}
 
+	m_buffer.clear();
+	m_buffer.reserve( INITIAL_BUFFER_SIZE );
+	m_bufferPos = 0;
+
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Close our current file */
+/** Write the buffered data to the temporary file with one write, then replace the target file
+	* with it.  If anything fails the target file is left untouched */
 //-------------------------------------------------------------------------------------------------
 void XferSave::close( void )
 {
@@ -146,9 +153,120 @@ void XferSave::close( void )
 
 	}
 
-	// close the file
-	fclose( m_fileFP );
+	// write and close the temporary file and replace the target file
+	Bool written = SaveFileWriter::writeNow( m_fileFP, m_tempFilePath.str(), m_identifier.str(),
+		m_buffer.empty() ? nullptr : &m_buffer[ 0 ], (UnsignedInt)m_buffer.size() );
+	m_fileFP = nullptr;
+
+	AsciiString identifier = m_identifier;
+	discard();
+
+	if( written == FALSE )
+	{
+
+		DEBUG_CRASH(( "XferSave - Error writing to file '%s'", identifier.str() ));
+		throw XFER_WRITE_ERROR;
+
+	}
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Like close, but the data is written on the save file writer thread.  The callback reports the
+	* result on the game thread */
+//-------------------------------------------------------------------------------------------------
+void XferSave::closeAsync( SaveFileWriter::CompletionCallback callback, void *userData )
+{
+
+	// sanity, if we don't have an open file we can do nothing
+	if( m_fileFP == nullptr )
+	{
+
+		DEBUG_CRASH(( "Xfer close called, but no file was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	// the writer takes the file and the buffer
+	SaveFileWriter::write( m_fileFP, m_tempFilePath.str(), m_identifier.str(), m_buffer, callback, userData );
 	m_fileFP = nullptr;
+	m_tempFilePath.clear();
+
+	discard();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Open for writing into memory only, 'identifier' just names the data in messages.  Take the
+	* data with closeBuffer */
+//-------------------------------------------------------------------------------------------------
+void XferSave::openBuffer( AsciiString identifier )
+{
+
+	// sanity, check to see if we're already open
+	if( m_fileFP != nullptr || m_bufferOnly )
+	{
+
+		DEBUG_CRASH(( "Cannot open buffer '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_bufferOnly = TRUE;
+	m_buffer.clear();
+	m_buffer.reserve( INITIAL_BUFFER_SIZE );
+	m_bufferPos = 0;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Close a buffer opened with openBuffer and hand its data over to 'data' */
+//-------------------------------------------------------------------------------------------------
+void XferSave::closeBuffer( std::vector<UnsignedByte> &data )
+{
+
+	// sanity, if we don't have an open buffer we can do nothing
+	if( m_bufferOnly == FALSE )
+	{
+
+		DEBUG_CRASH(( "Xfer close buffer called, but no buffer was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	data.swap( m_buffer );
+	discard();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Close our current file without writing it, the target file is left untouched.  Does nothing
+	* if no file is open */
+//-------------------------------------------------------------------------------------------------
+void XferSave::discard( void )
+{
+
+	if( m_fileFP != nullptr )
+	{
+
+		fclose( m_fileFP );
+		m_fileFP = nullptr;
+
+	}
+
+	// remove the temporary file, this fails harmlessly after a successful rename
+	if( m_tempFilePath.isNotEmpty() )
+		remove( m_tempFilePath.str() );
+	m_tempFilePath.clear();
+
+	// free the buffer, saves are rare
+	std::vector<UnsignedByte>().swap( m_buffer );
+	m_bufferPos = 0;
+	m_bufferOnly = FALSE;
 
 	// erase the filename
 	m_identifier.clear();
@@ -156,32 +274,41 @@ void XferSave::close( void )
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Write a placeholder at the current location in the file and store this location
-	* internally.  The next endBlock that is called will back up to the most recently stored
-	* beginBlock and write the difference in file bytes from the endBlock call to the
-	* location of this beginBlock.  The current file position will then return to the location
-	* at which endBlock was called */
+//-------------------------------------------------------------------------------------------------
+void XferSave::deleteBlockStack( void )
+{
+
+	XferBlockData *next;
+	while( m_blockStack )
+	{
+
+		next = m_blockStack->next;
+		deleteInstance(m_blockStack);
+		m_blockStack = next;
+
+	}
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write a placeholder at the current location in the buffer and store this location
+	* internally.  The next endBlock that is called will patch the most recently stored
+	* beginBlock placeholder with the difference in bytes from the endBlock call to the
+	* location of this beginBlock */
 //-------------------------------------------------------------------------------------------------
 Int XferSave::beginBlock( void )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("Xfer begin block - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferOnly, ("Xfer begin block - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
-	// get the current file position so we can back up here for the next end block call
-	XferFilePos filePos = ftell( m_fileFP );
+	// get the current position so we can back up here for the next end block call
+	XferFilePos filePos = m_bufferPos;
 
 	// write a placeholder
 	XferBlockSize blockSize = 0;
-	if( fwrite( &blockSize, sizeof( XferBlockSize ), 1, m_fileFP ) != 1 )
-	{
-
-		DEBUG_CRASH(( "XferSave::beginBlock - Error writing block size in '%s'",
-									m_identifier.str() ));
-		return XFER_WRITE_ERROR;
-
-	}
+	xferImplementation( &blockSize, sizeof( XferBlockSize ) );
 
 	// save this block position on the top of the "stack"
 	XferBlockData *top = newInstance(XferBlockData);
@@ -203,15 +330,14 @@ Int XferSave::beginBlock( void )
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Do the tail end as described in beginBlock above.  Back up to the last begin block,
-	* write the file difference from current position to the last begin position, and put
-	* current file position back to where it was */
+/** Do the tail end as described in beginBlock above.  Write the difference from the current
+	* position to the last begin position into the placeholder of the last begin block */
 //-------------------------------------------------------------------------------------------------
 void XferSave::endBlock( void )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("Xfer end block - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferOnly, ("Xfer end block - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
 	// sanity, make sure we have a block started
@@ -223,28 +349,13 @@ void XferSave::endBlock( void )
 
 	}
 
-	// save our current file position
-	XferFilePos currentFilePos = ftell( m_fileFP );
-
 	// pop the block descriptor off the top of the block stack
 	XferBlockData *top = m_blockStack;
 	m_blockStack = m_blockStack->next;
 
-	// rewind the file to the block position
-	fseek( m_fileFP, top->filePos, SEEK_SET );
-
-	// write the size in bytes between the block position and what is our current file position
-	XferBlockSize blockSize = currentFilePos - top->filePos - sizeof( XferBlockSize );
-	if( fwrite( &blockSize, sizeof( XferBlockSize ), 1, m_fileFP ) != 1 )
-	{
-
-		DEBUG_CRASH(( "Error writing block size to file '%s'", m_identifier.str() ));
-		throw XFER_WRITE_ERROR;
-
-	}
-
-	// place the file pointer back to the current position
-	fseek( m_fileFP, currentFilePos, SEEK_SET );
+	// patch the size in bytes between the block position and our current position into the placeholder
+	XferBlockSize blockSize = m_bufferPos - top->filePos - sizeof( XferBlockSize );
+	memcpy( &m_buffer[ top->filePos ], &blockSize, sizeof( XferBlockSize ) );
 
 	// delete the block data as it's all used up now
 	deleteInstance(top);
@@ -258,12 +369,13 @@ void XferSave::skip( Int dataSize )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("XferSave - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferOnly, ("XferSave - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
 
-	// skip forward dataSize bytes
-	fseek( m_fileFP, dataSize, SEEK_CUR );
+	// skip forward dataSize bytes, like seeking in a file this only grows the data once something
+	// is written after the skipped bytes
+	m_bufferPos += dataSize;
 
 }
 
@@ -343,16 +455,25 @@ void XferSave::xferImplementation( void *data, Int dataSize )
 {
 
 	// sanity
-	DEBUG_ASSERTCRASH( m_fileFP != nullptr, ("XferSave - file pointer for '%s' is null",
+	DEBUG_ASSERTCRASH( m_fileFP != nullptr || m_bufferOnly, ("XferSave - file pointer for '%s' is null",
 										 m_identifier.str()) );
 
-	// write data to file
-	if( fwrite( data, dataSize, 1, m_fileFP ) != 1 )
+	// append data to the buffer, or overwrite at the current position after a skip
+	const UnsignedByte *bytes = static_cast<const UnsignedByte *>( data );
+	if( m_bufferPos == (XferFilePos)m_buffer.size() )
 	{
 
-		DEBUG_CRASH(( "XferSave - Error writing to file '%s'", m_identifier.str() ));
-		throw XFER_WRITE_ERROR;
+		m_buffer.insert( m_buffer.end(), bytes, bytes + dataSize );
+
+	}
+	else
+	{
+
+		if( m_bufferPos + dataSize > (XferFilePos)m_buffer.size() )
+			m_buffer.resize( m_bufferPos + dataSize, 0 );
+		memcpy( &m_buffer[ m_bufferPos ], bytes, dataSize );
 
 	}
+	m_bufferPos += dataSize;
 
 }
@@ -28,13 +28,15 @@
 #include "GameNetwork/NetCommandList.h"
 #include "GameNetwork/networkutil.h"
 
+static const size_t INITIAL_INDEX_BUCKET_COUNT = 16;
+
 /**
  * Constructor.
  */
 NetCommandList::NetCommandList() {
 	m_first = nullptr;
 	m_last = nullptr;
-	m_lastMessageInserted = nullptr;
+	m_indexedCount = 0;
 }
 
 /**
@@ -77,8 +79,21 @@ NetCommandRef *NetCommandList::getFirstMessage() {
  * Remove the given message from this list.
  */
 void NetCommandList::removeMessage(NetCommandRef *msg) {
-	if (m_lastMessageInserted == msg) {
-		m_lastMessageInserted = msg->getNext();
+	const UnsignedInt key = getGroupKey(msg->getCommand());
+	const size_t groupIndex = findGroupIndex(key);
+	if (groupIndex < m_groups.size() && m_groups[groupIndex].key == key) {
+		CommandGroup &group = m_groups[groupIndex];
+		if (group.first == msg && group.last == msg) {
+			m_groups.erase(m_groups.begin() + groupIndex);
+		} else if (group.first == msg) {
+			group.first = msg->getNext();
+		} else if (group.last == msg) {
+			group.last = msg->getPrev();
+		}
+	}
+
+	if (isIndexedCommandMsg(msg->getCommand())) {
+		removeFromIndex(msg);
 	}
 
 	if (msg->getPrev() != nullptr) {
@@ -115,16 +130,22 @@ void NetCommandList::reset() {
 		temp = m_first->getNext();
 		m_first->setNext(nullptr);
 		m_first->setPrev(nullptr);
+		m_first->setIndexNext(nullptr);
 		deleteInstance(m_first);
 		m_first = temp;
 	}
 	m_last = nullptr;
-	m_lastMessageInserted = nullptr;
+
+	// Keep the bucket storage around, lists are reused from frame to frame.
+	m_groups.clear();
+	std::fill(m_buckets.begin(), m_buckets.end(), (NetCommandRef *)nullptr);
+	m_indexedCount = 0;
 }
 
 /**
  * Insert sorts msg.  Assumes that all the previous message inserts were done using this function.
  * The message is sorted in based first on command type, then player id, and then command id.
+ * A message goes in front of the first message that does not sort before it.
  */
 NetCommandRef * NetCommandList::addMessage(NetCommandMsg *cmdMsg) {
 	if (cmdMsg == nullptr) {
@@ -132,207 +153,222 @@ NetCommandRef * NetCommandList::addMessage(NetCommandMsg *cmdMsg) {
 		return nullptr;
 	}
 
-//	UnsignedInt id = cmdMsg->getID();
+	const Bool indexed = isIndexedCommandMsg(cmdMsg);
+	if (indexed && findIndexedMessage(cmdMsg) != nullptr) {
+		// This command is already in the list, don't duplicate it.
+		return nullptr;
+	}
 
 	NetCommandRef *msg = NEW_NETCOMMANDREF(cmdMsg);
 
-	if (m_first == nullptr) {
-		// this is the first node, so we don't have to worry about ordering it.
-		m_first = msg;
-		m_last = msg;
-		m_lastMessageInserted = msg;
-		return msg;
-	}
-
-	if (m_lastMessageInserted != nullptr) {
-		// Messages that are inserted in order should just be put in one right after the other.
-		// So saving the placement of the last message inserted can give us a huge boost in
-		// efficiency.
-		NetCommandRef *theNext = m_lastMessageInserted->getNext();
-		if ((m_lastMessageInserted->getCommand()->getNetCommandType() == msg->getCommand()->getNetCommandType()) &&
-			(m_lastMessageInserted->getCommand()->getPlayerID() == msg->getCommand()->getPlayerID()) &&
-			(m_lastMessageInserted->getCommand()->getID() < msg->getCommand()->getID()) &&
-			((theNext == nullptr) || ((theNext->getCommand()->getNetCommandType() > msg->getCommand()->getNetCommandType()) ||
-			 (theNext->getCommand()->getPlayerID() > msg->getCommand()->getPlayerID()) ||
-			 (theNext->getCommand()->getID() > msg->getCommand()->getID())))) {
-
-			// Make sure this command isn't already in the list.
-			if (isEqualCommandMsg(m_lastMessageInserted->getCommand(), msg->getCommand())) {
-
-				// This command is already in the list, don't duplicate it.
-				deleteInstance(msg);
-				msg = nullptr;
-				return nullptr;
+	const UnsignedInt key = getGroupKey(cmdMsg);
+	const size_t groupIndex = findGroupIndex(key);
+
+	if (groupIndex < m_groups.size() && m_groups[groupIndex].key == key) {
+		// Find the position within the player's section based on the command ID.
+		// If the command type doesn't require a command ID, sort by whatever it should be sorted by.
+		// Messages are mostly added in order, so search backwards from the end of the section.
+		CommandGroup &group = m_groups[groupIndex];
+		const Int sortNumber = cmdMsg->getSortNumber();
+		NetCommandRef *after = group.last;
+		while (after->getCommand()->getSortNumber() >= sortNumber) {
+			if (after == group.first) {
+				after = nullptr;
+				break;
 			}
+			after = after->getPrev();
+		}
 
-			if (theNext == nullptr) {
-				// this means that m_lastMessageInserted == m_last, so m_last should point to the msg that is being inserted.
-				msg->setNext(m_lastMessageInserted->getNext());
-				msg->setPrev(m_lastMessageInserted);
-				m_lastMessageInserted->setNext(msg);
-				m_lastMessageInserted = msg;
-				m_last = msg;
-			} else {
-				msg->setNext(m_lastMessageInserted->getNext());
-				msg->setPrev(m_lastMessageInserted);
-				m_lastMessageInserted->setNext(msg);
-				msg->getNext()->setPrev(msg);
-				m_lastMessageInserted = msg;
+		if (after == nullptr) {
+			insertBefore(msg, group.first);
+			group.first = msg;
+		} else {
+			insertAfter(msg, after);
+			if (after == group.last) {
+				group.last = msg;
 			}
-			return msg;
 		}
-	}
-
-	if (msg->getCommand()->getNetCommandType() > m_last->getCommand()->getNetCommandType()) {
-		// easy optimization for a command that goes at the end of the list
-		// since they are likely to be added in order.
-
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_last->getCommand(), msg->getCommand())) {
-
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			msg = nullptr;
-			return nullptr;
+	} else {
+		// This is the first message of its type and player, it goes in front of the next section.
+		if (groupIndex < m_groups.size()) {
+			insertBefore(msg, m_groups[groupIndex].first);
+		} else {
+			insertAfter(msg, m_last);
 		}
 
-		msg->setPrev(m_last);
-		msg->setNext(nullptr);
-		m_last->setNext(msg);
-		m_last = msg;
-		m_lastMessageInserted = msg;
-		return msg;
+		CommandGroup group;
+		group.key = key;
+		group.first = msg;
+		group.last = msg;
+		m_groups.insert(m_groups.begin() + groupIndex, group);
 	}
 
-	if (msg->getCommand()->getNetCommandType() < m_first->getCommand()->getNetCommandType()) {
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_first->getCommand(), msg->getCommand())) {
+	if (indexed) {
+		addToIndex(msg);
+	}
 
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			msg = nullptr;
-			return nullptr;
-		}
+	return msg;
+}
 
-		// The command goes at the head of the list.
-		msg->setNext(m_first);
-		msg->setPrev(nullptr);
-		m_first->setPrev(msg);
-		m_first = msg;
-		m_lastMessageInserted = msg;
-		return msg;
+/**
+ * Link ref into the list in front of the given node.
+ */
+void NetCommandList::insertBefore(NetCommandRef *ref, NetCommandRef *before) {
+	ref->setNext(before);
+	ref->setPrev(before->getPrev());
+	if (before->getPrev() != nullptr) {
+		before->getPrev()->setNext(ref);
+	} else {
+		m_first = ref;
 	}
+	before->setPrev(ref);
+}
 
+/**
+ * Link ref into the list behind the given node. If the given node is null, the list must be empty.
+ */
+void NetCommandList::insertAfter(NetCommandRef *ref, NetCommandRef *after) {
+	if (after == nullptr) {
+		ref->setNext(nullptr);
+		ref->setPrev(nullptr);
+		m_first = ref;
+		m_last = ref;
+		return;
+	}
 
-	// Find the start of the command type we're looking for.
-	NetCommandRef *tempmsg = m_first;
-	while ((tempmsg != nullptr) && (msg->getCommand()->getNetCommandType() > tempmsg->getCommand()->getNetCommandType())) {
-		tempmsg = tempmsg->getNext();
+	ref->setNext(after->getNext());
+	ref->setPrev(after);
+	if (after->getNext() != nullptr) {
+		after->getNext()->setPrev(ref);
+	} else {
+		m_last = ref;
 	}
+	after->setNext(ref);
+}
 
-	if (tempmsg == nullptr) {
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_last->getCommand(), msg->getCommand())) {
+/**
+ * The group key orders by command type first and by player id second.
+ */
+UnsignedInt NetCommandList::getGroupKey(NetCommandMsg *msg) {
+	return ((UnsignedInt)(msg->getNetCommandType() + 1) << 8) | msg->getPlayerID();
+}
 
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			msg = nullptr;
-			return nullptr;
+size_t NetCommandList::findGroupIndex(UnsignedInt key) const {
+	size_t lo = 0;
+	size_t hi = m_groups.size();
+	while (lo < hi) {
+		const size_t mid = (lo + hi) / 2;
+		if (m_groups[mid].key < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
-
-		// message goes at the end of the list.
-		msg->setPrev(m_last);
-		msg->setNext(nullptr);
-		m_last->setNext(msg);
-		m_last = msg;
-		m_lastMessageInserted = msg;
-		return msg;
 	}
+	return lo;
+}
 
-	// Now find the player position.  munkee.
-	while ((tempmsg != nullptr) && (msg->getCommand()->getNetCommandType() == tempmsg->getCommand()->getNetCommandType()) && (msg->getCommand()->getPlayerID() > tempmsg->getCommand()->getPlayerID())) {
-		tempmsg = tempmsg->getNext();
-	}
+/**
+ * Only messages of these types can compare equal with isEqualCommandMsg.
+ */
+Bool NetCommandList::isIndexedCommandMsg(NetCommandMsg *msg) {
+	const NetCommandType type = msg->getNetCommandType();
+	return DoesCommandRequireACommandID(type)
+		|| type == NETCOMMANDTYPE_ACKSTAGE1
+		|| type == NETCOMMANDTYPE_ACKSTAGE2
+		|| type == NETCOMMANDTYPE_ACKBOTH;
+}
 
-	if (tempmsg == nullptr) {
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_last->getCommand(), msg->getCommand())) {
+/**
+ * Messages that are equal according to isEqualCommandMsg produce the same hash.
+ */
+UnsignedInt NetCommandList::getIndexHash(NetCommandMsg *msg) {
+	const NetCommandType type = msg->getNetCommandType();
+	UnsignedInt hash;
+
+	if (DoesCommandRequireACommandID(type)) {
+		// The command type does not take part in the comparison of these messages.
+		hash = ((UnsignedInt)msg->getPlayerID() << 16) | msg->getID();
+	} else if (type == NETCOMMANDTYPE_ACKSTAGE1) {
+		NetAckStage1CommandMsg *ack = (NetAckStage1CommandMsg *)msg;
+		hash = ((UnsignedInt)type << 24) ^ ((UnsignedInt)ack->getPlayerID() << 20) ^ ((UnsignedInt)ack->getOriginalPlayerID() << 16) ^ ack->getCommandID();
+	} else if (type == NETCOMMANDTYPE_ACKSTAGE2) {
+		NetAckStage2CommandMsg *ack = (NetAckStage2CommandMsg *)msg;
+		hash = ((UnsignedInt)type << 24) ^ ((UnsignedInt)ack->getPlayerID() << 20) ^ ((UnsignedInt)ack->getOriginalPlayerID() << 16) ^ ack->getCommandID();
+	} else {
+		NetAckBothCommandMsg *ack = (NetAckBothCommandMsg *)msg;
+		hash = ((UnsignedInt)type << 24) ^ ((UnsignedInt)ack->getPlayerID() << 20) ^ ((UnsignedInt)ack->getOriginalPlayerID() << 16) ^ ack->getCommandID();
+	}
 
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			msg = nullptr;
-			return nullptr;
-		}
+	hash *= 2654435761u;
+	return hash ^ (hash >> 16);
+}
 
-		// message goes at the end of the list.
-		msg->setPrev(m_last);
-		msg->setNext(nullptr);
-		m_last->setNext(msg);
-		m_last = msg;
-		m_lastMessageInserted = msg;
-		return msg;
+NetCommandRef * NetCommandList::findIndexedMessage(NetCommandMsg *msg) {
+	if (m_indexedCount == 0) {
+		return nullptr;
 	}
 
-	// Find the position within the player's section based on the command ID.
-	// If the command type doesn't require a command ID, sort by whatever it should be sorted by.
-	while ((tempmsg != nullptr) && (msg->getCommand()->getNetCommandType() == tempmsg->getCommand()->getNetCommandType()) && (msg->getCommand()->getPlayerID() == tempmsg->getCommand()->getPlayerID()) && (msg->getCommand()->getSortNumber() > tempmsg->getCommand()->getSortNumber())) {
-		tempmsg = tempmsg->getNext();
+	NetCommandRef *ref = m_buckets[getIndexHash(msg) & (m_buckets.size() - 1)];
+	while ((ref != nullptr) && (isEqualCommandMsg(ref->getCommand(), msg) == FALSE)) {
+		ref = ref->getIndexNext();
 	}
+	return ref;
+}
 
-	if (tempmsg == nullptr) {
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_last->getCommand(), msg->getCommand())) {
+void NetCommandList::addToIndex(NetCommandRef *ref) {
+	if (m_indexedCount >= m_buckets.size()) {
+		growIndex();
+	}
 
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			msg = nullptr;
-			return nullptr;
-		}
+	NetCommandRef *&bucket = m_buckets[getIndexHash(ref->getCommand()) & (m_buckets.size() - 1)];
+	ref->setIndexNext(bucket);
+	bucket = ref;
+	++m_indexedCount;
+}
 
-		// This message goes at the end of the list.
-		msg->setPrev(m_last);
-		msg->setNext(nullptr);
-		m_last->setNext(msg);
-		m_last = msg;
-		m_lastMessageInserted = msg;
-		return msg;
+void NetCommandList::removeFromIndex(NetCommandRef *ref) {
+	if (m_indexedCount == 0) {
+		return;
 	}
 
-	if (tempmsg == m_first) {
-		// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(m_first->getCommand(), msg->getCommand())) {
-
-			// This command is already in the list, don't duplicate it.
-			deleteInstance(msg);
-			return nullptr;
+	NetCommandRef *&bucket = m_buckets[getIndexHash(ref->getCommand()) & (m_buckets.size() - 1)];
+	NetCommandRef *prev = nullptr;
+	NetCommandRef *temp = bucket;
+	while (temp != nullptr) {
+		if (temp == ref) {
+			if (prev != nullptr) {
+				prev->setIndexNext(ref->getIndexNext());
+			} else {
+				bucket = ref->getIndexNext();
+			}
+			ref->setIndexNext(nullptr);
+			--m_indexedCount;
+			return;
 		}
-
-		// This message goes at the head of the list.
-		msg->setNext(m_first);
-		msg->setPrev(nullptr);
-		m_first->setPrev(msg);
-		m_first = msg;
-		m_lastMessageInserted = msg;
-		return msg;
+		prev = temp;
+		temp = temp->getIndexNext();
 	}
+}
 
-	// Make sure this command isn't already in the list.
-		if (isEqualCommandMsg(tempmsg->getCommand(), msg->getCommand())) {
-
-		// This command is already in the list, don't duplicate it.
-		deleteInstance(msg);
-		msg = nullptr;
-		return nullptr;
+/**
+ * Doubles the bucket count and redistributes the indexed messages.
+ */
+void NetCommandList::growIndex() {
+	const size_t newCount = m_buckets.empty() ? INITIAL_INDEX_BUCKET_COUNT : m_buckets.size() * 2;
+	CommandBucketVec buckets(newCount, (NetCommandRef *)nullptr);
+
+	for (size_t i = 0; i < m_buckets.size(); ++i) {
+		NetCommandRef *ref = m_buckets[i];
+		while (ref != nullptr) {
+			NetCommandRef *next = ref->getIndexNext();
+			NetCommandRef *&bucket = buckets[getIndexHash(ref->getCommand()) & (newCount - 1)];
+			ref->setIndexNext(bucket);
+			bucket = ref;
+			ref = next;
+		}
 	}
 
-	// Insert message before tempmsg.
-	msg->setNext(tempmsg);
-	msg->setPrev(tempmsg->getPrev());
-	msg->getPrev()->setNext(msg);
-	tempmsg->setPrev(msg);
-	m_lastMessageInserted = msg;
-
-	return msg;
+	m_buckets.swap(buckets);
 }
 
 Int NetCommandList::length() {
@@ -346,26 +382,32 @@ Int NetCommandList::length() {
 }
 
 /**
- * This is really inefficient, but we can probably get away with it because
- * there shouldn't be too many messages for any given frame.
+ * Only messages that can compare equal are kept in the hash index, so this is a hash lookup.
  */
 NetCommandRef * NetCommandList::findMessage(NetCommandMsg *msg) {
-	NetCommandRef *retval = m_first;
-	while ((retval != nullptr) && (isEqualCommandMsg(retval->getCommand(), msg) == FALSE)) {
-		retval = retval->getNext();
+	if (!isIndexedCommandMsg(msg)) {
+		return nullptr;
 	}
-	return retval;
+	return findIndexedMessage(msg);
 }
 
 NetCommandRef * NetCommandList::findMessage(UnsignedShort commandID, UnsignedByte playerID) {
-	NetCommandRef *retval = m_first;
+	if (m_indexedCount == 0) {
+		return nullptr;
+	}
+
+	// Same hash as getIndexHash for commands that require a command id.
+	UnsignedInt hash = (((UnsignedInt)playerID << 16) | commandID) * 2654435761u;
+	hash ^= hash >> 16;
+
+	NetCommandRef *retval = m_buckets[hash & (m_buckets.size() - 1)];
 	while (retval != nullptr) {
 		if (DoesCommandRequireACommandID(retval->getCommand()->getNetCommandType())) {
 			if ((retval->getCommand()->getID() == commandID) && (retval->getCommand()->getPlayerID() == playerID)) {
 				return retval;
 			}
 		}
-		retval = retval->getNext();
+		retval = retval->getIndexNext();
 	}
 	return retval;
 }
@@ -43,6 +43,7 @@ NetCommandRef::NetCommandRef(NetCommandMsg *msg)
 	m_msg = msg;
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_indexNext = nullptr;
 	m_msg->attach();
 	m_timeLastSent = -1;
 
@@ -0,0 +1,210 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: StdAudioMixer.h //////////////////////////////////////////////////////////////////////////
+// Platform independent software mixer of 16 bit PCM voices into a stereo output.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <vector>
+
+// TheSuperHackers @performance 19/10/2026 The mixer is split between the game thread and the audio
+// thread. The game thread posts commands into a single producer single consumer queue and the
+// audio thread posts the handles of finished voices back through another one, so neither thread
+// ever waits for the other. The audio thread does not allocate or free memory. The PCM data of a
+// voice must stay alive until the game thread receives the voice handle from popFinishedVoice().
+
+//-------------------------------------------------------------------------------------------------
+/** Lock free queue with one writing and one reading thread. Size must be a power of two. */
+//-------------------------------------------------------------------------------------------------
+template <typename T, UnsignedInt Size>
+class StdAudioQueue
+{
+public:
+	StdAudioQueue() : m_head(0), m_tail(0) {}
+
+	Bool push( const T &item )
+	{
+		const UnsignedInt tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == Size)
+			return false;
+
+		m_items[tail & (Size - 1)] = item;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	Bool pop( T &item )
+	{
+		const UnsignedInt head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+
+		item = m_items[head & (Size - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	T m_items[Size];
+	std::atomic<UnsignedInt> m_head;	///< written by the reader only
+	std::atomic<UnsignedInt> m_tail;	///< written by the writer only
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Receives the mixed output when the mixer is not driven by an audio device callback */
+//-------------------------------------------------------------------------------------------------
+class StdAudioSink
+{
+public:
+	virtual ~StdAudioSink() {}
+	virtual void write( const Short *samples, Int numFrames, Int numChannels ) = 0;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Discards the output, for headless runs and benchmarks of the mixer */
+//-------------------------------------------------------------------------------------------------
+class StdNullAudioSink : public StdAudioSink
+{
+public:
+	virtual void write( const Short *samples, Int numFrames, Int numChannels ) {}
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Writes the output into a 16 bit PCM WAV file */
+//-------------------------------------------------------------------------------------------------
+class StdWavFileAudioSink : public StdAudioSink
+{
+public:
+	StdWavFileAudioSink();
+	virtual ~StdWavFileAudioSink();
+
+	Bool open( const char *fileName, Int sampleRate, Int numChannels );
+	void close( void );
+
+	virtual void write( const Short *samples, Int numFrames, Int numChannels );
+
+private:
+	void writeHeader( void );
+
+	FILE *m_file;
+	Int m_sampleRate;
+	Int m_numChannels;
+	UnsignedInt m_dataBytes;
+};
+
+//-------------------------------------------------------------------------------------------------
+class StdAudioMixer
+{
+public:
+
+	enum
+	{
+		MAX_VOICES = 128,
+		MIX_BLOCK_FRAMES = 256,					///< frames mixed per pass over the voices
+		COMMAND_QUEUE_SIZE = 1024,			///< must be a power of two
+		FINISHED_QUEUE_SIZE = 256,			///< must be a power of two, at least MAX_VOICES
+	};
+
+	typedef UnsignedInt VoiceHandle;
+
+	struct VoiceParams
+	{
+		const Short *pcm;				///< interleaved samples, must stay alive until the voice is finished
+		UnsignedInt numFrames;
+		Int numChannels;				///< channels beyond the first two are skipped
+		Int sampleRate;
+		Real gainLeft;
+		Real gainRight;
+		Bool looping;
+	};
+
+	StdAudioMixer( Int outputSampleRate );
+
+	Int getOutputSampleRate( void ) const { return m_outputSampleRate; }
+
+	// Game thread. The caller must keep no more than MAX_VOICES voices unfinished.
+	void playVoice( VoiceHandle handle, const VoiceParams &params );
+	void stopVoice( VoiceHandle handle );
+	void pauseVoice( VoiceHandle handle, Bool paused );
+	void setVoiceGain( VoiceHandle handle, Real gainLeft, Real gainRight );
+	void stopAllVoices( void );
+	void pauseAllVoices( Bool paused );
+	Bool popFinishedVoice( VoiceHandle &handle );
+	void flushCommands( void );			///< retries the commands that did not fit into the queue
+
+	// Audio thread
+	void mix( Short *output, Int numFrames, Int numChannels );
+	void render( StdAudioSink &sink, Int numFrames, Int numChannels );
+
+private:
+
+	enum CommandType
+	{
+		COMMAND_PLAY,
+		COMMAND_STOP,
+		COMMAND_PAUSE,
+		COMMAND_SET_GAIN,
+		COMMAND_STOP_ALL,
+		COMMAND_PAUSE_ALL,
+	};
+
+	struct Command
+	{
+		CommandType type;
+		VoiceHandle handle;
+		VoiceParams params;		///< the gains are used by COMMAND_SET_GAIN, the looping flag holds the pause state
+	};
+
+	struct Voice
+	{
+		VoiceHandle handle;
+		const Short *pcm;
+		UnsignedInt numFrames;
+		Int numChannels;
+		UnsignedInt64 position;	///< 32.32 fixed point frame position
+		UnsignedInt64 step;			///< 32.32 fixed point frames per output frame
+		Real gainLeft;
+		Real gainRight;
+		Bool looping;
+		Bool paused;
+		Bool finished;
+	};
+
+	void postCommand( const Command &command );
+	void processCommands( void );
+	Voice *findVoice( VoiceHandle handle );
+	void mixVoice( Voice &voice, Real *mixBuffer, Int numFrames );
+	void retireFinishedVoices( void );
+
+	Int m_outputSampleRate;
+
+	StdAudioQueue<Command, COMMAND_QUEUE_SIZE> m_commands;
+	StdAudioQueue<VoiceHandle, FINISHED_QUEUE_SIZE> m_finishedVoices;
+	std::vector<Command> m_pendingCommands;	///< game thread only
+
+	Voice m_voices[ MAX_VOICES ];				///< audio thread only, the first m_numVoices are in use
+	Int m_numVoices;
+	Real m_mixBuffer[ MIX_BLOCK_FRAMES * 2 ];
+	Short m_renderBuffer[ MIX_BLOCK_FRAMES * 2 ];
+};
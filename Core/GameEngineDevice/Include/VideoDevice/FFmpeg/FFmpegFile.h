@@ -86,6 +86,7 @@ private:
 
 	static Int readPacket(void *opaque, UnsignedByte *buf, Int buf_size);
 	const FFmpegStream *findMatch(int type) const;
+	Bool receiveFrames(int stream_idx);
 
 	FFmpegFrameCallback 		m_frameCallback = nullptr; ///< Callback for frame processing
 	AVFormatContext 			*m_fmtCtx = nullptr; ///< Format context for AVFormat
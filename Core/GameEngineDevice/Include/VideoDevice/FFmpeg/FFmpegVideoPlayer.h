@@ -34,6 +34,12 @@
 
 #include "GameClient/VideoPlayer.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 //----------------------------------------------------------------------------
 //           Forward References
 //----------------------------------------------------------------------------
@@ -55,19 +61,56 @@ class FFmpegVideoStream : public VideoStream
 	friend class FFmpegVideoPlayer;
 
 	protected:
+		// TheSuperHackers @performance 19/10/2026 Packets are decoded on a worker thread that keeps a few
+		// frames ahead of playback. The worker also converts each frame into the pixel format and size of
+		// the buffer that was rendered last, so frameRender usually only copies rows into the locked buffer.
+		enum { FRAME_QUEUE_SIZE = 3 };				///< Decoded video frames the worker may keep ahead
+
+		struct DecodedFrame
+		{
+			AVFrame 		*frame = nullptr;		///< Decoded video frame
+			Int 			index = 0;				///< Frame index reported while this frame is current
+			std::vector<UnsignedByte> pixels;		///< Frame converted by the worker, rows are tightly packed
+			Int 			pixelFormat = -1;		///< AVPixelFormat of pixels, -1 if not converted
+			Int 			pixelWidth = 0;
+			Int 			pixelHeight = 0;
+		};
+
 		Bool 			m_good = true;			///< Is the stream valid
-		Bool 			m_gotFrame = false;		///< Is the frame ready to be displayed
-		AVFrame 		*m_frame = nullptr;		///< Current frame
-		SwsContext 		*m_swsContext = nullptr;///< SWSContext for scaling
+		DecodedFrame 	*m_currentFrame = nullptr;///< Current frame
+		SwsContext 		*m_swsContext = nullptr;///< SWSContext for scaling on the main thread
 		FFmpegFile		*m_ffmpegFile;			///< The AVUI abstraction											///< Bink streaming handle;
 		Char			*m_memFile;				///< Pointer to memory resident file
 		UnsignedInt64	m_startTime = 0;		///< Time the stream started
 		UnsignedByte *	m_audioBuffer = nullptr;///< Audio buffer for the stream
 
+		std::thread		m_decodeThread;			///< Worker that decodes packets ahead of playback
+		std::mutex		m_decodeMutex;			///< Guards the queues and the state shared with the worker
+		std::condition_variable m_decodeCondition;
+		std::deque<DecodedFrame *> m_readyFrames;	///< Decoded frames waiting to be shown
+		std::vector<DecodedFrame *> m_freeFrames;	///< Recycled frames
+		std::deque<AVFrame *> m_audioFrames;	///< Decoded audio frames waiting for the main thread
+		Bool			m_stopDecoding = false;	///< Asks the worker to exit
+		Bool			m_decodeFinished = false;///< The worker reached the end of the stream
+		Int				m_targetFormat = -1;	///< AVPixelFormat the worker converts frames to
+		Int				m_targetWidth = 0;
+		Int				m_targetHeight = 0;
+		SwsContext 		*m_decodeSwsContext = nullptr;///< SWSContext for scaling on the worker
+
 		FFmpegVideoStream(FFmpegFile* file);																///< only BinkVideoPlayer can create these
 		virtual ~FFmpegVideoStream();
 
 		static void onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data);
+
+		void startDecoding( void );								///< Starts the worker
+		void stopDecoding( void );								///< Stops the worker and waits for it to exit
+		void decodeLoop( void );									///< Worker entry point
+		void convertFrame( DecodedFrame *decoded, Int format, Int dstWidth, Int dstHeight );	///< Worker only
+		Bool nextDecodedFrame( void );						///< Makes the next decoded frame current, waits if there is none yet
+		void recycleFrame( DecodedFrame *decoded );		///< Must be called with m_decodeMutex locked
+		void flushDecodedFrames( void );					///< Drops all queued frames, the worker must not run
+		void processAudioFrames( void );					///< Passes the decoded audio on to the audio stream
+		void bufferAudioFrame( AVFrame *frame );
 	public:
 
 		virtual void update( void );											///< Update bink stream
@@ -65,6 +65,7 @@ typedef struct {
 class LightMapTerrainTextureClass;
 class CloudMapTerrainTextureClass;
 class W3DDynamicLight;
+class LightClass;
 
 #define DO_SCORCH 1
 
@@ -81,6 +82,19 @@ typedef struct {
 #define VERTEX_FORMAT VertexFormatXYZDUV2
 #define DX8_VERTEX_FORMAT DX8_FVF_XYZDUV2
 
+/// The values of a static light that the terrain lighting reads. Reading them from the light
+/// object can validate its transform, so worker threads must only use a copy like this.
+struct TerrainStaticLight
+{
+	Int type;						///< LightClass::LightType
+	Vector3 position;
+	Vector3 zVector;		///< z axis of the light transform, the direction of directional lights
+	double midRange;
+	double range;
+	Vector3 diffuse;
+	Vector3 ambient;
+};
+
 /// Custom render object that draws the heightmap and handles intersection tests.
 /**
 Custom W3D render object that's used to process the terrain.  It handles
@@ -157,6 +171,9 @@ public:
 	void doTextures(Bool flag) {m_disableTextures = !flag;};
 	/// Update the diffuse value from static light info for one vertex.
 	void doTheLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, RefRenderObjListIterator *pLightsIterator, UnsignedByte alpha);
+	/// Update the diffuse values of the 4 vertices of a cell from copies of the static lights.
+	void doTheLight4(VERTEX_FORMAT *vb, Vector3*light, const Vector3 *normals, const TerrainStaticLight *pLights, Int numLights, const UnsignedByte *alpha);
+	static void getTerrainStaticLight(LightClass *pLight, TerrainStaticLight *light);
 	void addScorch(Vector3 location, Real radius, Scorches type);
 	void addTree(DrawableID id, Coord3D location, Real scale, Real angle,
 								Real randomScaleAmount,  const W3DTreeDrawModuleData *data);
@@ -261,6 +278,11 @@ protected:
 	void freeScorchBuffers(void);		 ///< frees up scorch buffers.
 	void drawScorches(void);		///< Draws the scorch mark polygons in m_vertexScorch.
 #endif
+	/// Adds the global lights to the static lighting and writes the diffuse value of one vertex.
+	void finishTheLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, Real shadeR, Real shadeG, Real shadeB, UnsignedByte alpha);
+	/// Same as finishTheLight for the 4 vertices of a cell, with one vertex per SIMD lane where available.
+	void finishTheLight4(VERTEX_FORMAT *vb, Vector3*light, const Vector3 *normals, const Real *shadeR, const Real *shadeG, const Real *shadeB, const UnsignedByte *alpha);
+
 	WorldHeightMap *m_map;
 	Bool m_useDepthFade;	///<fade terrain lighting under water
 	Bool m_updating;
@@ -0,0 +1,501 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2026 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: StdAudioMixer.cpp ////////////////////////////////////////////////////////////////////////
+// Platform independent software mixer of 16 bit PCM voices into a stereo output.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StdDevice/Audio/StdAudioMixer.h"
+
+#include <string.h>
+
+static const UnsignedInt64 FIXED_ONE = (UnsignedInt64)1 << 32;
+static const UnsignedInt64 FIXED_FRACTION_MASK = FIXED_ONE - 1;
+static const Real FIXED_TO_REAL = 1.0f / 4294967296.0f;
+
+//-------------------------------------------------------------------------------------------------
+static inline Short clampSample( Real v )
+{
+	v = v > 32767.0f ? 32767.0f : v;
+	v = v < -32768.0f ? -32768.0f : v;
+	return (Short)v;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void writeLittleEndian( FILE *file, UnsignedInt value, Int numBytes )
+{
+	for (Int i = 0; i < numBytes; ++i)
+		fputc((value >> (i * 8)) & 0xFF, file);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StdWavFileAudioSink
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+StdWavFileAudioSink::StdWavFileAudioSink()
+	: m_file(nullptr)
+	, m_sampleRate(0)
+	, m_numChannels(0)
+	, m_dataBytes(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+StdWavFileAudioSink::~StdWavFileAudioSink()
+{
+	close();
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool StdWavFileAudioSink::open( const char *fileName, Int sampleRate, Int numChannels )
+{
+	close();
+
+	m_file = fopen(fileName, "wb");
+	if (m_file == nullptr)
+		return false;
+
+	m_sampleRate = sampleRate;
+	m_numChannels = numChannels;
+	m_dataBytes = 0;
+	writeHeader();
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Finishes the sizes in the header and closes the file */
+//-------------------------------------------------------------------------------------------------
+void StdWavFileAudioSink::close( void )
+{
+	if (m_file == nullptr)
+		return;
+
+	fseek(m_file, 0, SEEK_SET);
+	writeHeader();
+	fclose(m_file);
+	m_file = nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdWavFileAudioSink::writeHeader( void )
+{
+	const UnsignedInt bytesPerFrame = m_numChannels * sizeof(Short);
+
+	fwrite("RIFF", 1, 4, m_file);
+	writeLittleEndian(m_file, 36 + m_dataBytes, 4);
+	fwrite("WAVEfmt ", 1, 8, m_file);
+	writeLittleEndian(m_file, 16, 4);
+	writeLittleEndian(m_file, 1, 2);	// PCM
+	writeLittleEndian(m_file, m_numChannels, 2);
+	writeLittleEndian(m_file, m_sampleRate, 4);
+	writeLittleEndian(m_file, m_sampleRate * bytesPerFrame, 4);
+	writeLittleEndian(m_file, bytesPerFrame, 2);
+	writeLittleEndian(m_file, 16, 2);
+	fwrite("data", 1, 4, m_file);
+	writeLittleEndian(m_file, m_dataBytes, 4);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdWavFileAudioSink::write( const Short *samples, Int numFrames, Int numChannels )
+{
+	if (m_file == nullptr || numChannels != m_numChannels)
+		return;
+
+	// convert a mix block at a time and write it in one go
+	enum { CHUNK_SAMPLES = StdAudioMixer::MIX_BLOCK_FRAMES * 2 };
+	UnsignedByte bytes[ CHUNK_SAMPLES * sizeof(Short) ];
+
+	const Int numSamples = numFrames * numChannels;
+	for (Int start = 0; start < numSamples; start += CHUNK_SAMPLES)
+	{
+		const Int count = numSamples - start < CHUNK_SAMPLES ? numSamples - start : CHUNK_SAMPLES;
+		for (Int i = 0; i < count; ++i)
+		{
+			const UnsignedShort value = (UnsignedShort)samples[start + i];
+			bytes[i * 2] = (UnsignedByte)(value & 0xFF);
+			bytes[i * 2 + 1] = (UnsignedByte)(value >> 8);
+		}
+		fwrite(bytes, sizeof(Short), count, m_file);
+	}
+
+	m_dataBytes += numSamples * sizeof(Short);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StdAudioMixer
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//-------------------------------------------------------------------------------------------------
+StdAudioMixer::StdAudioMixer( Int outputSampleRate )
+	: m_outputSampleRate(outputSampleRate)
+	, m_numVoices(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::postCommand( const Command &command )
+{
+	// keep the order of the commands when some are waiting already
+	flushCommands();
+	if (!m_pendingCommands.empty() || !m_commands.push(command))
+		m_pendingCommands.push_back(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::flushCommands( void )
+{
+	size_t i = 0;
+	while (i < m_pendingCommands.size() && m_commands.push(m_pendingCommands[i]))
+		++i;
+
+	m_pendingCommands.erase(m_pendingCommands.begin(), m_pendingCommands.begin() + i);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::playVoice( VoiceHandle handle, const VoiceParams &params )
+{
+	Command command;
+	command.type = COMMAND_PLAY;
+	command.handle = handle;
+	command.params = params;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::stopVoice( VoiceHandle handle )
+{
+	Command command;
+	command.type = COMMAND_STOP;
+	command.handle = handle;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::pauseVoice( VoiceHandle handle, Bool paused )
+{
+	Command command;
+	command.type = COMMAND_PAUSE;
+	command.handle = handle;
+	command.params.looping = paused;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::setVoiceGain( VoiceHandle handle, Real gainLeft, Real gainRight )
+{
+	Command command;
+	command.type = COMMAND_SET_GAIN;
+	command.handle = handle;
+	command.params.gainLeft = gainLeft;
+	command.params.gainRight = gainRight;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::stopAllVoices( void )
+{
+	Command command;
+	command.type = COMMAND_STOP_ALL;
+	command.handle = 0;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::pauseAllVoices( Bool paused )
+{
+	Command command;
+	command.type = COMMAND_PAUSE_ALL;
+	command.handle = 0;
+	command.params.looping = paused;
+	postCommand(command);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool StdAudioMixer::popFinishedVoice( VoiceHandle &handle )
+{
+	return m_finishedVoices.pop(handle);
+}
+
+//-------------------------------------------------------------------------------------------------
+StdAudioMixer::Voice *StdAudioMixer::findVoice( VoiceHandle handle )
+{
+	for (Int i = 0; i < m_numVoices; ++i)
+	{
+		if (m_voices[i].handle == handle)
+			return &m_voices[i];
+	}
+	return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::processCommands( void )
+{
+	Command command;
+	while (m_commands.pop(command))
+	{
+		switch (command.type)
+		{
+			case COMMAND_PLAY:
+			{
+				if (m_numVoices == MAX_VOICES)
+				{
+					// the game thread keeps within the voice limit, but never lose the handle
+					m_finishedVoices.push(command.handle);
+					break;
+				}
+
+				const VoiceParams &params = command.params;
+				const Int sampleRate = params.sampleRate > 0 ? params.sampleRate : m_outputSampleRate;
+
+				Voice &voice = m_voices[m_numVoices++];
+				voice.handle = command.handle;
+				voice.pcm = params.pcm;
+				voice.numFrames = params.numFrames;
+				voice.numChannels = params.numChannels > 0 ? params.numChannels : 1;
+				voice.position = 0;
+				voice.step = ((UnsignedInt64)sampleRate << 32) / (UnsignedInt64)m_outputSampleRate;
+				voice.gainLeft = params.gainLeft;
+				voice.gainRight = params.gainRight;
+				voice.looping = params.looping;
+				voice.paused = false;
+				voice.finished = params.pcm == nullptr || params.numFrames == 0;
+				break;
+			}
+
+			case COMMAND_STOP:
+				if (Voice *voice = findVoice(command.handle))
+					voice->finished = true;
+				break;
+
+			case COMMAND_PAUSE:
+				if (Voice *voice = findVoice(command.handle))
+					voice->paused = command.params.looping;
+				break;
+
+			case COMMAND_SET_GAIN:
+				if (Voice *voice = findVoice(command.handle))
+				{
+					voice->gainLeft = command.params.gainLeft;
+					voice->gainRight = command.params.gainRight;
+				}
+				break;
+
+			case COMMAND_STOP_ALL:
+				for (Int i = 0; i < m_numVoices; ++i)
+					m_voices[i].finished = true;
+				break;
+
+			case COMMAND_PAUSE_ALL:
+				for (Int i = 0; i < m_numVoices; ++i)
+					m_voices[i].paused = command.params.looping;
+				break;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Accumulates the voice into the stereo mix buffer. Voices at the output rate are copied,
+	* others are resampled with linear interpolation. */
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::mixVoice( Voice &voice, Real *mixBuffer, Int numFrames )
+{
+	const Short *pcm = voice.pcm;
+	const Int stride = voice.numChannels;
+	const Int right = stride >= 2 ? 1 : 0;
+	const Real gainLeft = voice.gainLeft;
+	const Real gainRight = voice.gainRight;
+	const UnsignedInt64 step = voice.step;
+	const UnsignedInt64 end = (UnsignedInt64)voice.numFrames << 32;
+	const UnsignedInt64 lastPosition = (UnsignedInt64)(voice.numFrames - 1) << 32;
+
+	Int out = 0;
+	while (out < numFrames)
+	{
+		if (voice.position >= end)
+		{
+			if (!voice.looping)
+			{
+				voice.finished = true;
+				return;
+			}
+
+			voice.position -= end;
+			if (voice.position >= end)
+				voice.position %= end;
+		}
+
+		Real *dst = mixBuffer + out * 2;
+		const Int count = numFrames - out;
+
+		if (step == FIXED_ONE && (voice.position & FIXED_FRACTION_MASK) == 0)
+		{
+			// same rate, no interpolation
+			const UnsignedInt first = (UnsignedInt)(voice.position >> 32);
+			const UnsignedInt available = voice.numFrames - first;
+			const Int n = (UnsignedInt)count < available ? count : (Int)available;
+			const Short *src = pcm + first * stride;
+
+			if (stride == 1)
+			{
+				for (Int i = 0; i < n; ++i)
+				{
+					const Real s = src[i];
+					dst[i * 2] += s * gainLeft;
+					dst[i * 2 + 1] += s * gainRight;
+				}
+			}
+			else
+			{
+				for (Int i = 0; i < n; ++i)
+				{
+					dst[i * 2] += src[i * stride] * gainLeft;
+					dst[i * 2 + 1] += src[i * stride + right] * gainRight;
+				}
+			}
+
+			voice.position += (UnsignedInt64)n << 32;
+			out += n;
+		}
+		else if (voice.position < lastPosition)
+		{
+			// both interpolated frames are inside the data
+			const UnsignedInt64 framesToLast = (lastPosition - voice.position + step - 1) / step;
+			const Int n = (UnsignedInt64)count < framesToLast ? count : (Int)framesToLast;
+			UnsignedInt64 position = voice.position;
+
+			for (Int i = 0; i < n; ++i)
+			{
+				const Short *a = pcm + (UnsignedInt)(position >> 32) * stride;
+				const Short *b = a + stride;
+				const Real t = (Real)(position & FIXED_FRACTION_MASK) * FIXED_TO_REAL;
+				const Real l = a[0] + (b[0] - a[0]) * t;
+				const Real r = a[right] + (b[right] - a[right]) * t;
+				dst[i * 2] += l * gainLeft;
+				dst[i * 2 + 1] += r * gainRight;
+				position += step;
+			}
+
+			voice.position = position;
+			out += n;
+		}
+		else
+		{
+			// the last frame interpolates towards the start when looping, or towards silence
+			const Short *a = pcm + (voice.numFrames - 1) * stride;
+			const Real t = (Real)(voice.position & FIXED_FRACTION_MASK) * FIXED_TO_REAL;
+			const Real nextLeft = voice.looping ? pcm[0] : 0.0f;
+			const Real nextRight = voice.looping ? pcm[right] : 0.0f;
+			dst[0] += (a[0] + (nextLeft - a[0]) * t) * gainLeft;
+			dst[1] += (a[right] + (nextRight - a[right]) * t) * gainRight;
+
+			voice.position += step;
+			++out;
+		}
+	}
+
+	if (voice.position >= end && !voice.looping)
+		voice.finished = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Hands the finished voices back to the game thread */
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::retireFinishedVoices( void )
+{
+	Int i = 0;
+	while (i < m_numVoices)
+	{
+		if (m_voices[i].finished)
+		{
+			if (!m_finishedVoices.push(m_voices[i].handle))
+				break;
+
+			m_voices[i] = m_voices[--m_numVoices];
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::mix( Short *output, Int numFrames, Int numChannels )
+{
+	processCommands();
+
+	while (numFrames > 0)
+	{
+		const Int frames = numFrames < MIX_BLOCK_FRAMES ? numFrames : MIX_BLOCK_FRAMES;
+		const Int numSamples = frames * 2;
+
+		memset(m_mixBuffer, 0, numSamples * sizeof(Real));
+
+		for (Int i = 0; i < m_numVoices; ++i)
+		{
+			Voice &voice = m_voices[i];
+			if (!voice.finished && !voice.paused)
+				mixVoice(voice, m_mixBuffer, frames);
+		}
+
+		if (numChannels == 2)
+		{
+			for (Int i = 0; i < numSamples; ++i)
+				output[i] = clampSample(m_mixBuffer[i]);
+		}
+		else if (numChannels == 1)
+		{
+			for (Int i = 0; i < frames; ++i)
+				output[i] = clampSample((m_mixBuffer[i * 2] + m_mixBuffer[i * 2 + 1]) * 0.5f);
+		}
+		else
+		{
+			for (Int i = 0; i < frames; ++i)
+			{
+				Short *frame = output + i * numChannels;
+				frame[0] = clampSample(m_mixBuffer[i * 2]);
+				frame[1] = clampSample(m_mixBuffer[i * 2 + 1]);
+				for (Int c = 2; c < numChannels; ++c)
+					frame[c] = 0;
+			}
+		}
+
+		output += frames * numChannels;
+		numFrames -= frames;
+	}
+
+	retireFinishedVoices();
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Mixes into the sink on the calling thread, in place of an audio device callback */
+//-------------------------------------------------------------------------------------------------
+void StdAudioMixer::render( StdAudioSink &sink, Int numFrames, Int numChannels )
+{
+	if (numChannels < 1 || numChannels > 2)
+		return;
+
+	while (numFrames > 0)
+	{
+		const Int frames = numFrames < MIX_BLOCK_FRAMES ? numFrames : MIX_BLOCK_FRAMES;
+		mix(m_renderBuffer, frames, numChannels);
+		sink.write(m_renderBuffer, frames, numChannels);
+		numFrames -= frames;
+	}
+}
@@ -132,6 +132,12 @@ Bool FFmpegFile::open(File *file)
 			return false;
 		}
 
+		// TheSuperHackers @performance 19/10/2026 Let the video decoder spread the work over all cores
+		if (input_codec->type == AVMEDIA_TYPE_VIDEO) {
+			codec_ctx->thread_count = 0;
+			codec_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+		}
+
 		result = avcodec_open2(codec_ctx, input_codec, nullptr);
 		if (result < 0) {
 			char error_buffer[1024];
@@ -207,14 +213,19 @@ Bool FFmpegFile::decodePacket()
 	DEBUG_ASSERTCRASH(m_packet != nullptr, ("null packet pointer"));
 
 	int result = av_read_frame(m_fmtCtx, m_packet);
-	if (result == AVERROR_EOF)
+	if (result == AVERROR_EOF) {
+		// Drain the decoders, with frame threading they hold back the last frames of the stream
+		for (size_t stream_idx = 0; stream_idx < m_streams.size(); stream_idx++) {
+			if (avcodec_send_packet(m_streams[stream_idx].codec_ctx, nullptr) >= 0)
+				receiveFrames(stream_idx);
+		}
 		return false;
+	}
 
 	const int stream_idx = m_packet->stream_index;
 	DEBUG_ASSERTCRASH(m_streams.size() > stream_idx, ("stream index out of bounds"));
 
-	auto &stream = m_streams[stream_idx];
-	AVCodecContext *codec_ctx = stream.codec_ctx;
+	AVCodecContext *codec_ctx = m_streams[stream_idx].codec_ctx;
 	result = avcodec_send_packet(codec_ctx, m_packet);
 	// Check if we need more data
 	if (result == AVERROR(EAGAIN))
@@ -229,12 +240,23 @@ Bool FFmpegFile::decodePacket()
 	}
 	av_packet_unref(m_packet);
 
+	return receiveFrames(stream_idx);
+}
+
+/**
+ * Pass all frames the decoder has ready to the frame callback
+ */
+Bool FFmpegFile::receiveFrames(int stream_idx)
+{
+	auto &stream = m_streams[stream_idx];
+	AVCodecContext *codec_ctx = stream.codec_ctx;
+
 	// Get all frames in this packet
-	while (result >= 0) {
-		result = avcodec_receive_frame(codec_ctx, stream.frame);
+	for (;;) {
+		int result = avcodec_receive_frame(codec_ctx, stream.frame);
 
-		// Check if we need more data
-		if (result == AVERROR(EAGAIN))
+		// Check if we need more data or the decoder is drained
+		if (result == AVERROR(EAGAIN) || result == AVERROR_EOF)
 			return true;
 
 		// Handle any other errors
@@ -249,8 +271,6 @@ Bool FFmpegFile::decodePacket()
 			m_frameCallback(stream.frame, stream_idx, stream.stream_type, m_userData);
 		}
 	}
-
-	return true;
 }
 
 void FFmpegFile::seekFrame(int frame_idx)
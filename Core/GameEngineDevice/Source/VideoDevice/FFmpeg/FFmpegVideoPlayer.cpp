@@ -43,6 +43,7 @@
 
 extern "C" {
 	#include <libavcodec/avcodec.h>
+	#include <libavutil/pixdesc.h>
 	#include <libswscale/swscale.h>
 }
 
@@ -317,9 +318,11 @@ FFmpegVideoStream::FFmpegVideoStream(FFmpegFile* file)
 	audioStream->reset();
 #endif
 
-	// Decode until we have our first video frame
-	while (m_good && m_gotFrame == false)
-		m_good = m_ffmpegFile->decodePacket();
+	startDecoding();
+
+	// Wait until we have our first video frame
+	m_good = nextDecodedFrame();
+	processAudioFrames();
 
  #ifdef RTS_USE_OPENAL
 	// Start audio playback
@@ -335,55 +338,288 @@ FFmpegVideoStream::FFmpegVideoStream(FFmpegFile* file)
 
 FFmpegVideoStream::~FFmpegVideoStream()
 {
+	stopDecoding();
+	flushDecodedFrames();
+
+	if (m_currentFrame != nullptr) {
+		m_freeFrames.push_back(m_currentFrame);
+		m_currentFrame = nullptr;
+	}
+	for (DecodedFrame *decoded : m_freeFrames) {
+		av_frame_free(&decoded->frame);
+		delete decoded;
+	}
+	m_freeFrames.clear();
+
 	av_freep(&m_audioBuffer);
-	av_frame_free(&m_frame);
 	sws_freeContext(m_swsContext);
+	sws_freeContext(m_decodeSwsContext);
 	delete m_ffmpegFile;
 }
 
+//============================================================================
+// FFmpegVideoStream::onFrame
+//============================================================================
+
 void FFmpegVideoStream::onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data)
 {
+	// Called on the worker thread
 	FFmpegVideoStream *videoStream = static_cast<FFmpegVideoStream *>(user_data);
 	if (stream_type == AVMEDIA_TYPE_VIDEO) {
-		av_frame_free(&videoStream->m_frame);
-		videoStream->m_frame = av_frame_clone(frame);
-		videoStream->m_gotFrame = true;
+		DecodedFrame *decoded = nullptr;
+		Int targetFormat, targetWidth, targetHeight;
+		{
+			std::lock_guard<std::mutex> lock(videoStream->m_decodeMutex);
+			if (!videoStream->m_freeFrames.empty()) {
+				decoded = videoStream->m_freeFrames.back();
+				videoStream->m_freeFrames.pop_back();
+			}
+			targetFormat = videoStream->m_targetFormat;
+			targetWidth = videoStream->m_targetWidth;
+			targetHeight = videoStream->m_targetHeight;
+		}
+
+		if (decoded == nullptr) {
+			decoded = NEW DecodedFrame;
+			decoded->frame = av_frame_alloc();
+		}
+
+		if (decoded->frame == nullptr || av_frame_ref(decoded->frame, frame) < 0) {
+			DEBUG_LOG(("Failed to reference video frame"));
+			std::lock_guard<std::mutex> lock(videoStream->m_decodeMutex);
+			videoStream->m_freeFrames.push_back(decoded);
+			return;
+		}
+
+		decoded->index = videoStream->m_ffmpegFile->getCurrentFrame();
+		videoStream->convertFrame(decoded, targetFormat, targetWidth, targetHeight);
+
+		{
+			std::lock_guard<std::mutex> lock(videoStream->m_decodeMutex);
+			videoStream->m_readyFrames.push_back(decoded);
+		}
+		videoStream->m_decodeCondition.notify_all();
 	}
 #ifdef RTS_USE_OPENAL
 	else if (stream_type == AVMEDIA_TYPE_AUDIO) {
-		OpenALAudioStream* audioStream = (OpenALAudioStream*)TheAudio->getHandleForBink();
-		audioStream->update();
-		AVSampleFormat sampleFmt = static_cast<AVSampleFormat>(frame->format);
-		const int bytesPerSample = av_get_bytes_per_sample(sampleFmt);
-		const int frameSize = av_samples_get_buffer_size(nullptr, frame->ch_layout.nb_channels, frame->nb_samples, sampleFmt, 1);
-		uint8_t* frameData = frame->data[0];
-		// The format is planar - convert it to interleaved
-		if (av_sample_fmt_is_planar(sampleFmt))
+		// The audio stream is not thread safe, the main thread buffers the data
+		AVFrame *audioFrame = av_frame_clone(frame);
+		if (audioFrame == nullptr) {
+			DEBUG_LOG(("Failed to clone audio frame"));
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(videoStream->m_decodeMutex);
+		videoStream->m_audioFrames.push_back(audioFrame);
+	}
+#endif
+}
+
+//============================================================================
+// FFmpegVideoStream::startDecoding
+//============================================================================
+
+void FFmpegVideoStream::startDecoding( void )
+{
+	DEBUG_ASSERTCRASH(!m_decodeThread.joinable(), ("decode thread already running"));
+
+	m_stopDecoding = false;
+	m_decodeFinished = false;
+	m_decodeThread = std::thread(&FFmpegVideoStream::decodeLoop, this);
+}
+
+//============================================================================
+// FFmpegVideoStream::stopDecoding
+//============================================================================
+
+void FFmpegVideoStream::stopDecoding( void )
+{
+	if (!m_decodeThread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_stopDecoding = true;
+	}
+	m_decodeCondition.notify_all();
+	m_decodeThread.join();
+}
+
+//============================================================================
+// FFmpegVideoStream::decodeLoop
+//============================================================================
+
+void FFmpegVideoStream::decodeLoop( void )
+{
+	std::unique_lock<std::mutex> lock(m_decodeMutex);
+	while (!m_stopDecoding) {
+		if (m_readyFrames.size() >= FRAME_QUEUE_SIZE) {
+			m_decodeCondition.wait(lock);
+			continue;
+		}
+
+		lock.unlock();
+		const Bool good = m_ffmpegFile->decodePacket();
+		lock.lock();
+
+		if (!good) {
+			m_decodeFinished = true;
+			break;
+		}
+	}
+	lock.unlock();
+	m_decodeCondition.notify_all();
+}
+
+//============================================================================
+// FFmpegVideoStream::convertFrame
+//============================================================================
+
+void FFmpegVideoStream::convertFrame( DecodedFrame *decoded, Int format, Int dstWidth, Int dstHeight )
+{
+	decoded->pixelFormat = AV_PIX_FMT_NONE;
+	if (format == AV_PIX_FMT_NONE || dstWidth <= 0 || dstHeight <= 0)
+		return;
+
+	const Int bytesPerPixel = av_get_padded_bits_per_pixel(av_pix_fmt_desc_get(static_cast<AVPixelFormat>(format))) / 8;
+
+	m_decodeSwsContext = sws_getCachedContext(m_decodeSwsContext,
+		width(),
+		height(),
+		static_cast<AVPixelFormat>(decoded->frame->format),
+		dstWidth,
+		dstHeight,
+		static_cast<AVPixelFormat>(format),
+		SWS_BICUBIC,
+		nullptr,
+		nullptr,
+		nullptr);
+	if (m_decodeSwsContext == nullptr)
+		return;
+
+	const Int pitch = dstWidth * bytesPerPixel;
+	decoded->pixels.resize(pitch * dstHeight);
+
+	int dst_strides[] = { pitch };
+	uint8_t *dst_data[] = { decoded->pixels.data() };
+	const int result =
+		sws_scale(m_decodeSwsContext, decoded->frame->data, decoded->frame->linesize, 0, height(), dst_data, dst_strides);
+	if (result < 0)
+		return;
+
+	decoded->pixelFormat = format;
+	decoded->pixelWidth = dstWidth;
+	decoded->pixelHeight = dstHeight;
+}
+
+//============================================================================
+// FFmpegVideoStream::nextDecodedFrame
+//============================================================================
+
+Bool FFmpegVideoStream::nextDecodedFrame( void )
+{
+	std::unique_lock<std::mutex> lock(m_decodeMutex);
+	m_decodeCondition.wait(lock, [this] { return !m_readyFrames.empty() || m_decodeFinished; });
+
+	if (m_readyFrames.empty())
+		return false;
+
+	if (m_currentFrame != nullptr)
+		recycleFrame(m_currentFrame);
+
+	m_currentFrame = m_readyFrames.front();
+	m_readyFrames.pop_front();
+	lock.unlock();
+
+	// Wake the worker, there is room in the queue again
+	m_decodeCondition.notify_all();
+	return true;
+}
+
+//============================================================================
+// FFmpegVideoStream::recycleFrame
+//============================================================================
+
+void FFmpegVideoStream::recycleFrame( DecodedFrame *decoded )
+{
+	av_frame_unref(decoded->frame);
+	m_freeFrames.push_back(decoded);
+}
+
+//============================================================================
+// FFmpegVideoStream::flushDecodedFrames
+//============================================================================
+
+void FFmpegVideoStream::flushDecodedFrames( void )
+{
+	std::lock_guard<std::mutex> lock(m_decodeMutex);
+
+	for (DecodedFrame *decoded : m_readyFrames)
+		recycleFrame(decoded);
+	m_readyFrames.clear();
+
+	for (AVFrame *frame : m_audioFrames)
+		av_frame_free(&frame);
+	m_audioFrames.clear();
+}
+
+//============================================================================
+// FFmpegVideoStream::processAudioFrames
+//============================================================================
+
+void FFmpegVideoStream::processAudioFrames( void )
+{
+	std::deque<AVFrame *> audioFrames;
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		audioFrames.swap(m_audioFrames);
+	}
+
+	for (AVFrame *frame : audioFrames) {
+		bufferAudioFrame(frame);
+		av_frame_free(&frame);
+	}
+}
+
+//============================================================================
+// FFmpegVideoStream::bufferAudioFrame
+//============================================================================
+
+void FFmpegVideoStream::bufferAudioFrame( AVFrame *frame )
+{
+#ifdef RTS_USE_OPENAL
+	OpenALAudioStream* audioStream = (OpenALAudioStream*)TheAudio->getHandleForBink();
+	audioStream->update();
+	AVSampleFormat sampleFmt = static_cast<AVSampleFormat>(frame->format);
+	const int bytesPerSample = av_get_bytes_per_sample(sampleFmt);
+	const int frameSize = av_samples_get_buffer_size(nullptr, frame->ch_layout.nb_channels, frame->nb_samples, sampleFmt, 1);
+	uint8_t* frameData = frame->data[0];
+	// The format is planar - convert it to interleaved
+	if (av_sample_fmt_is_planar(sampleFmt))
+	{
+		m_audioBuffer = static_cast<uint8_t*>(av_realloc(m_audioBuffer, frameSize));
+		if (m_audioBuffer == nullptr)
 		{
-			videoStream->m_audioBuffer = static_cast<uint8_t*>(av_realloc(videoStream->m_audioBuffer, frameSize));
-			if (videoStream->m_audioBuffer == nullptr)
-			{
-				DEBUG_LOG(("Failed to allocate audio buffer"));
-				return;
-			}
+			DEBUG_LOG(("Failed to allocate audio buffer"));
+			return;
+		}
 
-			// Write the samples into our audio buffer
-			for (int sample_idx = 0; sample_idx < frame->nb_samples; sample_idx++)
+		// Write the samples into our audio buffer
+		for (int sample_idx = 0; sample_idx < frame->nb_samples; sample_idx++)
+		{
+			int byte_offset = sample_idx * bytesPerSample;
+			for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; channel_idx++)
 			{
-				int byte_offset = sample_idx * bytesPerSample;
-				for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; channel_idx++)
-				{
-					uint8_t* dst = &videoStream->m_audioBuffer[byte_offset * frame->ch_layout.nb_channels + channel_idx * bytesPerSample];
-					uint8_t* src = &frame->data[channel_idx][byte_offset];
-					memcpy(dst, src, bytesPerSample);
-				}
+				uint8_t* dst = &m_audioBuffer[byte_offset * frame->ch_layout.nb_channels + channel_idx * bytesPerSample];
+				uint8_t* src = &frame->data[channel_idx][byte_offset];
+				memcpy(dst, src, bytesPerSample);
 			}
-			frameData = videoStream->m_audioBuffer;
 		}
-
-		ALenum format = OpenALAudioManager::getALFormat(frame->ch_layout.nb_channels, bytesPerSample * 8);
-		audioStream->bufferData(frameData, frameSize, format, frame->sample_rate);
+		frameData = m_audioBuffer;
 	}
+
+	ALenum format = OpenALAudioManager::getALFormat(frame->ch_layout.nb_channels, bytesPerSample * 8);
+	audioStream->bufferData(frameData, frameSize, format, frame->sample_rate);
 #endif
 }
 
@@ -394,6 +630,8 @@ void FFmpegVideoStream::onFrame(AVFrame *frame, int stream_idx, int stream_type,
 
 void FFmpegVideoStream::update( void )
 {
+	processAudioFrames();
+
 #ifdef RTS_USE_OPENAL
 	// Start audio playback
 	OpenALAudioStream* audioStream = (OpenALAudioStream*)TheAudio->getHandleForBink();
@@ -434,11 +672,12 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 		return;
 	}
 
-	if (m_frame == nullptr) {
+	if (m_currentFrame == nullptr) {
 		return;
 	}
 
-	if (m_frame->data == nullptr) {
+	AVFrame *frame = m_currentFrame->frame;
+	if (frame->data[0] == nullptr) {
 		return;
 	}
 
@@ -461,17 +700,16 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 			return;
 	}
 
-	m_swsContext = sws_getCachedContext(m_swsContext,
-		width(),
-		height(),
-		static_cast<AVPixelFormat>(m_frame->format),
-		buffer->width(),
-		buffer->height(),
-		dst_pix_fmt,
-		SWS_BICUBIC,
-		nullptr,
-		nullptr,
-		nullptr);
+	const Int dst_width = buffer->width();
+	const Int dst_height = buffer->height();
+
+	// Let the worker convert the upcoming frames for this buffer
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_targetFormat = dst_pix_fmt;
+		m_targetWidth = dst_width;
+		m_targetHeight = dst_height;
+	}
 
 	uint8_t *buffer_data = static_cast<uint8_t *>(buffer->lock());
 	if (buffer_data == nullptr) {
@@ -479,11 +717,35 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 		return;
 	}
 
-	int dst_strides[] = { (int)buffer->pitch() };
-	uint8_t *dst_data[] = { buffer_data };
-	[[maybe_unused]] int result =
-		sws_scale(m_swsContext, m_frame->data, m_frame->linesize, 0, height(), dst_data, dst_strides);
-	DEBUG_ASSERTLOG(result >= 0, ("Failed to scale frame"));
+	const DecodedFrame *decoded = m_currentFrame;
+	if (decoded->pixelFormat == dst_pix_fmt && decoded->pixelWidth == dst_width && decoded->pixelHeight == dst_height) {
+		const size_t row_size = decoded->pixels.size() / dst_height;
+		const UnsignedByte *src = decoded->pixels.data();
+		for (Int y = 0; y < dst_height; ++y) {
+			memcpy(buffer_data, src, row_size);
+			buffer_data += buffer->pitch();
+			src += row_size;
+		}
+	} else {
+		// The frame was decoded before this buffer was known, convert it here
+		m_swsContext = sws_getCachedContext(m_swsContext,
+			width(),
+			height(),
+			static_cast<AVPixelFormat>(frame->format),
+			dst_width,
+			dst_height,
+			dst_pix_fmt,
+			SWS_BICUBIC,
+			nullptr,
+			nullptr,
+			nullptr);
+
+		int dst_strides[] = { (int)buffer->pitch() };
+		uint8_t *dst_data[] = { buffer_data };
+		[[maybe_unused]] int result =
+			sws_scale(m_swsContext, frame->data, frame->linesize, 0, height(), dst_data, dst_strides);
+		DEBUG_ASSERTLOG(result >= 0, ("Failed to scale frame"));
+	}
 	buffer->unlock();
 }
 
@@ -493,10 +755,11 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 
 void FFmpegVideoStream::frameNext( void )
 {
-	m_gotFrame = false;
-	// Decode until we have our next video frame
-	while (m_good && m_gotFrame == false)
-		m_good = m_ffmpegFile->decodePacket();
+	// Take the next frame the worker decoded, this only waits when the worker fell behind
+	if (m_good)
+		m_good = nextDecodedFrame();
+
+	processAudioFrames();
 }
 
 //============================================================================
@@ -505,7 +768,7 @@ void FFmpegVideoStream::frameNext( void )
 
 Int FFmpegVideoStream::frameIndex( void )
 {
-	return m_ffmpegFile->getCurrentFrame();
+	return m_currentFrame != nullptr ? m_currentFrame->index : 0;
 }
 
 //============================================================================
@@ -523,7 +786,10 @@ Int	FFmpegVideoStream::frameCount( void )
 
 void FFmpegVideoStream::frameGoto( Int index )
 {
+	stopDecoding();
 	m_ffmpegFile->seekFrame(index);
+	flushDecodedFrames();
+	startDecoding();
 }
 
 //============================================================================
@@ -96,6 +96,18 @@
 #include "W3DDevice/GameClient/W3DSmudge.h"
 #include "W3DDevice/GameClient/W3DSnow.h"
 
+// TheSuperHackers @performance 19/10/2026 The global terrain lights of a cell are computed with one
+// vertex per SIMD lane. Every lane does the same float operations in the same order as the scalar
+// code. On x86 the lanes match the scalar colors exactly, which is why SSE2 is only used where the
+// scalar float math is not done in x87 registers. On ARM the compiler can fuse the scalar multiply
+// adds, so a color channel can differ in its lowest bit.
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || (defined(__SSE2__) && (defined(__x86_64__) || defined(__SSE2_MATH__)))
+#define HEIGHTMAP_LIGHT_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HEIGHTMAP_LIGHT_NEON
+#include <arm_neon.h>
+#endif
 
 extern FlatHeightMapRenderObjClass *TheFlatHeightMap;
 extern HeightMapRenderObjClass *TheHeightMap;
@@ -493,6 +505,78 @@ void BaseHeightMapRenderObjClass::ReAcquireResources(void)
 	}
 }
 
+//=============================================================================
+// BaseHeightMapRenderObjClass::getTerrainStaticLight
+//=============================================================================
+/** Copies the values of a static light that the terrain lighting reads. */
+//=============================================================================
+void BaseHeightMapRenderObjClass::getTerrainStaticLight(LightClass *pLight, TerrainStaticLight *light)
+{
+	light->type = pLight->Get_Type();
+	light->position = pLight->Get_Position();
+	light->zVector = pLight->Get_Transform().Get_Z_Vector();
+	pLight->Get_Far_Attenuation_Range(light->midRange, light->range);
+	pLight->Get_Diffuse(&light->diffuse);
+	pLight->Get_Ambient(&light->ambient);
+}
+
+//=============================================================================
+// addTheLight
+//=============================================================================
+/** Adds the contribution of one static light to the diffuse lighting of a
+terrain vertex. */
+//=============================================================================
+static void addTheLight(const VERTEX_FORMAT *vb, const Vector3 *normal, const TerrainStaticLight *pLight, Real &shadeR, Real &shadeG, Real &shadeB)
+{
+	Vector3 lightDirection(vb->x, vb->y, vb->z);
+	Real factor = 1.0f;
+	switch(pLight->type) {
+	case LightClass::POINT:
+	case LightClass::SPOT: {
+			const Vector3 &lightLoc = pLight->position;
+			lightDirection -= lightLoc;
+			const double range = pLight->range;
+			const double midRange = pLight->midRange;
+			if (vb->x < lightLoc.X-range) return;
+			if (vb->x > lightLoc.X+range) return;
+			if (vb->y < lightLoc.Y-range) return;
+			if (vb->y > lightLoc.Y+range) return;
+			Real dist = lightDirection.Length();
+			if (dist >= range) return;
+			if (midRange < 0.1) return;
+#if 1
+			factor = 1.0f - (dist - midRange) / (range - midRange);
+#else
+			// f = 1.0 / (atten0 + d*atten1 + d*d/atten2);
+			if (fabs(range-midRange)<1e-5)	{
+				// if the attenuation range is too small assume uniform with cutoff
+				factor = 1.0;
+			}	else  {
+				factor = 1.0f/(0.1+dist/midRange + 5.0f*dist*dist/(range*range));
+			}
+#endif
+			factor = WWMath::Clamp(factor,0.0f,1.0f);
+		}
+		break;
+	case LightClass::DIRECTIONAL:
+		lightDirection = pLight->zVector;
+		factor = 1.0;
+		break;
+	};
+	lightDirection.Normalize();
+	Vector3 lightRay(-lightDirection.X, -lightDirection.Y, -lightDirection.Z);
+	Real shade = Vector3::Dot_Product(lightRay, *normal);
+	shade *= factor;
+	if (shade > 1.0) shade = 1.0;
+	if(shade < 0.0f) shade = 0.0f;
+	shadeR += shade*pLight->diffuse.X;
+	shadeG += shade*pLight->diffuse.Y;
+	shadeB += shade*pLight->diffuse.Z;
+	shadeR += factor*pLight->ambient.X;
+	shadeG += factor*pLight->ambient.Y;
+	shadeB += factor*pLight->ambient.Z;
+}
+
 //=============================================================================
 // BaseHeightMapRenderObjClass::doTheLight
 //=============================================================================
@@ -509,7 +593,6 @@ void BaseHeightMapRenderObjClass::doTheLight(VERTEX_FORMAT *vb, Vector3*light, V
 	vb->nz = normal->Z;
 #else
 	Real shadeR, shadeG, shadeB;
-	Real shade;
 	shadeR = TheGlobalData->m_terrainAmbient[0].red;	//only the first terrain light contributes to ambient
 	shadeG = TheGlobalData->m_terrainAmbient[0].green;
 	shadeB = TheGlobalData->m_terrainAmbient[0].blue;
@@ -517,61 +600,61 @@ void BaseHeightMapRenderObjClass::doTheLight(VERTEX_FORMAT *vb, Vector3*light, V
 	if (pLightsIterator) {
 		for (pLightsIterator->First(); !pLightsIterator->Is_Done(); pLightsIterator->Next())
 		{
-			LightClass *pLight = (LightClass*)pLightsIterator->Peek_Obj();
-			Vector3 lightDirection(vb->x, vb->y, vb->z);
-			Real factor = 1.0f;
-			switch(pLight->Get_Type()) {
-			case LightClass::POINT:
-			case LightClass::SPOT: {
-					Vector3 lightLoc = pLight->Get_Position();
-					lightDirection -= lightLoc;
-					double range, midRange;
-					pLight->Get_Far_Attenuation_Range(midRange, range);
-					if (vb->x < lightLoc.X-range) continue;
-					if (vb->x > lightLoc.X+range) continue;
-					if (vb->y < lightLoc.Y-range) continue;
-					if (vb->y > lightLoc.Y+range) continue;
-					Real dist = lightDirection.Length();
-					if (dist >= range) continue;
-					if (midRange < 0.1) continue;
-#if 1
-					factor = 1.0f - (dist - midRange) / (range - midRange);
-#else
-					// f = 1.0 / (atten0 + d*atten1 + d*d/atten2);
-					if (fabs(range-midRange)<1e-5)	{
-						// if the attenuation range is too small assume uniform with cutoff
-						factor = 1.0;
-					}	else  {
-						factor = 1.0f/(0.1+dist/midRange + 5.0f*dist*dist/(range*range));
-					}
+			TerrainStaticLight staticLight;
+			getTerrainStaticLight((LightClass*)pLightsIterator->Peek_Obj(), &staticLight);
+			addTheLight(vb, normal, &staticLight, shadeR, shadeG, shadeB);
+		}
+	}
+
+	finishTheLight(vb, light, normal, shadeR, shadeG, shadeB, alpha);
 #endif
-					factor = WWMath::Clamp(factor,0.0f,1.0f);
-				}
-				break;
-			case LightClass::DIRECTIONAL:
-				lightDirection = pLight->Get_Transform().Get_Z_Vector();
-				factor = 1.0;
-				break;
-			};
-			lightDirection.Normalize();
-			Vector3 lightRay(-lightDirection.X, -lightDirection.Y, -lightDirection.Z);
-			shade = Vector3::Dot_Product(lightRay, *normal);
-			shade *= factor;
-			Vector3 diffuse;
-			pLight->Get_Diffuse(&diffuse);
-			Vector3 ambient;
-			pLight->Get_Ambient(&ambient);
-			if (shade > 1.0) shade = 1.0;
-			if(shade < 0.0f) shade = 0.0f;
-			shadeR += shade*diffuse.X;
-			shadeG += shade*diffuse.Y;
-			shadeB += shade*diffuse.Z;
-			shadeR += factor*ambient.X;
-			shadeG += factor*ambient.Y;
-			shadeB += factor*ambient.Z;
+}
+
+//=============================================================================
+// BaseHeightMapRenderObjClass::doTheLight4
+//=============================================================================
+/** Same as above for the 4 vertices of a cell, but takes copies of the static
+lights, so it can run on worker threads. The caller can leave out lights that
+cannot reach the cell, which is a lot cheaper than walking the whole light list
+of the scene for every vertex. */
+//=============================================================================
+void BaseHeightMapRenderObjClass::doTheLight4(VERTEX_FORMAT *vb, Vector3*light, const Vector3 *normals, const TerrainStaticLight *pLights, Int numLights, const UnsignedByte *alpha)
+{
+#ifdef USE_NORMALS
+	for (Int v=0; v<4; v++)
+	{
+		vb[v].nx = normals[v].X;
+		vb[v].ny = normals[v].Y;
+		vb[v].nz = normals[v].Z;
+	}
+#else
+	Real shadeR[4], shadeG[4], shadeB[4];
+	for (Int v=0; v<4; v++)
+	{
+		shadeR[v] = TheGlobalData->m_terrainAmbient[0].red;	//only the first terrain light contributes to ambient
+		shadeG[v] = TheGlobalData->m_terrainAmbient[0].green;
+		shadeB[v] = TheGlobalData->m_terrainAmbient[0].blue;
 
+		for (Int k=0; k<numLights; k++)
+		{
+			addTheLight(&vb[v], &normals[v], &pLights[k], shadeR[v], shadeG[v], shadeB[v]);
 		}
 	}
+
+	finishTheLight4(vb, light, normals, shadeR, shadeG, shadeB, alpha);
+#endif
+}
+
+//=============================================================================
+// BaseHeightMapRenderObjClass::finishTheLight
+//=============================================================================
+/** Adds the global terrain lights to the given static lighting and writes the
+final diffuse color into the vertex. */
+//=============================================================================
+void BaseHeightMapRenderObjClass::finishTheLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, Real shadeR, Real shadeG, Real shadeB, UnsignedByte alpha)
+{
+#ifndef USE_NORMALS
+	Real shade;
 	// Add in global diffuse value.
 	const RGBColor *terrainDiffuse;
 	for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
@@ -608,6 +691,123 @@ void BaseHeightMapRenderObjClass::doTheLight(VERTEX_FORMAT *vb, Vector3*light, V
 #endif
 }
 
+//=============================================================================
+// BaseHeightMapRenderObjClass::finishTheLight4
+//=============================================================================
+/** Same as finishTheLight for the 4 vertices of a cell. */
+//=============================================================================
+void BaseHeightMapRenderObjClass::finishTheLight4(VERTEX_FORMAT *vb, Vector3*light, const Vector3 *normals, const Real *shadeR, const Real *shadeG, const Real *shadeB, const UnsignedByte *alpha)
+{
+#ifndef USE_NORMALS
+#if defined(HEIGHTMAP_LIGHT_SSE2)
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 nx = _mm_setr_ps(normals[0].X, normals[1].X, normals[2].X, normals[3].X);
+	const __m128 ny = _mm_setr_ps(normals[0].Y, normals[1].Y, normals[2].Y, normals[3].Y);
+	const __m128 nz = _mm_setr_ps(normals[0].Z, normals[1].Z, normals[2].Z, normals[3].Z);
+	__m128 r = _mm_loadu_ps(shadeR);
+	__m128 g = _mm_loadu_ps(shadeG);
+	__m128 b = _mm_loadu_ps(shadeB);
+	__m128 mask;
+
+	// Add in global diffuse value.
+	for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
+	{
+		__m128 shade = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(light[lightIndex].X), nx),
+			_mm_mul_ps(_mm_set1_ps(light[lightIndex].Y), ny)), _mm_mul_ps(_mm_set1_ps(light[lightIndex].Z), nz));
+		mask = _mm_cmpgt_ps(shade, one);
+		shade = _mm_or_ps(_mm_and_ps(mask, one), _mm_andnot_ps(mask, shade));
+		shade = _mm_andnot_ps(_mm_cmplt_ps(shade, zero), shade);
+		const RGBColor *terrainDiffuse = &TheGlobalData->m_terrainDiffuse[lightIndex];
+		r = _mm_add_ps(r, _mm_mul_ps(shade, _mm_set1_ps(terrainDiffuse->red)));
+		g = _mm_add_ps(g, _mm_mul_ps(shade, _mm_set1_ps(terrainDiffuse->green)));
+		b = _mm_add_ps(b, _mm_mul_ps(shade, _mm_set1_ps(terrainDiffuse->blue)));
+	}
+
+	mask = _mm_cmpgt_ps(r, one);
+	r = _mm_andnot_ps(_mm_cmplt_ps(r, zero), _mm_or_ps(_mm_and_ps(mask, one), _mm_andnot_ps(mask, r)));
+	mask = _mm_cmpgt_ps(g, one);
+	g = _mm_andnot_ps(_mm_cmplt_ps(g, zero), _mm_or_ps(_mm_and_ps(mask, one), _mm_andnot_ps(mask, g)));
+	mask = _mm_cmpgt_ps(b, one);
+	b = _mm_andnot_ps(_mm_cmplt_ps(b, zero), _mm_or_ps(_mm_and_ps(mask, one), _mm_andnot_ps(mask, b)));
+
+	if (m_useDepthFade)
+	{	//reduce lighting values below water level based on light fall off as it travels through water.
+		const __m128 z = _mm_setr_ps(vb[0].z, vb[1].z, vb[2].z, vb[3].z);
+		const __m128 waterZ = _mm_set1_ps(TheGlobalData->m_waterPositionZ);
+		const __m128 depthScale = _mm_div_ps(_mm_sub_ps(_mm_set1_ps(1.4f), z), waterZ);
+		mask = _mm_cmple_ps(z, waterZ);
+		const __m128 fadeR = _mm_sub_ps(one, _mm_mul_ps(depthScale, _mm_set1_ps(1.0f-m_depthFade.X)));
+		const __m128 fadeG = _mm_sub_ps(one, _mm_mul_ps(depthScale, _mm_set1_ps(1.0f-m_depthFade.Y)));
+		const __m128 fadeB = _mm_sub_ps(one, _mm_mul_ps(depthScale, _mm_set1_ps(1.0f-m_depthFade.Z)));
+		r = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(r, fadeR)), _mm_andnot_ps(mask, r));
+		g = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(g, fadeG)), _mm_andnot_ps(mask, g));
+		b = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(b, fadeB)), _mm_andnot_ps(mask, b));
+	}
+
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128i color = _mm_or_si128(_mm_or_si128(_mm_cvttps_epi32(_mm_mul_ps(b, scale)),
+		_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(g, scale)), 8)), _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(r, scale)), 16));
+	Int diffuse[4];
+	_mm_storeu_si128((__m128i *)diffuse, color);
+	for (Int v=0; v<4; v++)
+		vb[v].diffuse = diffuse[v] | ((Int)alpha[v] << 24);
+#elif defined(HEIGHTMAP_LIGHT_NEON)
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float nxValues[4] = { normals[0].X, normals[1].X, normals[2].X, normals[3].X };
+	const float nyValues[4] = { normals[0].Y, normals[1].Y, normals[2].Y, normals[3].Y };
+	const float nzValues[4] = { normals[0].Z, normals[1].Z, normals[2].Z, normals[3].Z };
+	const float32x4_t nx = vld1q_f32(nxValues);
+	const float32x4_t ny = vld1q_f32(nyValues);
+	const float32x4_t nz = vld1q_f32(nzValues);
+	float32x4_t r = vld1q_f32(shadeR);
+	float32x4_t g = vld1q_f32(shadeG);
+	float32x4_t b = vld1q_f32(shadeB);
+
+	// Add in global diffuse value.
+	for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
+	{
+		float32x4_t shade = vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(light[lightIndex].X), nx),
+			vmulq_f32(vdupq_n_f32(light[lightIndex].Y), ny)), vmulq_f32(vdupq_n_f32(light[lightIndex].Z), nz));
+		shade = vbslq_f32(vcgtq_f32(shade, one), one, shade);
+		shade = vbslq_f32(vcltq_f32(shade, zero), zero, shade);
+		const RGBColor *terrainDiffuse = &TheGlobalData->m_terrainDiffuse[lightIndex];
+		r = vaddq_f32(r, vmulq_f32(shade, vdupq_n_f32(terrainDiffuse->red)));
+		g = vaddq_f32(g, vmulq_f32(shade, vdupq_n_f32(terrainDiffuse->green)));
+		b = vaddq_f32(b, vmulq_f32(shade, vdupq_n_f32(terrainDiffuse->blue)));
+	}
+
+	r = vbslq_f32(vcltq_f32(r, zero), zero, vbslq_f32(vcgtq_f32(r, one), one, r));
+	g = vbslq_f32(vcltq_f32(g, zero), zero, vbslq_f32(vcgtq_f32(g, one), one, g));
+	b = vbslq_f32(vcltq_f32(b, zero), zero, vbslq_f32(vcgtq_f32(b, one), one, b));
+
+	if (m_useDepthFade)
+	{	//reduce lighting values below water level based on light fall off as it travels through water.
+		const float zValues[4] = { vb[0].z, vb[1].z, vb[2].z, vb[3].z };
+		const float32x4_t z = vld1q_f32(zValues);
+		const float32x4_t waterZ = vdupq_n_f32(TheGlobalData->m_waterPositionZ);
+		const float32x4_t depthScale = vdivq_f32(vsubq_f32(vdupq_n_f32(1.4f), z), waterZ);
+		const uint32x4_t mask = vcleq_f32(z, waterZ);
+		r = vbslq_f32(mask, vmulq_f32(r, vsubq_f32(one, vmulq_f32(depthScale, vdupq_n_f32(1.0f-m_depthFade.X)))), r);
+		g = vbslq_f32(mask, vmulq_f32(g, vsubq_f32(one, vmulq_f32(depthScale, vdupq_n_f32(1.0f-m_depthFade.Y)))), g);
+		b = vbslq_f32(mask, vmulq_f32(b, vsubq_f32(one, vmulq_f32(depthScale, vdupq_n_f32(1.0f-m_depthFade.Z)))), b);
+	}
+
+	const float32x4_t scale = vdupq_n_f32(255.0f);
+	const int32x4_t color = vorrq_s32(vorrq_s32(vcvtq_s32_f32(vmulq_f32(b, scale)),
+		vshlq_n_s32(vcvtq_s32_f32(vmulq_f32(g, scale)), 8)), vshlq_n_s32(vcvtq_s32_f32(vmulq_f32(r, scale)), 16));
+	Int diffuse[4];
+	vst1q_s32(diffuse, color);
+	for (Int v=0; v<4; v++)
+		vb[v].diffuse = diffuse[v] | ((Int)alpha[v] << 24);
+#else
+	for (Int v=0; v<4; v++)
+		finishTheLight(&vb[v], light, (Vector3 *)&normals[v], shadeR[v], shadeG[v], shadeB[v], alpha[v]);
+#endif
+#endif
+}
+
 //=============================================================================
 // BaseHeightMapRenderObjClass::updateMacroTexture
 //=============================================================================
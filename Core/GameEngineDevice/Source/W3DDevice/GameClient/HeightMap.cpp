@@ -113,6 +113,155 @@ static ShaderClass detailOpaqueShader(SC_DETAIL_BLEND);
 #define ADJUST_FROM_INDEX_TO_REAL(k) ((k-m_map->getBorderSizeInline())*MAP_XY_FACTOR)
 inline Int IABS(Int x) {	if (x>=0) return x; return -x;};
 
+// TheSuperHackers @performance 19/10/2026 Vertex buffer updates are split into bands of rows, which
+// worker threads build in parallel. Each band writes its own cells of the buffers, so the bands need
+// no locking between them.
+#if defined(_MSC_VER) && _MSC_VER < 1300
+#define HEIGHTMAP_UPDATE_SYNCHRONOUS
+#else
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#define VB_UPDATE_ROWS_PER_BAND		4		///< rows of cells that one worker builds at a time
+#define VB_UPDATE_MIN_PARALLEL_CELLS	128	///< smaller updates are built on the calling thread
+
+typedef void (*HeightMapUpdateJob)(void *context, Int index);
+
+#ifndef HEIGHTMAP_UPDATE_SYNCHRONOUS
+enum { MAX_HEIGHTMAP_UPDATE_WORKERS = 3 };
+
+static std::mutex s_updateMutex;
+static std::condition_variable s_updateStart;	///< signals the workers that a new job or quit is set
+static std::condition_variable s_updateDone;	///< signals the caller that all workers are done
+static std::thread s_updateWorkers[MAX_HEIGHTMAP_UPDATE_WORKERS];
+static Int s_numUpdateWorkers = 0;
+static Bool s_updateWorkersStarted = FALSE;
+static Bool s_updateQuit = FALSE;
+static UnsignedInt s_updateGeneration = 0;	///< counts up for every job, so the workers see each job once
+static HeightMapUpdateJob s_updateJob = nullptr;
+static void *s_updateContext = nullptr;
+static Int s_updateCount = 0;
+static Int s_busyUpdateWorkers = 0;
+static std::atomic<Int> s_nextUpdateIndex(0);
+
+//-------------------------------------------------------------------------------------------------
+static void runUpdateJob( HeightMapUpdateJob job, void *context, Int count )
+{
+	for (Int index = s_nextUpdateIndex++; index < count; index = s_nextUpdateIndex++)
+	{
+		job( context, index );
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static void updateWorkerFunction( UnsignedInt generation )
+{
+	std::unique_lock<std::mutex> lock( s_updateMutex );
+	for (;;)
+	{
+		s_updateStart.wait( lock, [generation] { return s_updateQuit || s_updateGeneration != generation; } );
+		if (s_updateQuit)
+			break;
+
+		generation = s_updateGeneration;
+		HeightMapUpdateJob job = s_updateJob;
+		void *context = s_updateContext;
+		Int count = s_updateCount;
+		lock.unlock();
+		runUpdateJob( job, context, count );
+		lock.lock();
+
+		if (--s_busyUpdateWorkers == 0)
+			s_updateDone.notify_all();
+	}
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+/** Calls the job for every index from 0 to count-1, on the worker threads and the calling thread.
+	* Returns when all indices are done. */
+//-------------------------------------------------------------------------------------------------
+static void runHeightMapUpdateJob( HeightMapUpdateJob job, void *context, Int count )
+{
+#ifndef HEIGHTMAP_UPDATE_SYNCHRONOUS
+	if (count > 1)
+	{
+		std::unique_lock<std::mutex> lock( s_updateMutex );
+		if (!s_updateWorkersStarted)
+		{
+			s_updateWorkersStarted = TRUE;
+			Int numWorkers = (Int)std::thread::hardware_concurrency() - 1;
+			if (numWorkers > MAX_HEIGHTMAP_UPDATE_WORKERS)
+				numWorkers = MAX_HEIGHTMAP_UPDATE_WORKERS;
+			for (s_numUpdateWorkers = 0; s_numUpdateWorkers < numWorkers; ++s_numUpdateWorkers)
+			{
+				s_updateWorkers[s_numUpdateWorkers] = std::thread( updateWorkerFunction, s_updateGeneration );
+			}
+		}
+
+		if (s_numUpdateWorkers > 0)
+		{
+			s_updateJob = job;
+			s_updateContext = context;
+			s_updateCount = count;
+			s_nextUpdateIndex = 0;
+			s_busyUpdateWorkers = s_numUpdateWorkers;
+			++s_updateGeneration;
+			s_updateStart.notify_all();
+			lock.unlock();
+
+			runUpdateJob( job, context, count );
+
+			lock.lock();
+			s_updateDone.wait( lock, [] { return s_busyUpdateWorkers == 0; } );
+			return;
+		}
+	}
+#endif
+
+	for (Int index = 0; index < count; ++index)
+	{
+		job( context, index );
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static void stopHeightMapUpdateWorkers( void )
+{
+#ifndef HEIGHTMAP_UPDATE_SYNCHRONOUS
+	{
+		std::unique_lock<std::mutex> lock( s_updateMutex );
+		s_updateQuit = TRUE;
+		s_updateStart.notify_all();
+	}
+	for (Int i = 0; i < s_numUpdateWorkers; ++i)
+	{
+		s_updateWorkers[i].join();
+	}
+	s_numUpdateWorkers = 0;
+	s_updateWorkersStarted = FALSE;
+	s_updateQuit = FALSE;
+#endif
+}
+
+/// The data that all bands of one vertex buffer update share.
+struct HeightMapRenderObjClass::VBRowsUpdate
+{
+	VERTEX_FORMAT *vbHardware;	///< locked hardware vertex buffer
+	VERTEX_FORMAT *data;				///< in memory copy of the vertex buffer
+	Int x0, y0, x1, y1;
+	Int originX, originY;
+	WorldHeightMap *pMap;
+	Vector3 lightRay[MAX_GLOBAL_LIGHTS];
+	const TerrainStaticLight *blockLights;
+	Int numBlockLights;
+	TerrainStaticLight *bandLights;	///< room for numBlockLights lights per band
+	HeightMapRenderObjClass *heightMap;
+};
+
 //-----------------------------------------------------------------------------
 //         Private Functions
 //-----------------------------------------------------------------------------
@@ -304,14 +453,7 @@ mapped into this VB.
 //=============================================================================
 Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, VERTEX_FORMAT *data, Int x0, Int y0, Int x1, Int y1, Int originX, Int originY, WorldHeightMap *pMap, RefRenderObjListIterator *pLightsIterator)
 {
-	Int i,j;
-	Vector3 lightRay[MAX_GLOBAL_LIGHTS];
 	const Coord3D *lightPos;
-	Int xCoord, yCoord;
-	Int vn0,un0,vp1,up1;
-	Vector3 l2r,n2f,normalAtTexel;
-	constexpr const Int vertsPerRow=(VERTEX_BUFFER_TILE_LENGTH)*4;	//vertices per row of VB
-	constexpr const Int cellOffset = 1;
 
 	REF_PTR_SET(m_map, pMap);	//update our heightmap pointer in case it changed since last call.
 	if (m_vertexBufferTiles && pMap)
@@ -321,224 +463,322 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, VERTEX_FORMAT *
 #endif
 
 		DX8VertexBufferClass::WriteLockClass lockVtxBuffer(pVB);
-		VERTEX_FORMAT *vbHardware = (VERTEX_FORMAT*)lockVtxBuffer.Get_Vertex_Array();
-		VERTEX_FORMAT *vBase = data;
+		VBRowsUpdate update;
+		update.vbHardware = (VERTEX_FORMAT*)lockVtxBuffer.Get_Vertex_Array();
 		// Note that we are building the vertex buffer data in the memory buffer, data.
 		// At the bottom, we will copy the final vertex data for one cell into the
 		// hardware vertex buffer.
+		update.data = data;
+		update.x0 = x0;
+		update.y0 = y0;
+		update.x1 = x1;
+		update.y1 = y1;
+		update.originX = originX;
+		update.originY = originY;
+		update.pMap = pMap;
+		update.heightMap = this;
+
+		for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
+		{
+			lightPos=&TheGlobalData->m_terrainLightPos[lightIndex];
+			update.lightRay[lightIndex].Set(-lightPos->x,-lightPos->y,	-lightPos->z);
+		}
 
-		for (j=y0; j<y1; j++)
+		// TheSuperHackers @performance 19/10/2026 Copies the static lights once per block instead
+		// of walking the light list of the scene for every vertex. Each row then only passes on the
+		// lights that can reach it. The lights keep their order, so the lighting stays identical.
+		// The worker threads only read the copies, never the lights of the scene.
+		std::vector<TerrainStaticLight> blockLights;
+		if (pLightsIterator)
 		{
-			VERTEX_FORMAT *vb = vBase;
-			vb += (j-originY)*vertsPerRow;	//skip to correct row in vertex buffer
-			vb += (x0-originX)*4;		//skip to correct vertex in row.
+			for (pLightsIterator->First(); !pLightsIterator->Is_Done(); pLightsIterator->Next())
+			{
+				TerrainStaticLight staticLight;
+				getTerrainStaticLight((LightClass*)pLightsIterator->Peek_Obj(), &staticLight);
+				blockLights.push_back(staticLight);
+			}
+		}
 
-			const Int mapY = getYWithOrigin(j);
-			vn0 = mapY-cellOffset;
-			if (vn0 < -pMap->getDrawOrgY())
-				vn0=-pMap->getDrawOrgY();
-			vp1 = getYWithOrigin(j+cellOffset)+cellOffset;
-			if (vp1 >= pMap->getYExtent()-pMap->getDrawOrgY())
-				vp1=pMap->getYExtent()-pMap->getDrawOrgY()-1;
-
-			yCoord = mapY+pMap->getDrawOrgY();
-			for (i=x0; i<x1; i++)
+		Int numBands = 1;
+		if ((x1-x0)*(y1-y0) >= VB_UPDATE_MIN_PARALLEL_CELLS)
+		{
+			numBands = (y1-y0+VB_UPDATE_ROWS_PER_BAND-1)/VB_UPDATE_ROWS_PER_BAND;
+		}
+
+		std::vector<TerrainStaticLight> bandLights(blockLights.size()*numBands);
+		update.blockLights = blockLights.empty() ? nullptr : &blockLights[0];
+		update.numBlockLights = (Int)blockLights.size();
+		update.bandLights = bandLights.empty() ? nullptr : &bandLights[0];
+
+		if (numBands == 1)
+		{
+			updateVBRows(update, update.bandLights, y0, y1);
+		}
+		else
+		{
+			runHeightMapUpdateJob(updateVBBand, &update, numBands);
+		}
+		return 0; //success.
+	}
+	return -1;
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::updateVBBand
+//=============================================================================
+/** Updates one band of rows of a vertex buffer update. Called on the worker threads. */
+//=============================================================================
+void HeightMapRenderObjClass::updateVBBand(void *context, Int band)
+{
+	const VBRowsUpdate &update = *(const VBRowsUpdate *)context;
+	const Int y0 = update.y0 + band*VB_UPDATE_ROWS_PER_BAND;
+	Int y1 = y0 + VB_UPDATE_ROWS_PER_BAND;
+	if (y1 > update.y1)
+		y1 = update.y1;
+	update.heightMap->updateVBRows(update, update.bandLights + band*update.numBlockLights, y0, y1);
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::updateVBRows
+//=============================================================================
+/** Updates the rows y0 to y1 of a vertex buffer update. rowLights must have room
+for all static lights of the update. */
+//=============================================================================
+void HeightMapRenderObjClass::updateVBRows(const VBRowsUpdate &update, TerrainStaticLight *rowLights, Int y0, Int y1)
+{
+	Int i,j;
+	Int xCoord, yCoord;
+	Int vn0,un0,vp1,up1;
+	Vector3 l2r,n2f;
+	constexpr const Int vertsPerRow=(VERTEX_BUFFER_TILE_LENGTH)*4;	//vertices per row of VB
+	constexpr const Int cellOffset = 1;
+	const Int x0 = update.x0;
+	const Int x1 = update.x1;
+	WorldHeightMap *pMap = update.pMap;
+	VERTEX_FORMAT *vbHardware = update.vbHardware;
+	VERTEX_FORMAT *vBase = update.data;
+	Vector3 lightRay[MAX_GLOBAL_LIGHTS];
+	memcpy(lightRay, update.lightRay, sizeof(lightRay));
+
+	for (j=y0; j<y1; j++)
+	{
+		VERTEX_FORMAT *vb = vBase;
+		vb += (j-update.originY)*vertsPerRow;	//skip to correct row in vertex buffer
+		vb += (x0-update.originX)*4;		//skip to correct vertex in row.
+
+		const Int mapY = getYWithOrigin(j);
+		vn0 = mapY-cellOffset;
+		if (vn0 < -pMap->getDrawOrgY())
+			vn0=-pMap->getDrawOrgY();
+		vp1 = getYWithOrigin(j+cellOffset)+cellOffset;
+		if (vp1 >= pMap->getYExtent()-pMap->getDrawOrgY())
+			vp1=pMap->getYExtent()-pMap->getDrawOrgY()-1;
+
+		yCoord = mapY+pMap->getDrawOrgY();
+
+		// All vertices of this row are between yCoord and yCoord+1. Keep a cell of slack.
+		const Real rowMinY = ADJUST_FROM_INDEX_TO_REAL((Real)yCoord) - MAP_XY_FACTOR;
+		const Real rowMaxY = ADJUST_FROM_INDEX_TO_REAL((Real)(yCoord+cellOffset)) + MAP_XY_FACTOR;
+		Int numRowLights = 0;
+		for (Int lightIndex=0; lightIndex < update.numBlockLights; lightIndex++)
+		{
+			const TerrainStaticLight &light = update.blockLights[lightIndex];
+			if (light.type == LightClass::POINT || light.type == LightClass::SPOT)
 			{
-				const Int mapX = getXWithOrigin(i);
-				un0 = mapX-cellOffset;
-				if (un0 < -pMap->getDrawOrgX())
-					un0=-pMap->getDrawOrgX();
-				up1 = getXWithOrigin(i+cellOffset)+cellOffset;
-				if (up1 >= pMap->getXExtent()-pMap->getDrawOrgX())
-					up1=pMap->getXExtent()-pMap->getDrawOrgX()-1;
-				xCoord = mapX+pMap->getDrawOrgX();
-
-				//update the 4 vertices in this block
-				float U[4], V[4];
-				UnsignedByte alpha[4];
-				float UA[4], VA[4];
-				Bool flipForBlend = false;			 // True if the blend needs the triangles flipped.
-
-				pMap->getUVData(mapX, mapY, U, V);
-				pMap->getAlphaUVData(mapX, mapY, UA, VA, alpha, &flipForBlend);
-
-				for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
-				{
-					lightPos=&TheGlobalData->m_terrainLightPos[lightIndex];
-					lightRay[lightIndex].Set(-lightPos->x,-lightPos->y,	-lightPos->z);
-				}
+				if (rowMaxY < light.position.Y-light.range || rowMinY > light.position.Y+light.range)
+					continue;
+			}
+			rowLights[numRowLights++] = light;
+		}
+		const TerrainStaticLight *pRowLights = rowLights;
 
-				//top-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset, mapY) - pMap->getDisplayHeight(un0, mapY)));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX, (mapY+cellOffset)) - pMap->getDisplayHeight(mapX, vn0)));
+		for (i=x0; i<x1; i++)
+		{
+			const Int mapX = getXWithOrigin(i);
+			un0 = mapX-cellOffset;
+			if (un0 < -pMap->getDrawOrgX())
+				un0=-pMap->getDrawOrgX();
+			up1 = getXWithOrigin(i+cellOffset)+cellOffset;
+			if (up1 >= pMap->getXExtent()-pMap->getDrawOrgX())
+				up1=pMap->getXExtent()-pMap->getDrawOrgX()-1;
+			xCoord = mapX+pMap->getDrawOrgX();
+
+			//update the 4 vertices in this block
+			float U[4], V[4];
+			UnsignedByte alpha[4];
+			float UA[4], VA[4];
+			Bool flipForBlend = false;			 // True if the blend needs the triangles flipped.
+			Vector3 normals[4];
+
+			pMap->getUVData(mapX, mapY, U, V);
+			pMap->getAlphaUVData(mapX, mapY, UA, VA, alpha, &flipForBlend);
+
+			//top-left sample
+			l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset, mapY) - pMap->getDisplayHeight(un0, mapY)));
+			n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX, (mapY+cellOffset)) - pMap->getDisplayHeight(mapX, vn0)));
 
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+			normals[0]= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+			Vector3::Normalized_Cross_Product(l2r, n2f, &normals[0]);
 #endif
 
-				vb->x=xCoord;
-				vb->y=yCoord;
-				vb->z=  ((float)pMap->getDisplayHeight(mapX, mapY))*MAP_HEIGHT_SCALE;
-				vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
-				vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
-				vb->u1=U[0];
-				vb->v1=V[0];
-				vb->u2=UA[0];
-				vb->v2=VA[0];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[0]);
-				vb++;
-
-				//top-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , mapY ) - pMap->getDisplayHeight(mapX , mapY )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , (mapY+cellOffset) ) - pMap->getDisplayHeight(mapX+cellOffset , vn0 )));
+			vb->x=xCoord;
+			vb->y=yCoord;
+			vb->z=  ((float)pMap->getDisplayHeight(mapX, mapY))*MAP_HEIGHT_SCALE;
+			vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
+			vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
+			vb->u1=U[0];
+			vb->v1=V[0];
+			vb->u2=UA[0];
+			vb->v2=VA[0];
+			vb++;
+
+			//top-right sample
+			l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , mapY ) - pMap->getDisplayHeight(mapX , mapY )));
+			n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , (mapY+cellOffset) ) - pMap->getDisplayHeight(mapX+cellOffset , vn0 )));
 
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+			normals[1]= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+			Vector3::Normalized_Cross_Product(l2r, n2f, &normals[1]);
 #endif
 
-				vb->x=xCoord+cellOffset;
-				vb->y=yCoord;
-				vb->z=  ((float)pMap->getDisplayHeight(mapX+cellOffset, mapY))*MAP_HEIGHT_SCALE;
-				vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
-				vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
-				vb->u1=U[1];
-				vb->v1=V[1];
-				vb->u2=UA[1];
-				vb->v2=VA[1];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[1]);
-				vb++;
-
-				//bottom-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (mapY+cellOffset) ) - pMap->getDisplayHeight(mapX , (mapY+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , vp1 ) - pMap->getDisplayHeight(mapX+cellOffset , mapY )));
+			vb->x=xCoord+cellOffset;
+			vb->y=yCoord;
+			vb->z=  ((float)pMap->getDisplayHeight(mapX+cellOffset, mapY))*MAP_HEIGHT_SCALE;
+			vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
+			vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
+			vb->u1=U[1];
+			vb->v1=V[1];
+			vb->u2=UA[1];
+			vb->v2=VA[1];
+			vb++;
+
+			//bottom-right sample
+			l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (mapY+cellOffset) ) - pMap->getDisplayHeight(mapX , (mapY+cellOffset) )));
+			n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , vp1 ) - pMap->getDisplayHeight(mapX+cellOffset , mapY )));
 
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+			normals[2]= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+			Vector3::Normalized_Cross_Product(l2r, n2f, &normals[2]);
 #endif
 
-				vb->x=xCoord+cellOffset;
-				if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
-					vb->y=yCoord+1;
-				} else {
-					vb->y=yCoord+cellOffset;
-				}
-				vb->z=  ((float)pMap->getDisplayHeight(mapX+cellOffset, mapY+cellOffset))*MAP_HEIGHT_SCALE;
-				vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
-				vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
-				vb->u1=U[2];
-				vb->v1=V[2];
-				vb->u2=UA[2];
-				vb->v2=VA[2];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[2]);
-				vb++;
-
-				//bottom-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , (mapY+cellOffset) ) - pMap->getDisplayHeight(un0 , (mapY+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX , vp1 ) - pMap->getDisplayHeight(mapX , mapY )));
+			vb->x=xCoord+cellOffset;
+			if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
+				vb->y=yCoord+1;
+			} else {
+				vb->y=yCoord+cellOffset;
+			}
+			vb->z=  ((float)pMap->getDisplayHeight(mapX+cellOffset, mapY+cellOffset))*MAP_HEIGHT_SCALE;
+			vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
+			vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
+			vb->u1=U[2];
+			vb->v1=V[2];
+			vb->u2=UA[2];
+			vb->v2=VA[2];
+			vb++;
+
+			//bottom-left sample
+			l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX+cellOffset , (mapY+cellOffset) ) - pMap->getDisplayHeight(un0 , (mapY+cellOffset) )));
+			n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(mapX , vp1 ) - pMap->getDisplayHeight(mapX , mapY )));
 
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+			normals[3]= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+			Vector3::Normalized_Cross_Product(l2r, n2f, &normals[3]);
 #endif
 
-				if (xCoord == pMap->getDrawOrgX()) {
-					vb->x=xCoord;
-					//if (vb->x < 0) vb->x = 0;
-				} else {
-					vb->x=xCoord;
-				}
-				if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
-					vb->y=yCoord+1;
-				} else {
-					vb->y=yCoord+cellOffset;
-				}
-				vb->z=  ((float)pMap->getDisplayHeight(mapX, mapY+cellOffset))*MAP_HEIGHT_SCALE;
-				vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
-				vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
-				vb->u1=U[3];
-				vb->v1=V[3];
-				vb->u2=UA[3];
-				vb->v2=VA[3];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[3]);
-				vb++;
-
-				VERTEX_FORMAT *pCurVertices = vb-4;
+			if (xCoord == pMap->getDrawOrgX()) {
+				vb->x=xCoord;
+				//if (vb->x < 0) vb->x = 0;
+			} else {
+				vb->x=xCoord;
+			}
+			if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
+				vb->y=yCoord+1;
+			} else {
+				vb->y=yCoord+cellOffset;
+			}
+			vb->z=  ((float)pMap->getDisplayHeight(mapX, mapY+cellOffset))*MAP_HEIGHT_SCALE;
+			vb->x = ADJUST_FROM_INDEX_TO_REAL(vb->x);
+			vb->y = ADJUST_FROM_INDEX_TO_REAL(vb->y);
+			vb->u1=U[3];
+			vb->v1=V[3];
+			vb->u2=UA[3];
+			vb->v2=VA[3];
+			vb++;
+
+			VERTEX_FORMAT *pCurVertices = vb-4;
+			doTheLight4(pCurVertices, lightRay, normals, pRowLights, numRowLights, alpha);
 #ifdef FLIP_TRIANGLES // jba - reduces "diamonding" in some cases, not others.  Better cliffs, though.
-				VERTEX_FORMAT tmpVertex;
-				if (flipForBlend) {
-					tmpVertex = pCurVertices[0];
-					pCurVertices[0] = pCurVertices[1];
-					pCurVertices[1] = pCurVertices[2];
-					pCurVertices[2] = pCurVertices[3];
-					pCurVertices[3] = tmpVertex;
-				}
+			VERTEX_FORMAT tmpVertex;
+			if (flipForBlend) {
+				tmpVertex = pCurVertices[0];
+				pCurVertices[0] = pCurVertices[1];
+				pCurVertices[1] = pCurVertices[2];
+				pCurVertices[2] = pCurVertices[3];
+				pCurVertices[3] = tmpVertex;
+			}
 #endif
 
-				if (m_showImpassableAreas) {
-					// Color impassable cells "red"
-					DEBUG_ASSERTCRASH(PATHFIND_CELL_SIZE_F == MAP_XY_FACTOR, ("Pathfind must be terrain cell size, or this code needs reworking.  John A."));
-					Real borderHiX = (pMap->getXExtent()-2*pMap->getBorderSizeInline())*MAP_XY_FACTOR;
-					Real borderHiY = (pMap->getYExtent()-2*pMap->getBorderSizeInline())*MAP_XY_FACTOR;
-					Bool border = pCurVertices[0].x == -MAP_XY_FACTOR || pCurVertices[0].y == -MAP_XY_FACTOR;
-					Bool cliffMapped = pMap->isCliffMappedTexture(mapX, mapY);
-					if (pCurVertices[0].x == borderHiX) {
-						border = true;
-					}
-					if (pCurVertices[0].y == borderHiY) {
-						border = true;
-					}
-					Bool isCliff = pMap->getCliffState(xCoord, yCoord) || showAsVisibleCliff(xCoord, yCoord);
-
-					if ( isCliff || border || cliffMapped) {
-						Int cellX, cellY;
-						for (cellX=0; cellX<2; cellX++) {
-							for (cellY=0; cellY<2; cellY++) {
-								Int vertex = cellX+2*cellY;
-								if (border) {
-									Bool doBorder = false;
-									if (pCurVertices[vertex].y >= 0 && pCurVertices[vertex].y <= borderHiY) {
-										if (pCurVertices[vertex].x == 0 || pCurVertices[vertex].x == borderHiX) {
-											doBorder = true;
-										}
-									}
-									if (pCurVertices[vertex].x >= 0 && pCurVertices[vertex].x <= borderHiX) {
-										if (pCurVertices[vertex].y == 0 || pCurVertices[vertex].y == borderHiY) {
-											doBorder = true;
-										}
+			if (m_showImpassableAreas) {
+				// Color impassable cells "red"
+				DEBUG_ASSERTCRASH(PATHFIND_CELL_SIZE_F == MAP_XY_FACTOR, ("Pathfind must be terrain cell size, or this code needs reworking.  John A."));
+				Real borderHiX = (pMap->getXExtent()-2*pMap->getBorderSizeInline())*MAP_XY_FACTOR;
+				Real borderHiY = (pMap->getYExtent()-2*pMap->getBorderSizeInline())*MAP_XY_FACTOR;
+				Bool border = pCurVertices[0].x == -MAP_XY_FACTOR || pCurVertices[0].y == -MAP_XY_FACTOR;
+				Bool cliffMapped = pMap->isCliffMappedTexture(mapX, mapY);
+				if (pCurVertices[0].x == borderHiX) {
+					border = true;
+				}
+				if (pCurVertices[0].y == borderHiY) {
+					border = true;
+				}
+				Bool isCliff = pMap->getCliffState(xCoord, yCoord) || showAsVisibleCliff(xCoord, yCoord);
+
+				if ( isCliff || border || cliffMapped) {
+					Int cellX, cellY;
+					for (cellX=0; cellX<2; cellX++) {
+						for (cellY=0; cellY<2; cellY++) {
+							Int vertex = cellX+2*cellY;
+							if (border) {
+								Bool doBorder = false;
+								if (pCurVertices[vertex].y >= 0 && pCurVertices[vertex].y <= borderHiY) {
+									if (pCurVertices[vertex].x == 0 || pCurVertices[vertex].x == borderHiX) {
+										doBorder = true;
 									}
-									if (doBorder) {
-										pCurVertices[vertex].diffuse &= 0xFF0000ff; // blue with alpha.
+								}
+								if (pCurVertices[vertex].x >= 0 && pCurVertices[vertex].x <= borderHiX) {
+									if (pCurVertices[vertex].y == 0 || pCurVertices[vertex].y == borderHiY) {
+										doBorder = true;
 									}
-								} else if (isCliff) {
-									pCurVertices[vertex].diffuse &= 0xFFFF0000; // red with alpha.
 								}
-								if (cliffMapped && vertex==0) {
-									pCurVertices[vertex].diffuse &= 0xFF000000; // Black.
-									pCurVertices[vertex].diffuse |= 0xff00; // Add green.
+								if (doBorder) {
+									pCurVertices[vertex].diffuse &= 0xFF0000ff; // blue with alpha.
 								}
+							} else if (isCliff) {
+								pCurVertices[vertex].diffuse &= 0xFFFF0000; // red with alpha.
+							}
+							if (cliffMapped && vertex==0) {
+								pCurVertices[vertex].diffuse &= 0xFF000000; // Black.
+								pCurVertices[vertex].diffuse |= 0xff00; // Add green.
 							}
 						}
 					}
 				}
-
-				// Note - We have been building the vertex buffer in the memory location.
-				// Now copy the set of vertices into the hardware buffer.
-				// We don't copy the whole vertex buffer because we often update only
-				// a couple of rows and its a lot faster to just copy the ones that change.
-				Int offset = pCurVertices - vBase;
-				memcpy(vbHardware+offset, pCurVertices, 4*sizeof(VERTEX_FORMAT));
 			}
+
+			// Note - We have been building the vertex buffer in the memory location.
+			// Now copy the set of vertices into the hardware buffer.
+			// We don't copy the whole vertex buffer because we often update only
+			// a couple of rows and its a lot faster to just copy the ones that change.
+			Int offset = pCurVertices - vBase;
+			memcpy(vbHardware+offset, pCurVertices, 4*sizeof(VERTEX_FORMAT));
 		}
-		return 0; //success.
 	}
-	return -1;
+	}
 }
 
 //=============================================================================
@@ -1029,6 +1269,7 @@ Int HeightMapRenderObjClass::updateBlock(Int x0, Int y0, Int x1, Int y1,  WorldH
 HeightMapRenderObjClass::~HeightMapRenderObjClass(void)
 {
 	freeMapResources();
+	stopHeightMapUpdateWorkers();
 
 	delete [] m_extraBlendTilePositions;
 	m_extraBlendTilePositions = nullptr;
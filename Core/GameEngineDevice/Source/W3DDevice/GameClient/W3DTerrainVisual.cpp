@@ -64,6 +64,10 @@
 #include "WW3D2/coltest.h"
 #include "WW3D2/assetmgr.h"
 
+#ifdef _ANDROID
+#include "GLESProgramCache.h"
+#endif
+
 
 
 class TestSeismicFilter : public SeismicSimulationFilterBase
@@ -538,6 +542,12 @@ Bool W3DTerrainVisual::load( AsciiString filename )
 	if( TerrainVisual::load( filename ) == FALSE )
 		return FALSE;  // failed
 
+#ifdef _ANDROID
+	// TheSuperHackers @performance 19/10/2026 Load the GL programs this map used last time while the
+	// load screen is up, and record the ones it uses now for the next time.
+	GLESProgramCache::BeginMap(filename.str());
+#endif
+
 	// open the terrain file
 	CachedFileInputStream fileStrm;
 	if( !fileStrm.open(filename) )
@@ -1360,7 +1360,6 @@ void W3DView::update(void)
 	getAxisAlignedViewRegion(axisAlignedRegion);
 
 	// render all of the visible Drawables
-	/// @todo this needs to use a real region partition or something
 	TheGameClient->iterateDrawablesInRegion( &axisAlignedRegion, drawDrawable, nullptr );
 }
 
@@ -2020,6 +2019,45 @@ View::WorldToScreenReturn W3DView::worldToScreenTriReturn( const Coord3D *w, ICo
   return WTS_INVALID;
 }
 
+//-------------------------------------------------------------------------------------------------
+struct ScreenRegionIterateInfo
+{
+	CameraClass *camera;
+	const Region2D *normalizedRegion;
+	Bool (*callback)( Drawable *draw, void *userData );
+	void *userData;
+	Int count;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Calls the callback of the iteration, if the drawable projects into the screen region */
+//-------------------------------------------------------------------------------------------------
+static void callbackIfInScreenRegion( Drawable *draw, void *userData )
+{
+	ScreenRegionIterateInfo *info = (ScreenRegionIterateInfo *)userData;
+
+	// no screen region, means all drawbles
+	if( info->normalizedRegion != nullptr )
+	{
+		// project the center of the drawable to the screen
+		/// @todo use a real 3D position in the drawable
+		const Coord3D *pos = draw->getPosition();
+		Vector3 world( pos->x, pos->y, pos->z );
+		Vector3 screen;
+
+		// project the world point to the screen
+		if( info->camera->Project( screen, world ) != CameraClass::INSIDE_FRUSTUM ||
+				screen.X < info->normalizedRegion->lo.x ||
+				screen.X > info->normalizedRegion->hi.x ||
+				screen.Y < info->normalizedRegion->lo.y ||
+				screen.Y > info->normalizedRegion->hi.y )
+			return;
+	}
+
+	if( info->callback( draw, info->userData ) )
+		++info->count;
+}
+
 //-------------------------------------------------------------------------------------------------
 /** all the drawables in the view, that fall within the 2D screen region
 	* will call the callback function.  The number of drawables that passed
@@ -2030,16 +2068,8 @@ Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
 																			 Bool (*callback)( Drawable *draw, void *userData ),
 																			 void *userData )
 {
-	Bool inside = FALSE;
-	Int count = 0;
-	Drawable *draw;
-	Vector3 screen, world;
-	Coord3D pos;
 	Region2D normalizedRegion;
 
-	/** @todo we need to have partitions of which drawables are in the
-	view so we don't have to march through the whole list */
-
 	//
 	// to do this we are projecting the drawable centers onto the screen,
 	// the W3D camera->project method is used to do this and that method
@@ -2048,92 +2078,79 @@ Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
 	//
 	/// @todo use fast int->real type casts here later
 
-	Bool regionIsPoint = FALSE;
-
 	if( screenRegion )
 	{
 		if (screenRegion->height() == 0 && screenRegion->width() == 0)
 		{
-			regionIsPoint = TRUE;
+			// Allow all drawables to be picked.
+			Drawable *draw = pickDrawable(&screenRegion->lo, TRUE, (PickType) getPickTypesForContext(TheInGameUI->isInForceAttackMode()));
+			if (draw == nullptr)
+				return 0;
+
+			return callback( draw, userData ) ? 1 : 0;
 		}
 
 		normalizedRegion.lo.x = ((Real)(screenRegion->lo.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
 		normalizedRegion.lo.y = -(((Real)(screenRegion->hi.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
 		normalizedRegion.hi.x = ((Real)(screenRegion->hi.x - m_originX) / (Real)getWidth()) * 2.0f - 1.0f;
 		normalizedRegion.hi.y = -(((Real)(screenRegion->lo.y - m_originY) / (Real)getHeight()) * 2.0f - 1.0f);
-
 	}
 
+	ScreenRegionIterateInfo info;
+	info.camera = m_3DCamera;
+	info.normalizedRegion = screenRegion ? &normalizedRegion : nullptr;
+	info.callback = callback;
+	info.userData = userData;
+	info.count = 0;
 
-	Drawable *onlyDrawableToTest = nullptr;
-	if (regionIsPoint)
-	{
-		// Allow all drawables to be picked.
-		onlyDrawableToTest = pickDrawable(&screenRegion->lo, TRUE, (PickType) getPickTypesForContext(TheInGameUI->isInForceAttackMode()));
-		if (onlyDrawableToTest == nullptr) {
-			return 0;
-		}
-	}
-
-	for( draw = TheGameClient->firstDrawable();
-			 draw;
-			 draw = draw->getNextDrawable() )
+	// TheSuperHackers @performance 19/10/2026 Only the drawables within the world space bounds of the
+	// view frustum can project into the screen region, so let the client grid find them. The bounds
+	// are the camera position and the four corners of the far clip plane, with a little slack.
+	Region3D *worldRegion = nullptr;
+	Region3D frustumRegion;
+	if( screenRegion && m_3DCamera->Get_Projection_Type() == CameraClass::PERSPECTIVE )
 	{
-		if (onlyDrawableToTest)
+		Real znear, zfar;
+		m_3DCamera->Get_Clip_Planes( znear, zfar );
+		const Real farScale = zfar * 1.01f;
+		const Vector3 cameraPos = m_3DCamera->Get_Position();
+
+		Coord3D corners[ 5 ];
+		corners[ 0 ].set( cameraPos.X, cameraPos.Y, cameraPos.Z );
+		for( Int i = 0; i < 4; ++i )
 		{
-		 draw = onlyDrawableToTest;
-		 inside = TRUE;
+			const Vector2 viewPoint( (i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f );
+			Vector3 viewPlanePoint;
+			m_3DCamera->Un_Project( viewPlanePoint, viewPoint );
+			const Vector3 farPoint = cameraPos + (viewPlanePoint - cameraPos) * farScale;
+			corners[ i + 1 ].set( farPoint.X, farPoint.Y, farPoint.Z );
 		}
-		else
-		{
-
-			// not inside
-			inside = FALSE;
-
-			// no screen region, means all drawbles
-			if( screenRegion == nullptr )
-				inside = TRUE;
-			else
-			{
-
-				// project the center of the drawable to the screen
-				/// @todo use a real 3D position in the drawable
-				pos = *draw->getPosition();
-				world.X = pos.x;
-				world.Y = pos.y;
-				world.Z = pos.z;
-
-				// project the world point to the screen
-				if( m_3DCamera->Project( screen, world ) == CameraClass::INSIDE_FRUSTUM &&
-						screen.X >= normalizedRegion.lo.x &&
-						screen.X <= normalizedRegion.hi.x &&
-						screen.Y >= normalizedRegion.lo.y &&
-						screen.Y <= normalizedRegion.hi.y )
-				{
 
-					inside = TRUE;
-
-				}
-			}
-
-		}
-
-		// if inside do the callback and count up
-		if( inside )
+		frustumRegion.lo = frustumRegion.hi = corners[ 0 ];
+		for( Int i = 1; i < 5; ++i )
 		{
-
-			if( callback( draw, userData ) )
-				++count;
-
+			frustumRegion.lo.x = min( frustumRegion.lo.x, corners[ i ].x );
+			frustumRegion.lo.y = min( frustumRegion.lo.y, corners[ i ].y );
+			frustumRegion.lo.z = min( frustumRegion.lo.z, corners[ i ].z );
+			frustumRegion.hi.x = max( frustumRegion.hi.x, corners[ i ].x );
+			frustumRegion.hi.y = max( frustumRegion.hi.y, corners[ i ].y );
+			frustumRegion.hi.z = max( frustumRegion.hi.z, corners[ i ].z );
 		}
 
-		// If onlyDrawableToTest, then we should bail out now.
-		if (onlyDrawableToTest != nullptr)
-			break;
+		const Real slack = 1.0f;
+		frustumRegion.lo.x -= slack;
+		frustumRegion.lo.y -= slack;
+		frustumRegion.lo.z -= slack;
+		frustumRegion.hi.x += slack;
+		frustumRegion.hi.y += slack;
+		frustumRegion.hi.z += slack;
 
+		worldRegion = &frustumRegion;
 	}
 
-	return count;
+	TheGameClient->iterateDrawablesInRegion( worldRegion, callbackIfInScreenRegion, &info );
+
+	return info.count;
 
 }
 
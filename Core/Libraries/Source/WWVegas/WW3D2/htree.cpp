@@ -38,6 +38,7 @@
  *   HTreeClass::Load -- loads a hierarchy tree from a file                                    *
  *   HTreeClass::read_pivots -- reads the pivots out of a file                                 *
  *   HTreeClass::Free -- de-allocate all memory in use                                         *
+ *   HTreeClass::Is_Pose_Valid -- Checks if the pivots were last updated with the given inputs *
  *   HTreeClass::Base_Update -- Computes the base pose transform for each pivot                *
  *   HTreeClass::Anim_Update -- Computes the transform for each pivot with motion              *
  *   HTreeClass::Blend_Update -- computes each pivot as a blend of two anims                   *
@@ -78,7 +79,9 @@
 HTreeClass::HTreeClass(void) :
 	NumPivots(0),
 	Pivot(nullptr),
-	ScaleFactor(1.0f)
+	ScaleFactor(1.0f),
+	PoseMotion(nullptr),
+	PoseFrame(0.0f)
 {
 }
 
@@ -139,7 +142,9 @@ HTreeClass::~HTreeClass(void)
 HTreeClass::HTreeClass(const HTreeClass & src) :
 	NumPivots(0),
 	Pivot(nullptr),
-	ScaleFactor(1.0f)
+	ScaleFactor(1.0f),
+	PoseMotion(nullptr),
+	PoseFrame(0.0f)
 {
 	memcpy(&Name,&src.Name,sizeof(Name));
 
@@ -363,6 +368,7 @@ void HTreeClass::Free(void)
 
 	// Also clean up other members:
 	ScaleFactor = 1.0f;
+	Invalidate_Pose();
 }
 
 
@@ -514,6 +520,34 @@ bool HTreeClass::Simple_Evaluate_Pivot
 }
 
 
+/***********************************************************************************************
+ * HTreeClass::Is_Pose_Valid -- Checks if the pivots were last updated with the given inputs   *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *   The root is compared bitwise, so that a valid pose is exactly what an update would write. *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   10/19/2026 TheSuperHackers : Created.                                                     *
+ *=============================================================================================*/
+bool HTreeClass::Is_Pose_Valid(const Matrix3D & root, const HAnimClass * motion, float frame) const
+{
+	return PoseMotion == motion
+		&& PoseFrame == frame
+		&& memcmp(&PoseRoot, &root, sizeof(Matrix3D)) == 0;
+}
+
+void HTreeClass::Set_Pose_Valid(const Matrix3D & root, const HAnimClass * motion, float frame)
+{
+	PoseMotion = motion;
+	PoseFrame = frame;
+	PoseRoot = root;
+}
+
+
 /***********************************************************************************************
  * HTreeClass::Base_Update -- Computes the base pose transform for each pivot                  *
  *                                                                                             *
@@ -530,6 +564,8 @@ void HTreeClass::Base_Update(const Matrix3D & root)
 {
 	PivotClass *pivot;
 
+	Invalidate_Pose();
+
 	Pivot[0].Transform = root;
 	Pivot[0].IsVisible = true;
 
@@ -559,8 +595,12 @@ void HTreeClass::Base_Update(const Matrix3D & root)
  *=============================================================================================*/
 void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float frame)
 {
+	if (Is_Pose_Valid(root,motion,frame))
+		return;
+
 	PivotClass *pivot;
 	Matrix3D mtx;
+	bool captured = false;
 
 	Pivot[0].Transform = root;
 	Pivot[0].IsVisible = true;
@@ -600,8 +640,14 @@ void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float fra
 		{
 			pivot->Capture_Update();
 			pivot->IsVisible = true;
+			captured = true;
 		}
 	}
+
+	if (captured)
+		Invalidate_Pose();
+	else
+		Set_Pose_Valid(root,motion,frame);
 }
 
 /*Customized version of the above which excludes interpolation and assumes HRawAnimClass
@@ -617,9 +663,7 @@ void HTreeClass::Anim_Update_Without_Interpolation(const Matrix3D & root,HRawAni
 	}
 
 	PivotClass *pivot,*endpivot,*lastAnimPivot;
-
-	Pivot[0].Transform = root;
-	Pivot[0].IsVisible = true;
+	bool captured = false;
 
 	int num_anim_pivots = motion->Get_Num_Pivots ();
 
@@ -628,6 +672,12 @@ void HTreeClass::Anim_Update_Without_Interpolation(const Matrix3D & root,HRawAni
 	if (iframe >= motion->Get_Num_Frames())
 		iframe = 0;
 
+	if (Is_Pose_Valid(root,motion,(float)iframe))
+		return;
+
+	Pivot[0].Transform = root;
+	Pivot[0].IsVisible = true;
+
 	Vector3 trans;
 	Quaternion q;
 	Matrix3D mtx;
@@ -685,8 +735,14 @@ void HTreeClass::Anim_Update_Without_Interpolation(const Matrix3D & root,HRawAni
 		{
 			pivot->Capture_Update();
 			pivot->IsVisible = true;
+			captured = true;
 		}
 	}
+
+	if (captured)
+		Invalidate_Pose();
+	else
+		Set_Pose_Valid(root,motion,(float)iframe);
 }
 
 
@@ -715,6 +771,8 @@ void HTreeClass::Blend_Update
 	PivotClass *pivot;
 	Matrix3D mtx;
 
+	Invalidate_Pose();
+
 	Pivot[0].Transform = root;
 	Pivot[0].IsVisible = true;
 
@@ -783,6 +841,8 @@ void HTreeClass::Combo_Update
 	PivotClass *pivot;
 	Matrix3D mtx;
 
+	Invalidate_Pose();
+
 	Pivot[0].Transform = root;
 	Pivot[0].IsVisible = true;
 
@@ -1000,6 +1060,7 @@ void HTreeClass::Scale(float factor)
 
 	// Set state used later to scale animations:
 	ScaleFactor *= factor;
+	Invalidate_Pose();
 }
 
 
@@ -1008,6 +1069,7 @@ void HTreeClass::Capture_Bone(int boneindex)
 {
 	assert(boneindex >= 0);
 	assert(boneindex < NumPivots);
+	Invalidate_Pose();
 #ifdef LAZY_CAP_MTX_ALLOC
 	if (Pivot[boneindex].CapTransformPtr == nullptr)
 	{
@@ -1023,6 +1085,7 @@ void HTreeClass::Release_Bone(int boneindex)
 {
 	assert(boneindex >= 0);
 	assert(boneindex < NumPivots);
+	Invalidate_Pose();
 #ifdef LAZY_CAP_MTX_ALLOC
 	delete Pivot[boneindex].CapTransformPtr;
 	Pivot[boneindex].CapTransformPtr = nullptr;
@@ -120,6 +120,10 @@ public:
 	void					Control_Bone(int boneindex,const Matrix3D & relative_tm,bool world_space_translation = false);
 	void					Get_Bone_Control(int boneindex, Matrix3D & relative_tm) const;
 
+	// Forces the next animation update to evaluate all pivots again. Call this before
+	// releasing an animation that may have been the last one applied to this tree.
+	void					Invalidate_Pose(void) { PoseMotion = nullptr; }
+
 
 
 	//
@@ -161,6 +165,16 @@ private:
 	PivotClass *		Pivot;
 	float					ScaleFactor;
 
+	// TheSuperHackers @performance 19/10/2026 Inputs of the last single animation update. Every render pass
+	// updates animated objects, so the pivots are often evaluated again with identical inputs. Such an update
+	// is skipped, because it would produce the same pivot transforms. Captured bones are never cached.
+	const HAnimClass *PoseMotion;
+	float					PoseFrame;
+	Matrix3D				PoseRoot;
+
+	bool					Is_Pose_Valid(const Matrix3D & root, const HAnimClass * motion, float frame) const;
+	void					Set_Pose_Valid(const Matrix3D & root, const HAnimClass * motion, float frame);
+
 	void					Free(void);
 	bool					read_pivots(ChunkLoadClass & cload,bool pre30);
 
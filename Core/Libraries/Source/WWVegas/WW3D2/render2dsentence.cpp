@@ -40,8 +40,23 @@
 #include "wwprofile.h"
 #include "wwmemlog.h"
 #include "dx8wrapper.h"
+#include "RAWFILE.h"
 
 
+StringClass FontCharsClass::GlyphCachePath;
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Set_Glyph_Cache_Path
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+FontCharsClass::Set_Glyph_Cache_Path (const char *path)
+{
+	GlyphCachePath = path;
+	return ;
+}
+
 
 // Render2DSentence is heavily dependent on Windows GDI and is disabled for Android.
 #ifndef _ANDROID
@@ -52,6 +67,36 @@
 #define no_TEST_PLACEMENT 1	 // Shows alignment markers for text.
 
 #define TEXTURE_OFFSET 2
+
+// TheSuperHackers @performance 19/10/2026 Rasterizing a character with GDI is slow and happens the first
+// time each character is drawn, which makes text stutter on first appearance, especially with the large
+// character sets of the asian languages. The rasterized characters of every font are written to a glyph
+// cache file when the font is freed and packed back into the character buffers when the font is created.
+// The cache is only used while the GDI font metrics still match.
+enum
+{
+	GLYPH_CACHE_MAGIC		= 0x31434746,	// 'FGC1'
+	GLYPH_CACHE_VERSION	= 1,
+};
+
+struct GlyphCacheHeaderStruct
+{
+	uint32	Magic;
+	uint32	Version;
+	sint32	CharHeight;
+	sint32	CharAscent;
+	sint32	CharOverhang;
+	sint32	PixelOverlap;
+	uint32	CharCount;
+	uint16	FirstUnicodeChar;		// range of the characters above 255, first > last if there are none
+	uint16	LastUnicodeChar;
+};
+
+struct GlyphCacheCharStruct
+{
+	uint16	Value;
+	sint16	Width;					// followed by Width * CharHeight pixels
+};
 ////////////////////////////////////////////////////////////////////////////////////
 //
 //	Render2DSentenceClass
@@ -1204,7 +1249,8 @@ FontCharsClass::FontCharsClass (void) :
 	UnicodeCharArray( nullptr ),
 	FirstUnicodeChar( 0xFFFF ),
 	LastUnicodeChar( 0 ),
-	IsBold (false)
+	IsBold (false),
+	NewCharCount( 0 )
 {
 	AlternateUnicodeFont = nullptr;
 	::memset( ASCIICharArray, 0, sizeof (ASCIICharArray) );
@@ -1219,6 +1265,10 @@ FontCharsClass::FontCharsClass (void) :
 ////////////////////////////////////////////////////////////////////////////////////
 FontCharsClass::~FontCharsClass (void)
 {
+	if ( NewCharCount > 0 ) {
+		Save_Glyph_Cache();
+	}
+
 	while ( BufferList.Count() ) {
 		delete BufferList[0];
 		BufferList.Delete(0);
@@ -1367,12 +1417,12 @@ FontCharsClass::Store_GDI_Char (WCHAR ch)
 	SIZE char_size = { 0 };
 	::GetTextExtentPoint32W( MemDC, &ch, 1, &char_size );
 	char_size.cx += PixelOverlap + xOrigin;
+
 	//
-	//	Get a pointer to the surface that this character should use
+	//	Reserve room for this character in our buffers
 	//
-	Update_Current_Buffer( char_size.cx );
-	uint16* curr_buffer_p = BufferList[BufferList.Count () - 1]->Buffer;
-	curr_buffer_p += CurrPixelOffset;
+	uint16* curr_buffer_p = nullptr;
+	FontCharsClassCharDataStruct *char_data = Add_Char( ch, char_size.cx, curr_buffer_p );
 
 	//
 	//	Copy the BMP contents to the buffer
@@ -1439,13 +1489,36 @@ FontCharsClass::Store_GDI_Char (WCHAR ch)
 		}
 	}
 
+	NewCharCount ++;
+
+	//
+	//	Return the index of the entry we just added
+	//
+	return char_data;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Add_Char
+//
+////////////////////////////////////////////////////////////////////////////////////
+FontCharsClassCharDataStruct *
+FontCharsClass::Add_Char (WCHAR ch, int char_width, uint16 *&buffer_ptr)
+{
+	//
+	//	Get a pointer to the surface that this character should use
+	//
+	Update_Current_Buffer( char_width );
+	buffer_ptr = BufferList[BufferList.Count () - 1]->Buffer + CurrPixelOffset;
+
 	//
 	//	Save information about this character in our list
 	//
 	FontCharsClassCharDataStruct *char_data	= W3DNEW FontCharsClassCharDataStruct;
 	char_data->Value				= ch;
-	char_data->Width				= char_size.cx;
-	char_data->Buffer				= BufferList[BufferList.Count () - 1]->Buffer + CurrPixelOffset;
+	char_data->Width				= char_width;
+	char_data->Buffer				= buffer_ptr;
 
 	//
 	//	Insert this character into our array
@@ -1453,17 +1526,14 @@ FontCharsClass::Store_GDI_Char (WCHAR ch)
 	if ( ch < 256 ) {
 		ASCIICharArray[ch] = char_data;
 	} else {
+		Grow_Unicode_Array( ch );
 		UnicodeCharArray[ch - FirstUnicodeChar] = char_data;
 	}
 
 	//
 	//	Advance the character position
 	//
-	CurrPixelOffset += ((char_size.cx+PixelOverlap) * CharHeight);
-
-	//
-	//	Return the index of the entry we just added
-	//
+	CurrPixelOffset += ((char_width+PixelOverlap) * CharHeight);
 	return char_data;
 }
 
@@ -1671,7 +1741,12 @@ FontCharsClass::Initialize_GDI_Font (const char *font_name, int point_size, bool
 	//
 	//	Create the actual font object
 	//
-	return Create_GDI_Font (font_name);
+	if ( Create_GDI_Font (font_name) == false ) {
+		return false;
+	}
+
+	Load_Glyph_Cache();
+	return true;
 }
 
 
@@ -1791,4 +1866,190 @@ FontCharsClass::Free_Character_Arrays (void)
 	return ;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Get_Glyph_Cache_Filename
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+FontCharsClass::Get_Glyph_Cache_Filename (StringClass &filename)
+{
+	filename.Format ("%s%s%s.fgc", GlyphCachePath.str(), Name.str(), IsBold ? "b" : "");
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Load_Glyph_Cache
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+FontCharsClass::Load_Glyph_Cache (void)
+{
+	if ( GlyphCachePath.Is_Empty() ) {
+		return ;
+	}
+
+	StringClass filename;
+	Get_Glyph_Cache_Filename( filename );
+
+	RawFileClass file( filename );
+	if ( file.Is_Available() == false || file.Open( RawFileClass::READ ) == false ) {
+		return ;
+	}
+
+	//
+	//	Read the whole file at once
+	//
+	int size = file.Size();
+	if ( size < (int)sizeof( GlyphCacheHeaderStruct ) ) {
+		file.Close();
+		return ;
+	}
+
+	uint8 *data = W3DNEWARRAY uint8[size];
+	bool is_valid = (file.Read( data, size ) == size);
+	file.Close();
+
+	//
+	//	Reject the cache if the font does not rasterize the same way anymore
+	//
+	GlyphCacheHeaderStruct header;
+	::memcpy( &header, data, sizeof( header ) );
+	is_valid = is_valid &&
+		header.Magic == GLYPH_CACHE_MAGIC &&
+		header.Version == GLYPH_CACHE_VERSION &&
+		header.CharHeight == CharHeight &&
+		header.CharAscent == CharAscent &&
+		header.CharOverhang == CharOverhang &&
+		header.PixelOverlap == PixelOverlap;
+
+	if ( is_valid ) {
+
+		//
+		//	Size the unicode array once instead of once per character
+		//
+		if ( header.FirstUnicodeChar >= 256 && header.FirstUnicodeChar <= header.LastUnicodeChar ) {
+			Grow_Unicode_Array( header.FirstUnicodeChar );
+			Grow_Unicode_Array( header.LastUnicodeChar );
+		}
+
+		const uint8 *read_ptr	= data + sizeof( header );
+		const uint8 *end_ptr		= data + size;
+		for ( uint32 index = 0; index < header.CharCount; index ++ ) {
+
+			GlyphCacheCharStruct entry;
+			if ( end_ptr - read_ptr < (int)sizeof( entry ) ) {
+				break;
+			}
+			::memcpy( &entry, read_ptr, sizeof( entry ) );
+			read_ptr += sizeof( entry );
+
+			int pixel_bytes = entry.Width * CharHeight * sizeof( uint16 );
+			if ( entry.Width < 0 || entry.Width * CharHeight > CHAR_BUFFER_LEN || end_ptr - read_ptr < pixel_bytes ) {
+				break;
+			}
+
+			//
+			//	Pack the character into our buffers
+			//
+			uint16 *buffer_ptr = nullptr;
+			Add_Char( entry.Value, entry.Width, buffer_ptr );
+			::memcpy( buffer_ptr, read_ptr, pixel_bytes );
+			read_ptr += pixel_bytes;
+		}
+	}
+
+	delete [] data;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Save_Glyph_Cache
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+FontCharsClass::Save_Glyph_Cache (void)
+{
+	if ( GlyphCachePath.Is_Empty() ) {
+		return ;
+	}
+
+	//
+	//	Collect the characters in ascending order
+	//
+	DynamicVectorClass<const FontCharsClassCharDataStruct *> char_list;
+	int index;
+	for ( index = 0; index < 256; index ++ ) {
+		if ( ASCIICharArray[index] != nullptr ) {
+			char_list.Add( ASCIICharArray[index] );
+		}
+	}
+
+	GlyphCacheHeaderStruct header;
+	header.FirstUnicodeChar	= 0xFFFF;
+	header.LastUnicodeChar	= 0;
+	if ( UnicodeCharArray != nullptr ) {
+		int count = (LastUnicodeChar - FirstUnicodeChar) + 1;
+		for ( index = 0; index < count; index ++ ) {
+			if ( UnicodeCharArray[index] != nullptr ) {
+				char_list.Add( UnicodeCharArray[index] );
+				header.FirstUnicodeChar	= min( header.FirstUnicodeChar, static_cast<uint16>(UnicodeCharArray[index]->Value) );
+				header.LastUnicodeChar	= max( header.LastUnicodeChar, static_cast<uint16>(UnicodeCharArray[index]->Value) );
+			}
+		}
+	}
+
+	header.Magic				= GLYPH_CACHE_MAGIC;
+	header.Version				= GLYPH_CACHE_VERSION;
+	header.CharHeight			= CharHeight;
+	header.CharAscent			= CharAscent;
+	header.CharOverhang		= CharOverhang;
+	header.PixelOverlap		= PixelOverlap;
+	header.CharCount			= char_list.Count();
+
+	//
+	//	Build the file in memory so it is written with a single call
+	//
+	int size = sizeof( header );
+	for ( index = 0; index < char_list.Count(); index ++ ) {
+		size += sizeof( GlyphCacheCharStruct ) + char_list[index]->Width * CharHeight * sizeof( uint16 );
+	}
+
+	uint8 *data			= W3DNEWARRAY uint8[size];
+	uint8 *write_ptr	= data;
+	::memcpy( write_ptr, &header, sizeof( header ) );
+	write_ptr += sizeof( header );
+
+	for ( index = 0; index < char_list.Count(); index ++ ) {
+		const FontCharsClassCharDataStruct *char_data = char_list[index];
+
+		GlyphCacheCharStruct entry;
+		entry.Value	= char_data->Value;
+		entry.Width	= char_data->Width;
+		::memcpy( write_ptr, &entry, sizeof( entry ) );
+		write_ptr += sizeof( entry );
+
+		int pixel_bytes = char_data->Width * CharHeight * sizeof( uint16 );
+		::memcpy( write_ptr, char_data->Buffer, pixel_bytes );
+		write_ptr += pixel_bytes;
+	}
+
+	StringClass filename;
+	Get_Glyph_Cache_Filename( filename );
+
+	RawFileClass file( filename );
+	if ( file.Open( RawFileClass::WRITE ) ) {
+		file.Write( data, size );
+		file.Close();
+	}
+
+	delete [] data;
+	return ;
+}
+
 #endif // !_ANDROID
@@ -94,6 +94,11 @@ public:
 
 	void	Blit_Char( WCHAR ch, uint16 *dest_ptr, int dest_stride, int x, int y );
 
+	//
+	//	Glyphs are kept on disk between runs when a cache directory is set
+	//
+	static void	Set_Glyph_Cache_Path( const char *path );
+
 private:
 
 	//
@@ -108,6 +113,11 @@ private:
 	void							Grow_Unicode_Array( WCHAR ch );
 	void							Free_Character_Arrays( void );
 
+	FontCharsClassCharDataStruct *	Add_Char( WCHAR ch, int char_width, uint16 *&buffer_ptr );
+	void							Get_Glyph_Cache_Filename( StringClass &filename );
+	void							Load_Glyph_Cache( void );
+	void							Save_Glyph_Cache( void );
+
 	//
 	//	Private member data
 	//
@@ -133,6 +143,9 @@ private:
 	uint16								FirstUnicodeChar;
 	uint16								LastUnicodeChar;
 	bool									IsBold;
+	int									NewCharCount;		// characters rasterized since the glyph cache was loaded
+
+	static StringClass					GlyphCachePath;
 };
 
 /*
@@ -163,6 +176,9 @@ public:
 																										return true;}
 	void Set_Hot_Key_Parse( bool parseHotKey ){ ParseHotKey = parseHotKey; }
 	void Set_Use_Hard_Word_Wrap( bool useHardWrap){ useHardWordWrap = useHardWrap;	}
+	float	Get_Wrapping_Width( void ) const					{ return WrapWidth; }
+	bool	Get_Hot_Key_Parse( void ) const					{ return ParseHotKey; }
+	bool	Get_Use_Hard_Word_Wrap( void ) const			{ return useHardWordWrap; }
 	//
 	// Clipping support
 	//
@@ -157,6 +157,7 @@ Profile::FrameName *Profile::m_frameNames;
 _int64 Profile::m_clockCycles=GetClockCyclesFast();
 Profile::PatternListEntry *Profile::firstPatternEntry;
 Profile::PatternListEntry *Profile::lastPatternEntry;
+void (*Profile::m_rangeCallback)(const char *range, bool start);
 
 void Profile::StartRange(const char *range)
 {
@@ -188,6 +189,8 @@ void Profile::StartRange(const char *range)
   // start new recording
   m_frameNames[k].isRecording=true;
   m_frameNames[k].doAppend=false;
+  if (m_rangeCallback)
+    m_rangeCallback(m_frameNames[k].name,true);
 
   // but check first: is recording enabled?
   bool active=false;
@@ -239,6 +242,8 @@ void Profile::AppendRange(const char *range)
   // start new recording
   m_frameNames[k].isRecording=true;
   m_frameNames[k].doAppend=true;
+  if (m_rangeCallback)
+    m_rangeCallback(m_frameNames[k].name,true);
 
   // but check first: is recording enabled?
   bool active=false;
@@ -280,6 +285,8 @@ void Profile::StopRange(const char *range)
 
   // stop recording
   m_frameNames[k].isRecording=false;
+  if (m_rangeCallback)
+    m_rangeCallback(m_frameNames[k].name,false);
   if (
 #ifdef RTS_PROFILE
     m_frameNames[k].funcIndex>=0 ||
@@ -346,6 +353,11 @@ void Profile::AddResultFunction(ProfileResultInterface* (*func)(int, const char
   ProfileCmdInterface::AddResultFunction(func,name,arg);
 }
 
+void Profile::SetRangeCallback(void (*func)(const char *range, bool start))
+{
+  m_rangeCallback=func;
+}
+
 bool Profile::SimpleMatch(const char *str, const char *pattern)
 {
   DASSERT(str);
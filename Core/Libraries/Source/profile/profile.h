@@ -128,6 +128,15 @@ public:
   static void AddResultFunction(ProfileResultInterface* (*func)(int, const char * const *),
                                 const char *name, const char *arg);
 
+  /**
+    \brief Sets a function that is notified whenever a range starts or stops recording.
+
+    The range name passed to the function stays valid until the program ends.
+
+    \param func range callback, nullptr to remove
+  */
+  static void SetRangeCallback(void (*func)(const char *range, bool start));
+
 private:
   /** \internal
 
@@ -202,4 +211,7 @@ private:
 
   /// CPU clock cycles/second
   static _int64 m_clockCycles;
+
+  /// range callback, may be nullptr
+  static void (*m_rangeCallback)(const char *range, bool start);
 };
@@ -84,6 +84,12 @@ public:
 #endif
 	Bool isPlaybackInProgress() const;
 
+	Bool seekToFrame(UnsignedInt frame);							///< Seeks the playback to the frame, restoring the last checkpoint snapshot at or before it when that is closer.
+	Bool isSeeking() const { return m_seekFrame != 0; }	///< Is the playback fast forwarding to a seek frame
+	UnsignedInt getSeekFrame() const { return m_seekFrame; }
+	UnsignedInt getCheckpointMismatchFrame() const { return m_checkpointMismatchFrame; }	///< First checkpoint whose CRC differs from an earlier pass of this replay, or 0
+	void updateCheckpoints();													///< Records, verifies and restores the playback checkpoints. Called between two logic frames.
+
 public:
 	void handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool fromPlayback);
 protected:
@@ -113,6 +119,26 @@ public:
 	};
 	Bool readReplayHeader( ReplayHeader& header );
 
+	// TheSuperHackers @performance 19/10/2026 A replay index is an optional file next to a replay. It maps the
+	// frame and player of every command record to the offset of the record in the replay, so tools can find the
+	// commands of a frame range or of a player without decoding the replay up to them. The index is built when
+	// a recording ends and is copied along with its replay. A playback builds the index of its replay if it is
+	// missing, and uses it to find the next command of a restored checkpoint. It is only valid while its replay
+	// is unchanged.
+	struct ReplayIndexEntry
+	{
+		UnsignedInt frame;
+		UnsignedInt fileOffset;														///< offset of the command record in the replay file
+		Int playerIndex;
+	};
+	typedef std::vector<ReplayIndexEntry> ReplayIndex;	///< ordered by file offset, which also orders it by frame
+
+	Bool buildReplayIndex( AsciiString filename );			///< Decodes the replay and writes its index. Not valid during playback or recording.
+	Bool readReplayIndex( AsciiString filename, ReplayIndex& index );	///< Fails if the index is missing or does not match the replay.
+	static size_t findFirstCommand( const ReplayIndex& index, UnsignedInt frame );	///< Returns the first entry at or after the frame
+	static void findPlayerCommands( const ReplayIndex& index, Int playerIndex, std::vector<UnsignedInt>& fileOffsets );
+	static void copyReplayIndex( AsciiString fromReplayPath, AsciiString toReplayPath );	///< Copies the index next to a copy of its replay
+
 	RecorderModeType getMode();												///< Returns the current operating mode.
 	Bool isPlaybackMode() const { return m_mode == RECORDERMODETYPE_PLAYBACK || m_mode == RECORDERMODETYPE_SIMULATION_PLAYBACK; }
 	void initControls();															///< Show or Hide the Replay controls
@@ -120,6 +146,7 @@ public:
 	static AsciiString getReplayDir();								///< Returns the directory that holds the replay files.
 	static AsciiString getReplayArchiveDir();					///< Returns the directory that holds the archived replay files.
 	static AsciiString getReplayExtention();					///< Returns the file extention for replay files.
+	static AsciiString getReplayIndexExtention();			///< Returns the file extention for replay index files.
 	static AsciiString getLastReplayFileName();				///< Returns the filename used for the default replay.
 
 	GameInfo *getGameInfo( void ) { return &m_gameInfo; }	///< Returns the slot list for playback game start
@@ -146,6 +173,11 @@ protected:
 	AsciiString readAsciiString();										///< Read the next string from m_file using ascii characters.
 	UnicodeString readUnicodeString();								///< Read the next string from m_file using unicode characters.
 	void readNextFrame();															///< Read the next frame number to execute a command on.
+	Bool readNextIndexEntry(ReplayIndexEntry& entry);	///< Read the next command record from m_file, skipping its arguments.
+	static AsciiString getReplayIndexPath(AsciiString filename);
+#if defined(RTS_DEBUG)
+	void checkReplayIndexEntry(Int fileOffset, UnsignedInt frame, Int playerIndex);	///< Asserts that the playback index matches the decoded command
+#endif
 	void appendNextCommand();													///< Read the next GameMessage and append it to TheCommandList.
 	void writeArgument(GameMessageArgumentDataType type, const GameMessageArgumentType arg);
 	void readArgument(GameMessageArgumentDataType type, GameMessage *msg);
@@ -158,6 +190,33 @@ protected:
 
 	CullBadCommandsResult cullBadCommands(); ///< prevent the user from giving mouse commands that he shouldn't be able to do during playback.
 
+	void updateSeek(UnsignedInt frame);								///< Keeps the playback fast forwarding until the seek frame is reached.
+	void endSeek();
+
+	// TheSuperHackers @performance 19/10/2026 The playback records a checkpoint with the logic CRC at a
+	// regular frame interval. The checkpoints are kept while the same replay is restarted, so every
+	// pass after the first one verifies that the game logic reproduces the CRCs of the first pass.
+	// Some checkpoints also hold a save snapshot of the game state together with the logic random state
+	// and the playback position, which the save data does not hold. A seek restores the last snapshot at
+	// or before the seek frame and fast forwards from there.
+	struct PlaybackCheckpoint
+	{
+		PlaybackCheckpoint() : frame(0), crc(0), filePosition(0), nextFrame(0) {}
+
+		UnsignedInt frame;
+		UnsignedInt crc;
+		UnsignedInt randomState[6];
+		Int filePosition;																	///< position of the playback file after the frame of the next command
+		UnsignedInt nextFrame;
+		std::vector<UnsignedInt> crcQueue;								///< replay CRCs that wait for their local CRC
+		std::vector<UnsignedByte> snapshot;							///< save data of the game state, empty if the checkpoint has no snapshot
+	};
+	typedef std::vector<PlaybackCheckpoint> PlaybackCheckpointVector;
+
+	void recordCheckpoint(UnsignedInt frame, UnsignedInt crc);
+	const PlaybackCheckpoint *findSnapshotCheckpoint(UnsignedInt frame) const;	///< Returns the last checkpoint with a snapshot at or before the frame
+	Bool restoreCheckpoint(const PlaybackCheckpoint& checkpoint);
+
 	File* m_file;
 	AsciiString m_fileName;
 	Int m_currentFilePosition;
@@ -174,6 +233,20 @@ protected:
 	Int m_originalGameMode; // valid in replays
 
 	UnsignedInt m_nextFrame;												///< The Frame that the next message is to be executed on.  This can be -1.
+
+	PlaybackCheckpointVector m_checkpoints;					///< checkpoints of the replay identified below, ordered by frame
+	AsciiString m_checkpointReplayFilename;
+	time_t m_checkpointReplayStartTime;						///< The same replay filename can hold a different game, so the header identifies the replay too
+	UnsignedInt m_checkpointReplayFrameCount;
+	UnsignedInt m_checkpointMismatchFrame;
+	UnsignedInt m_seekFrame;												///< The frame the playback fast forwards to, or 0 if not seeking.
+	UnsignedInt m_seekStartTime;
+	Bool m_seekSavedFastMode;												///< The fast forward mode to restore when the seek ends.
+	Bool m_restoringCheckpoint;											///< Keeps the playback through the engine reset of a checkpoint restore.
+	ReplayIndex m_playbackIndex;										///< index of the replay in playback, empty if it has none
+#if defined(RTS_DEBUG)
+	size_t m_playbackIndexCheck;										///< the index entry of the next command that the playback decodes
+#endif
 };
 
 extern RecorderClass *TheRecorder;
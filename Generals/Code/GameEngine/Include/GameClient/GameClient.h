@@ -123,6 +123,7 @@ public:
 	virtual void unloadMap( AsciiString mapName );  ///< unload the specified map from our scene
 
 	virtual void iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr userFunc, void *userData );		///< Calls userFunc for each drawable contained within the region
+	void updateDrawableGridCell( Drawable *draw );											///< Moves the drawable to the grid cell of its current position
 
 	virtual Drawable *friend_createDrawable( const ThingTemplate *thing, DrawableStatusBits statusBits = DRAWABLE_STATUS_DEFAULT ) = 0;
 	virtual void destroyDrawable( Drawable *draw );											///< Destroy the given drawable
@@ -175,6 +176,14 @@ private:
 
 	UnsignedInt m_renderedObjectCount;													///< Keeps track of the number of rendered objects -- resets each frame.
 
+	// TheSuperHackers @performance 19/10/2026 Uniform grid of the drawables by position, so that region
+	// iteration only visits the drawables near the region. Positions outside of the grid wrap around.
+	enum { DRAWABLE_GRID_SIZE = 64 };														///< cells per axis, must be a power of two
+	static Int getDrawableGridCoord( Real v );
+	static Int getDrawableGridCell( const Coord3D *pos );
+	Drawable *m_drawableGrid[ DRAWABLE_GRID_SIZE * DRAWABLE_GRID_SIZE ];	///< drawable list of each grid cell
+	UnsignedInt m_drawableListOrder;														///< For allocating the list order of registered drawables
+
 	//---------------------------------------------------------------------------
 
 	virtual Display *createGameDisplay( void ) = 0;							///< Factory for Display classes. Called during init to instantiate TheDisplay.
@@ -49,6 +49,7 @@
 #include "Common/LocalFileSystem.h"
 #include "Common/GlobalData.h"
 #include "Common/PerfTimer.h"
+#include "Common/PerfTrace.h"
 #include "Common/RandomValue.h"
 #include "Common/NameKeyGenerator.h"
 #include "Common/ModuleFactory.h"
@@ -259,6 +260,9 @@ GameEngine::GameEngine( void )
 //-------------------------------------------------------------------------------------------------
 GameEngine::~GameEngine()
 {
+	// TheSuperHackers @performance 19/10/2026 Write the performance trace, if one was requested.
+	PerfTrace::exportToOutputFile();
+
 	//extern std::vector<std::string>	preloadTextureNamesGlobalHack;
 	//preloadTextureNamesGlobalHack.clear();
 
@@ -730,12 +734,19 @@ void GameEngine::update( void )
 			}
 		}
 
+		// report saves that finished writing in the background
+		TheGameState->UPDATE();
+
 		const Bool canUpdate = canUpdateGameLogic();
 		const Bool canUpdateLogic = canUpdate && !TheFramePacer->isGameHalted() && !TheFramePacer->isTimeFrozen();
 		const Bool canUpdateScript = canUpdate && !TheFramePacer->isGameHalted();
 
 		if (canUpdateLogic)
 		{
+			// TheSuperHackers @performance 19/10/2026 Replay checkpoints save and restore the game state
+			// between two logic frames.
+			TheRecorder->updateCheckpoints();
+
 			TheGameClient->step();
 			TheGameLogic->UPDATE();
 		}
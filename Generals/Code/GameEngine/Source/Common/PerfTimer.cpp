@@ -306,6 +306,7 @@ void PerfGather::removeFromList()
 PerfGather::PerfGather(const char *identifier) :
 	m_identifier(identifier),
 	m_startTime(0),
+	m_traceStartTime(0),
 	m_runningTimeGross(0),
 	m_runningTimeNet(0),
 	m_callCount(0),
@@ -604,7 +604,7 @@ Bool ActionManager::canEnterObject( const Object *obj, const Object *objectToEnt
 	}
 
 	// first, see if we'd like to collide with 'other'
-	for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+	for (BehaviorModule** m = obj->getCollideModules(); *m; ++m)
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if (!collide)
@@ -785,7 +785,7 @@ Bool ActionManager::canConvertObjectToCarBomb( const Object *obj, const Object *
 		return FALSE;
 
 	// first, see if we'd like to collide with 'other'
-	for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+	for (BehaviorModule** m = obj->getCollideModules(); *m; ++m)
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if (!collide)
@@ -859,7 +859,7 @@ Bool ActionManager::canHijackVehicle( const Object *obj, const Object *objectToH
 //	}
 
 	// last, see if we'd like to collide with 'objectToHijack'
-	for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+	for (BehaviorModule** m = obj->getCollideModules(); *m; ++m)
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if (!collide)
@@ -2146,7 +2146,7 @@ Bool Player::addScience(ScienceType science)
 				if (!obj)
 					continue;
 
-				for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+				for (BehaviorModule** m = obj->getSpecialPowerModules(); *m; ++m)
 				{
 					SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 					if (!sp)
@@ -31,6 +31,8 @@
 #include "Common/Player.h"
 #include "Common/GlobalData.h"
 #include "Common/GameEngine.h"
+#include "Common/GameState.h"
+#include "Common/LatchRestore.h"
 #include "GameClient/ClientInstance.h"
 #include "GameClient/GameWindow.h"
 #include "GameClient/GameWindowManager.h"
@@ -50,10 +52,16 @@
 
 constexpr const char s_genrep[] = "GENREP";
 constexpr const UnsignedInt replayBufferBytes = 8192;
+constexpr const char s_genrpi[] = "GENRPI";
+constexpr const UnsignedInt replayIndexVersion = 1;
 
 Int REPLAY_CRC_INTERVAL = 100;
 
+static const UnsignedInt checkpointIntervalSeconds = 30;
+static const UnsignedInt maxCheckpointSnapshots = 16;
+
 const char *replayExtention = ".rep";
+const char *replayIndexExtention = ".rpi";
 const char *lastReplayFileName = "00000000";	// a name the user is unlikely to ever type, but won't cause panic & confusion
 
 // TheSuperHackers @tweak helmutbuhler 25/04/2025
@@ -372,6 +380,16 @@ RecorderClass::RecorderClass()
 	m_archiveReplays = FALSE;
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
+	m_checkpointReplayStartTime = 0;
+	m_checkpointReplayFrameCount = 0;
+	m_checkpointMismatchFrame = 0;
+	m_seekFrame = 0;
+	m_seekStartTime = 0;
+	m_seekSavedFastMode = FALSE;
+	m_restoringCheckpoint = FALSE;
+#if defined(RTS_DEBUG)
+	m_playbackIndexCheck = 0;
+#endif
 	init(); // just for the heck of it.
 }
 
@@ -413,11 +431,16 @@ void RecorderClass::init() {
  * Reset the recorder to the "initialized state."
  */
 void RecorderClass::reset() {
+	// Restoring a checkpoint loads the game state like a save game, which resets the engine.
+	if (m_restoringCheckpoint)
+		return;
+
 	if (m_file != nullptr) {
 		m_file->close();
 		m_file = nullptr;
 	}
 	m_fileName.clear();
+	endSeek();
 
 	init();
 }
@@ -465,6 +488,126 @@ void RecorderClass::updatePlayback() {
 	}
 }
 
+/**
+ * Returns the frame interval of the playback checkpoints. It is a multiple of the replay CRC interval,
+ * so no local CRC message is on its way through the message stream when a checkpoint is taken.
+ */
+static UnsignedInt getCheckpointInterval()
+{
+	const UnsignedInt crcInterval = REPLAY_CRC_INTERVAL > 0 ? (UnsignedInt)REPLAY_CRC_INTERVAL : 1;
+	const UnsignedInt frames = checkpointIntervalSeconds * LOGICFRAMES_PER_SECOND;
+	return ((frames + crcInterval - 1) / crcInterval) * crcInterval;
+}
+
+/**
+ * Returns the number of checkpoints from one checkpoint with a snapshot to the next. A snapshot holds the whole
+ * game state, so a replay keeps at most maxCheckpointSnapshots of them.
+ */
+static UnsignedInt getSnapshotCheckpointStride(UnsignedInt playbackFrameCount)
+{
+	const UnsignedInt checkpoints = playbackFrameCount / getCheckpointInterval();
+	if (checkpoints <= maxCheckpointSnapshots)
+		return 1;
+	return (checkpoints + maxCheckpointSnapshots - 1) / maxCheckpointSnapshots;
+}
+
+/**
+ * Record the checkpoints on the first pass of a replay and compare against them on later passes. A pending seek
+ * first restores the last snapshot at or before the seek frame, if that is closer than the current frame.
+ * This runs between two logic frames, where the game state is saved and loaded like a save game.
+ */
+void RecorderClass::updateCheckpoints() {
+	if (!isPlaybackMode() || m_doingAnalysis || m_file == nullptr)
+		return;
+
+	if (!TheGameLogic->isInGame() || TheGameLogic->isLoadingGame() || TheGameState->isInLoadGame())
+		return;
+
+	UnsignedInt frame = TheGameLogic->getFrame();
+
+	if (m_seekFrame != 0) {
+		const PlaybackCheckpoint *checkpoint = findSnapshotCheckpoint(m_seekFrame);
+		if (checkpoint != nullptr && (checkpoint->frame > frame || frame > m_seekFrame)) {
+			if (!restoreCheckpoint(*checkpoint))
+				return;
+			frame = TheGameLogic->getFrame();
+		}
+	}
+
+	// The checkpoint of a restored frame is compared too, which checks the restore against the first pass.
+	const UnsignedInt interval = getCheckpointInterval();
+	if (frame != 0 && (frame % interval) == 0) {
+		const UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+
+		if (m_checkpoints.empty() || m_checkpoints.back().frame < frame) {
+			recordCheckpoint(frame, crc);
+		} else {
+			// Checkpoints are recorded for every interval frame, so the index follows from the frame.
+			const size_t index = frame / interval - 1;
+			if (index < m_checkpoints.size() && m_checkpoints[index].frame == frame &&
+					m_checkpoints[index].crc != crc && m_checkpointMismatchFrame == 0) {
+				m_checkpointMismatchFrame = frame;
+				DEBUG_LOG(("RecorderClass::updateCheckpoints() - CRC %8.8X differs from the earlier pass CRC %8.8X at frame %d",
+					crc, m_checkpoints[index].crc, frame));
+			}
+		}
+	}
+
+	updateSeek(frame);
+}
+
+const RecorderClass::PlaybackCheckpoint *RecorderClass::findSnapshotCheckpoint(UnsignedInt frame) const {
+	for (PlaybackCheckpointVector::const_reverse_iterator it = m_checkpoints.rbegin(); it != m_checkpoints.rend(); ++it) {
+		if (it->frame <= frame && !it->snapshot.empty())
+			return &(*it);
+	}
+	return nullptr;
+}
+
+/**
+ * Keep the fast forward mode on while seeking.
+ */
+void RecorderClass::updateSeek(UnsignedInt frame) {
+	if (m_seekFrame == 0)
+		return;
+
+	if (frame >= m_seekFrame) {
+		DEBUG_LOG(("RecorderClass::updateSeek() - Reached frame %d in %d ms", frame, timeGetTime() - m_seekStartTime));
+		endSeek();
+		return;
+	}
+
+	TheWritableGlobalData->m_TiVOFastMode = TRUE;
+}
+
+void RecorderClass::endSeek() {
+	if (m_seekFrame == 0)
+		return;
+
+	m_seekFrame = 0;
+	TheWritableGlobalData->m_TiVOFastMode = m_seekSavedFastMode;
+}
+
+/**
+ * Seek the playback to the frame. The next updateCheckpoints restores the last checkpoint snapshot at or before
+ * the frame if that is closer than the current frame, then the playback runs uncapped and without drawing until
+ * the frame is reached. Seeking backwards fails if no snapshot at or before the frame was taken yet.
+ */
+Bool RecorderClass::seekToFrame(UnsignedInt frame) {
+	if (!isPlaybackMode() || m_doingAnalysis)
+		return FALSE;
+
+	if (TheGameLogic->isInGame() && frame < TheGameLogic->getFrame() && findSnapshotCheckpoint(frame) == nullptr)
+		return FALSE;
+
+	const Bool savedFastMode = isSeeking() ? m_seekSavedFastMode : TheGlobalData->m_TiVOFastMode;
+
+	m_seekFrame = frame;
+	m_seekStartTime = timeGetTime();
+	m_seekSavedFastMode = savedFastMode;
+	return TRUE;
+}
+
 /**
  * Stop the currently running playback. This is probably due either to the user exiting out of the playback or
  * reaching the end of the playback file.
@@ -475,6 +618,7 @@ void RecorderClass::stopPlayback() {
 		m_file = nullptr;
 	}
 	m_fileName.clear();
+	endSeek();
 
 	if (!m_doingAnalysis)
 	{
@@ -547,6 +691,10 @@ void RecorderClass::startRecording(GameDifficulty diff, Int originalGameMode, In
 
 	m_mode = RECORDERMODETYPE_RECORD;
 
+	// The new recording overwrites the last replay file, so its checkpoints are stale now.
+	m_checkpoints.clear();
+	m_checkpointReplayFilename.clear();
+
 	AsciiString filepath = getReplayDir();
 
 	// We have to make sure the replay dir exists.
@@ -728,6 +876,8 @@ void RecorderClass::stopRecording() {
 		m_file->close();
 		m_file = nullptr;
 
+		buildReplayIndex(m_fileName);
+
 		if (m_archiveReplays)
 			archiveReplay(m_fileName);
 	}
@@ -761,6 +911,8 @@ void RecorderClass::archiveReplay(AsciiString fileName)
 
 	if (!CopyFile(sourcePath.str(), destPath.str(), FALSE))
 		DEBUG_LOG(("RecorderClass::archiveReplay: Failed to copy %s to %s", sourcePath.str(), destPath.str()));
+	else
+		copyReplayIndex(sourcePath, destPath);
 }
 
 /**
@@ -1026,6 +1178,8 @@ public:
 	UnsignedInt readCRC(void);
 
 	int GetQueueSize() const { return m_data.size(); }
+	void getQueue(std::vector<UnsignedInt>& data) const { data.assign(m_data.begin(), m_data.end()); }
+	void setQueue(const std::vector<UnsignedInt>& data) { m_data.assign(data.begin(), data.end()); }
 
 	UnsignedInt getLocalPlayer(void) { return m_localPlayer; }
 
@@ -1149,6 +1303,241 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool f
 	//DEBUG_LOG(("RecorderClass::handleCRCMessage() - Skipping CRC of %8.8X from %d (our index is %d)", newCRC, playerIndex, localPlayerIndex));
 }
 
+/**
+ * Append the checkpoint of this frame. Every few checkpoints also take a snapshot of the game state.
+ */
+void RecorderClass::recordCheckpoint(UnsignedInt frame, UnsignedInt crc)
+{
+	m_checkpoints.push_back(PlaybackCheckpoint());
+	PlaybackCheckpoint& checkpoint = m_checkpoints.back();
+	checkpoint.frame = frame;
+	checkpoint.crc = crc;
+
+	if ((frame / getCheckpointInterval()) % getSnapshotCheckpointStride(m_playbackFrameCount) != 0)
+		return;
+
+	const UnsignedInt startTime = timeGetTime();
+	if (!TheGameState->saveToBuffer(checkpoint.snapshot))
+		return;
+
+	GetGameLogicRandomState(checkpoint.randomState);
+	checkpoint.filePosition = m_file->position();
+	checkpoint.nextFrame = m_nextFrame;
+	m_crcInfo->getQueue(checkpoint.crcQueue);
+
+	DEBUG_LOG(("RecorderClass::recordCheckpoint() - Saved a snapshot of %d bytes at frame %d in %d ms",
+		(Int)checkpoint.snapshot.size(), frame, timeGetTime() - startTime));
+}
+
+/**
+ * Load the snapshot of the checkpoint and continue the playback from it. Stops the playback if the snapshot
+ * cannot be loaded, because the failed load has cleared the game.
+ */
+Bool RecorderClass::restoreCheckpoint(const PlaybackCheckpoint& checkpoint)
+{
+	const UnsignedInt startTime = timeGetTime();
+
+	Bool loaded;
+	{
+		LatchRestore<Bool> restoring(m_restoringCheckpoint, TRUE);
+		loaded = TheGameState->loadFromBuffer(checkpoint.snapshot);
+	}
+
+	if (!loaded)
+	{
+		DEBUG_LOG(("RecorderClass::restoreCheckpoint() - Failed to load the snapshot of frame %d", checkpoint.frame));
+		endSeek();
+		stopPlayback();
+		return FALSE;
+	}
+
+	SetGameLogicRandomState(checkpoint.randomState);
+	m_crcInfo->setQueue(checkpoint.crcQueue);
+
+	// The next command is the first one at or after the restored frame. The replay index finds it, the
+	// position stored with the checkpoint is only used for a replay without an index.
+	const size_t next = findFirstCommand(m_playbackIndex, checkpoint.frame);
+	if (next < m_playbackIndex.size())
+	{
+		const ReplayIndexEntry& entry = m_playbackIndex[next];
+		DEBUG_ASSERTCRASH(entry.fileOffset + sizeof(m_nextFrame) == (UnsignedInt)checkpoint.filePosition && entry.frame == checkpoint.nextFrame,
+			("RecorderClass::restoreCheckpoint() - The replay index and the checkpoint disagree about the next command"));
+		m_file->seek(entry.fileOffset + sizeof(m_nextFrame), File::seekMode::START);
+		m_nextFrame = entry.frame;
+#if defined(RTS_DEBUG)
+		m_playbackIndexCheck = next;
+#endif
+	}
+	else
+	{
+		m_file->seek(checkpoint.filePosition, File::seekMode::START);
+		m_nextFrame = checkpoint.nextFrame;
+	}
+
+	DEBUG_LOG(("RecorderClass::restoreCheckpoint() - Restored frame %d in %d ms", checkpoint.frame, timeGetTime() - startTime));
+	return TRUE;
+}
+
+/**
+ * Returns the path of the index file that belongs to the replay file at the path.
+ */
+static AsciiString replayPathToIndexPath(AsciiString path)
+{
+	const AsciiString replayExtention = RecorderClass::getReplayExtention();
+	if (path.endsWithNoCase(replayExtention))
+		path.truncateBy(replayExtention.getLength());
+	path.concat(RecorderClass::getReplayIndexExtention());
+	return path;
+}
+
+/**
+ * Returns the path of the index file of a replay file in the replay directory.
+ */
+AsciiString RecorderClass::getReplayIndexPath(AsciiString filename)
+{
+	AsciiString path = getReplayDir();
+	path.concat(filename);
+	return replayPathToIndexPath(path);
+}
+
+/**
+ * Copies the index of a replay file next to a copy of the replay. CopyFile keeps the write time of the replay,
+ * which the copied index is checked against. If there is no index to copy, it is built when a playback needs it.
+ */
+void RecorderClass::copyReplayIndex(AsciiString fromReplayPath, AsciiString toReplayPath)
+{
+	const AsciiString fromIndexPath = replayPathToIndexPath(fromReplayPath);
+	const AsciiString toIndexPath = replayPathToIndexPath(toReplayPath);
+	if (!CopyFile(fromIndexPath.str(), toIndexPath.str(), FALSE))
+		DEBUG_LOG(("RecorderClass::copyReplayIndex - Failed to copy %s to %s", fromIndexPath.str(), toIndexPath.str()));
+}
+
+/**
+ * Decodes all command records of a replay file and writes the index file for it. The index stores the
+ * size and write time of the replay, so it can tell when it no longer matches the replay.
+ */
+Bool RecorderClass::buildReplayIndex(AsciiString filename)
+{
+	if (m_file != nullptr)
+		return FALSE;
+
+	ReplayHeader header;
+	header.forPlayback = TRUE;
+	header.filename = filename;
+	if (!readReplayHeader(header))
+		return FALSE;
+
+	// Skip the difficulty, original game mode, rank points and max fps that playbackFile reads.
+	m_currentFilePosition = m_file->seek(4 * sizeof(Int), File::seekMode::CURRENT);
+
+	ReplayIndex index;
+	ReplayIndexEntry entry;
+	while (readNextIndexEntry(entry))
+		index.push_back(entry);
+
+	m_file->close();
+	m_file = nullptr;
+	m_currentFilePosition = 0;
+	m_gameInfo.endGame();
+	m_gameInfo.reset();
+
+	AsciiString replayPath = getReplayDir();
+	replayPath.concat(filename);
+	FileInfo replayInfo;
+	if (!TheFileSystem->getFileInfo(replayPath, &replayInfo))
+		return FALSE;
+
+	File *file = TheFileSystem->openFile(getReplayIndexPath(filename).str(), File::WRITE | File::BINARY);
+	if (file == nullptr)
+		return FALSE;
+
+	const Int64 replaySize = replayInfo.size();
+	const Int64 replayTime = replayInfo.timestamp();
+	const UnsignedInt count = (UnsignedInt)index.size();
+	file->write(s_genrpi, sizeof(s_genrpi) - 1);
+	file->write(&replayIndexVersion, sizeof(replayIndexVersion));
+	file->write(&replaySize, sizeof(replaySize));
+	file->write(&replayTime, sizeof(replayTime));
+	file->write(&count, sizeof(count));
+	if (count > 0)
+		file->write(&index[0], count * sizeof(ReplayIndexEntry));
+	file->close();
+
+	DEBUG_LOG(("RecorderClass::buildReplayIndex - Indexed %d commands of %s", count, filename.str()));
+	return TRUE;
+}
+
+/**
+ * Reads the index of a replay file. Fails if there is no index or if the replay changed since it was built.
+ */
+Bool RecorderClass::readReplayIndex(AsciiString filename, ReplayIndex& index)
+{
+	index.clear();
+
+	AsciiString replayPath = getReplayDir();
+	replayPath.concat(filename);
+	FileInfo replayInfo;
+	if (!TheFileSystem->getFileInfo(replayPath, &replayInfo))
+		return FALSE;
+
+	File *file = TheFileSystem->openFile(getReplayIndexPath(filename).str(), File::READ | File::BINARY);
+	if (file == nullptr)
+		return FALSE;
+
+	char genrpi[sizeof(s_genrpi) - 1] = {0};
+	UnsignedInt version = 0;
+	Int64 replaySize = 0;
+	Int64 replayTime = 0;
+	UnsignedInt count = 0;
+	file->read(genrpi, sizeof(genrpi));
+	file->read(&version, sizeof(version));
+	file->read(&replaySize, sizeof(replaySize));
+	file->read(&replayTime, sizeof(replayTime));
+	file->read(&count, sizeof(count));
+
+	// Every command record is larger than its entry, which bounds the entry count of a broken index.
+	Bool valid = strncmp(genrpi, s_genrpi, sizeof(genrpi)) == 0 &&
+		version == replayIndexVersion &&
+		replaySize == replayInfo.size() &&
+		replayTime == replayInfo.timestamp() &&
+		count <= replaySize / sizeof(ReplayIndexEntry);
+
+	if (valid && count > 0)
+	{
+		index.resize(count);
+		const Int bytes = count * sizeof(ReplayIndexEntry);
+		valid = file->read(&index[0], bytes) == bytes;
+	}
+	file->close();
+
+	if (!valid)
+	{
+		DEBUG_LOG(("RecorderClass::readReplayIndex - The index of %s is missing or out of date", filename.str()));
+		index.clear();
+	}
+	return valid;
+}
+
+struct ReplayIndexEntryFrameLess
+{
+	Bool operator()(const RecorderClass::ReplayIndexEntry& entry, UnsignedInt frame) const { return entry.frame < frame; }
+};
+
+size_t RecorderClass::findFirstCommand(const ReplayIndex& index, UnsignedInt frame)
+{
+	return std::lower_bound(index.begin(), index.end(), frame, ReplayIndexEntryFrameLess()) - index.begin();
+}
+
+void RecorderClass::findPlayerCommands(const ReplayIndex& index, Int playerIndex, std::vector<UnsignedInt>& fileOffsets)
+{
+	fileOffsets.clear();
+	for (ReplayIndex::const_iterator it = index.begin(); it != index.end(); ++it)
+	{
+		if (it->playerIndex == playerIndex)
+			fileOffsets.push_back(it->fileOffset);
+	}
+}
+
 /**
  * Returns true if this version of the file is the same as our version of the game
  */
@@ -1194,6 +1583,15 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	m_mode = RECORDERMODETYPE_PLAYBACK;
 
+	// TheSuperHackers @performance 19/10/2026 Checkpoint restores find the next command in the replay index.
+	// A replay without an index or with an outdated one is indexed here, before the playback opens it.
+	m_playbackIndex.clear();
+	if (!m_doingAnalysis && !readReplayIndex(filename, m_playbackIndex) && buildReplayIndex(filename))
+		readReplayIndex(filename, m_playbackIndex);
+#if defined(RTS_DEBUG)
+	m_playbackIndexCheck = 0;
+#endif
+
 	ReplayHeader header;
 	header.forPlayback = TRUE;
 	header.filename = filename;
@@ -1306,6 +1704,18 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	m_currentReplayFilename = filename;
 	m_playbackFrameCount = header.frameCount;
+
+	if (m_checkpointReplayFilename != filename
+		|| m_checkpointReplayStartTime != header.startTime
+		|| m_checkpointReplayFrameCount != header.frameCount)
+	{
+		m_checkpoints.clear();
+		m_checkpoints.reserve(m_playbackFrameCount / getCheckpointInterval() + 1);
+		m_checkpointReplayFilename = filename;
+		m_checkpointReplayStartTime = header.startTime;
+		m_checkpointReplayFrameCount = header.frameCount;
+	}
+	m_checkpointMismatchFrame = 0;
 	return TRUE;
 }
 
@@ -1382,6 +1792,9 @@ void RecorderClass::readNextFrame() {
  * This reads the next command from the replay file and appends it to TheCommandList.
  */
 void RecorderClass::appendNextCommand() {
+#if defined(RTS_DEBUG)
+	const Int recordOffset = m_file->position() - (Int)sizeof(m_nextFrame);
+#endif
 	GameMessage::Type type;
 	Int bytesRead = m_file->read(&type, sizeof(type));
 	if (bytesRead != sizeof(type)) {
@@ -1407,6 +1820,10 @@ void RecorderClass::appendNextCommand() {
 	m_file->read(&playerIndex, sizeof(playerIndex));
 	msg->friend_setPlayerIndex(playerIndex);
 
+#if defined(RTS_DEBUG)
+	checkReplayIndexEntry(recordOffset, m_nextFrame, playerIndex);
+#endif
+
 	// don't debug log this if we're debugging sync errors, as it will cause diff problems between a game and it's replay...
 #ifdef DEBUG_LOGGING
 	Bool logCommand = true;
@@ -1475,6 +1892,84 @@ void RecorderClass::appendNextCommand() {
 	parser = nullptr;
 }
 
+/**
+ * Returns the size of an argument in the replay file, matching what readArgument reads.
+ */
+static Int getArgumentSize(GameMessageArgumentDataType type)
+{
+	switch (type) {
+		case ARGUMENTDATATYPE_INTEGER: return sizeof(Int);
+		case ARGUMENTDATATYPE_REAL: return sizeof(Real);
+		case ARGUMENTDATATYPE_BOOLEAN: return sizeof(Bool);
+		case ARGUMENTDATATYPE_OBJECTID: return sizeof(ObjectID);
+		case ARGUMENTDATATYPE_DRAWABLEID: return sizeof(DrawableID);
+		case ARGUMENTDATATYPE_TEAMID: return sizeof(UnsignedInt);
+		case ARGUMENTDATATYPE_LOCATION: return sizeof(Coord3D);
+		case ARGUMENTDATATYPE_PIXEL: return sizeof(ICoord2D);
+		case ARGUMENTDATATYPE_PIXELREGION: return sizeof(IRegion2D);
+		case ARGUMENTDATATYPE_TIMESTAMP: return sizeof(UnsignedInt);
+		case ARGUMENTDATATYPE_WIDECHAR: return sizeof(WideChar);
+		default: return 0;
+	}
+}
+
+#if defined(RTS_DEBUG)
+/**
+ * Check the replay index entry of the command record that the playback decodes. The index is built by
+ * readNextIndexEntry, which must read over exactly the same record bytes as appendNextCommand.
+ */
+void RecorderClass::checkReplayIndexEntry(Int fileOffset, UnsignedInt frame, Int playerIndex) {
+	if (m_playbackIndex.empty())
+		return;
+
+	const size_t index = m_playbackIndexCheck++;
+	DEBUG_ASSERTCRASH(index < m_playbackIndex.size() &&
+		m_playbackIndex[index].fileOffset == (UnsignedInt)fileOffset &&
+		m_playbackIndex[index].frame == frame &&
+		m_playbackIndex[index].playerIndex == playerIndex,
+		("RecorderClass::checkReplayIndexEntry - Index entry %d does not match the command at offset %d on frame %d",
+		(Int)index, fileOffset, frame));
+}
+#endif
+
+/**
+ * Reads the frame and player of the command record at m_currentFilePosition and reads over its arguments.
+ * Returns false at the end of the file or on a truncated record.
+ */
+Bool RecorderClass::readNextIndexEntry(ReplayIndexEntry& entry) {
+	GameMessage::Type type;
+	UnsignedByte numTypes = 0;
+	entry.fileOffset = m_currentFilePosition;
+	if (m_file->read(&entry.frame, sizeof(entry.frame)) != sizeof(entry.frame) ||
+			m_file->read(&type, sizeof(type)) != sizeof(type) ||
+			m_file->read(&entry.playerIndex, sizeof(entry.playerIndex)) != sizeof(entry.playerIndex) ||
+			m_file->read(&numTypes, sizeof(numTypes)) != sizeof(numTypes)) {
+		return FALSE;
+	}
+
+	Int argumentBytes = 0;
+	for (UnsignedByte i = 0; i < numTypes; ++i) {
+		UnsignedByte argType = (UnsignedByte)ARGUMENTDATATYPE_UNKNOWN;
+		UnsignedByte numArgs = 0;
+		if (m_file->read(&argType, sizeof(argType)) != sizeof(argType) ||
+				m_file->read(&numArgs, sizeof(numArgs)) != sizeof(numArgs)) {
+			return FALSE;
+		}
+		argumentBytes += getArgumentSize((GameMessageArgumentDataType)argType) * numArgs;
+	}
+	m_currentFilePosition += sizeof(entry.frame) + sizeof(type) + sizeof(entry.playerIndex) + sizeof(numTypes) + 2 * numTypes + argumentBytes;
+
+	// Read over the arguments instead of seeking past them, which keeps the read buffer of the file.
+	UnsignedByte skipBuffer[256];
+	while (argumentBytes > 0) {
+		const Int bytes = min(argumentBytes, (Int)sizeof(skipBuffer));
+		if (m_file->read(skipBuffer, bytes) != bytes)
+			return FALSE;
+		argumentBytes -= bytes;
+	}
+	return TRUE;
+}
+
 void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *msg) {
 	switch (type) {
 		case ARGUMENTDATATYPE_INTEGER: {
@@ -1673,6 +2168,13 @@ AsciiString RecorderClass::getReplayExtention() {
 	return AsciiString(replayExtention);
 }
 
+/**
+ * returns the file extension for the replay index files.
+ */
+AsciiString RecorderClass::getReplayIndexExtention() {
+	return AsciiString(replayIndexExtention);
+}
+
 /**
  * returns the file name used for the replay file that is recorded to.
  */
@@ -319,6 +319,11 @@ Drawable::Drawable( const ThingTemplate *thingTemplate, DrawableStatusBits statu
 	m_nextDrawable = nullptr;
 	m_prevDrawable = nullptr;
 
+	m_nextInGridCell = nullptr;
+	m_prevInGridCell = nullptr;
+	m_gridCell = -1;
+	m_listOrder = 0;
+
 	// register drawable with the GameClient ... do this first before we start doing anything
 	// complex that uses any of the drawable data so that we have and ID!!  It's ok to initialize
 	// members of the drawable before this registration happens
@@ -3682,6 +3687,9 @@ void Drawable::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* old
 	{
 		(*dm)->reactToTransformChange(oldMtx, oldPos, oldAngle);
 	}
+
+	if (m_gridCell >= 0)
+		TheGameClient->updateDrawableGridCell(this);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3973,6 +3981,37 @@ void Drawable::removeFromList(Drawable **pListHead)
 		*pListHead = m_nextDrawable;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** add self to the linked list of a GameClient grid cell */
+//-------------------------------------------------------------------------------------------------
+void Drawable::prependToGridCell(Drawable **pCellHead, Int cell)
+{
+	m_prevInGridCell = nullptr;
+	m_nextInGridCell = *pCellHead;
+	if (*pCellHead)
+		(*pCellHead)->m_prevInGridCell = this;
+	*pCellHead = this;
+	m_gridCell = cell;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** remove self from the linked list of a GameClient grid cell */
+//-------------------------------------------------------------------------------------------------
+void Drawable::removeFromGridCell(Drawable **pCellHead)
+{
+	if (m_nextInGridCell)
+		m_nextInGridCell->m_prevInGridCell = m_prevInGridCell;
+
+	if (m_prevInGridCell)
+		m_prevInGridCell->m_nextInGridCell = m_nextInGridCell;
+	else
+		*pCellHead = m_nextInGridCell;
+
+	m_nextInGridCell = nullptr;
+	m_prevInGridCell = nullptr;
+	m_gridCell = -1;
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void Drawable::updateHiddenStatus()
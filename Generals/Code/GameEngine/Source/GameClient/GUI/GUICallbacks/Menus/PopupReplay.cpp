@@ -321,6 +321,9 @@ void reallySaveReplay(void)
 		return;
 	}
 
+	// TheSuperHackers @performance 19/10/2026 Keep the replay index with the saved replay
+	RecorderClass::copyReplayIndex(oldFilename, filename);
+
 	// get the listbox that will have the save games in it
 	GameWindow *listboxGames = TheWindowManager->winGetWindowFromId( parent, listboxGamesKey );
 	DEBUG_ASSERTCRASH( listboxGames != nullptr, ("reallySaveReplay - Unable to find games listbox") );
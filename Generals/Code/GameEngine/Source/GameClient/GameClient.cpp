@@ -40,6 +40,7 @@
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
+#include "Common/Recorder.h"
 #include "Common/ThingFactory.h"
 #include "Common/ThingTemplate.h"
 #include "Common/Xfer.h"
@@ -85,6 +86,8 @@
 
 #define DRAWABLE_HASH_SIZE	8192
 
+static const Real DRAWABLE_GRID_CELL_SIZE = 100.0f;
+
 /// The GameClient singleton instance
 GameClient *TheGameClient = nullptr;
 
@@ -104,6 +107,9 @@ GameClient::GameClient()
 	m_frame = 0;
 
 	m_drawableList = nullptr;
+	for( Int c = 0; c < DRAWABLE_GRID_SIZE * DRAWABLE_GRID_SIZE; ++c )
+		m_drawableGrid[ c ] = nullptr;
+	m_drawableListOrder = 0;
 
 	m_nextDrawableID = (DrawableID)1;
 	TheDrawGroupInfo = new DrawGroupInfo;
@@ -479,6 +485,11 @@ void GameClient::registerDrawable( Drawable *draw )
 
 	// add the drawable to the master list
 	draw->prependToList( &m_drawableList );
+	draw->setListOrder( ++m_drawableListOrder );
+
+	// add the drawable to the grid
+	const Int cell = getDrawableGridCell( draw->getPosition() );
+	draw->prependToGridCell( &m_drawableGrid[ cell ], cell );
 
 }
 
@@ -694,6 +705,12 @@ void GameClient::update( void )
 	}
 #endif
 
+	// TheSuperHackers @performance 19/10/2026 Do not draw while a replay playback fast forwards to a seek frame.
+	if (TheRecorder->isSeeking() && TheGameLogic->getFrame() > 0)
+	{
+		return;
+	}
+
 	// update all particle systems
 	if( !freezeTime )
 	{
@@ -755,26 +772,120 @@ void GameClient::updateHeadless()
 	TheParticleSystemManager->reset();
 }
 
+/** -----------------------------------------------------------------------------------------------
+ * Return the unwrapped grid coordinate of a world coordinate.
+ */
+Int GameClient::getDrawableGridCoord( Real v )
+{
+	// keep the conversion to int in range, NaN goes to the low limit
+	const Real limit = 1.0e7f;
+	if( !(v > -limit) )
+		v = -limit;
+	else if( v > limit )
+		v = limit;
+
+	return REAL_TO_INT_FLOOR( v / DRAWABLE_GRID_CELL_SIZE );
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Return the grid cell of a world position.
+ */
+Int GameClient::getDrawableGridCell( const Coord3D *pos )
+{
+	const Int x = getDrawableGridCoord( pos->x ) & (DRAWABLE_GRID_SIZE - 1);
+	const Int y = getDrawableGridCoord( pos->y ) & (DRAWABLE_GRID_SIZE - 1);
+	return y * DRAWABLE_GRID_SIZE + x;
+}
+
+/** -----------------------------------------------------------------------------------------------
+ * Move the drawable to the grid cell of its current position.
+ */
+void GameClient::updateDrawableGridCell( Drawable *draw )
+{
+	const Int oldCell = draw->getGridCell();
+	const Int cell = getDrawableGridCell( draw->getPosition() );
+	if( cell == oldCell || oldCell < 0 )
+		return;
+
+	draw->removeFromGridCell( &m_drawableGrid[ oldCell ] );
+	draw->prependToGridCell( &m_drawableGrid[ cell ], cell );
+}
+
+//-------------------------------------------------------------------------------------------------
+static Bool isDrawableInRegion( const Drawable *draw, const Region3D *region )
+{
+	const Coord3D *pos = draw->getPosition();
+	return pos->x >= region->lo.x && pos->x <= region->hi.x &&
+		pos->y >= region->lo.y && pos->y <= region->hi.y &&
+		pos->z >= region->lo.z && pos->z <= region->hi.z;
+}
+
+//-------------------------------------------------------------------------------------------------
+static bool isBeforeInDrawableList( const Drawable *a, const Drawable *b )
+{
+	return a->getListOrder() > b->getListOrder();
+}
+
 /** -----------------------------------------------------------------------------------------------
  * Call the given callback function for each object contained within the given region.
+ * The drawables are visited in the order of the drawable list.
  */
 void GameClient::iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr userFunc, void *userData )
 {
 	Drawable *draw, *nextDrawable;
 
-	for( draw = m_drawableList; draw; draw=nextDrawable )
+	Int x0 = 0;
+	Int y0 = 0;
+	Int numX = DRAWABLE_GRID_SIZE;
+	Int numY = DRAWABLE_GRID_SIZE;
+	if( region != nullptr )
 	{
-		nextDrawable = draw->getNextDrawable();
+		x0 = getDrawableGridCoord( region->lo.x );
+		y0 = getDrawableGridCoord( region->lo.y );
+		numX = min( getDrawableGridCoord( region->hi.x ) - x0 + 1, (Int)DRAWABLE_GRID_SIZE );
+		numY = min( getDrawableGridCoord( region->hi.y ) - y0 + 1, (Int)DRAWABLE_GRID_SIZE );
+		if( numX <= 0 || numY <= 0 )
+			return;
+	}
+
+	// the region covers the whole grid, walk the list
+	if( numX == DRAWABLE_GRID_SIZE && numY == DRAWABLE_GRID_SIZE )
+	{
+		for( draw = m_drawableList; draw; draw=nextDrawable )
+		{
+			nextDrawable = draw->getNextDrawable();
 
-		Coord3D pos = *draw->getPosition();
-		if( region == nullptr ||
-			  (pos.x >= region->lo.x && pos.x <= region->hi.x &&
-			   pos.y >= region->lo.y && pos.y <= region->hi.y &&
-				 pos.z >= region->lo.z && pos.z <= region->hi.z) )
+			if( region == nullptr || isDrawableInRegion( draw, region ) )
+			{
+				(*userFunc)( draw, userData );
+			}
+		}
+		return;
+	}
+
+	// TheSuperHackers @performance 19/10/2026 Gather the drawables from the grid cells of the region.
+	// The callbacks are made after gathering, so they may move drawables between cells.
+	DrawablePtrVector drawables;
+	for( Int y = 0; y < numY; ++y )
+	{
+		const Int row = ((y0 + y) & (DRAWABLE_GRID_SIZE - 1)) * DRAWABLE_GRID_SIZE;
+		for( Int x = 0; x < numX; ++x )
 		{
-			(*userFunc)( draw, userData );
+			const Int cell = row + ((x0 + x) & (DRAWABLE_GRID_SIZE - 1));
+			for( draw = m_drawableGrid[ cell ]; draw; draw = draw->getNextInGridCell() )
+			{
+				if( isDrawableInRegion( draw, region ) )
+					drawables.push_back( draw );
+			}
 		}
 	}
+
+	std::sort( drawables.begin(), drawables.end(), isBeforeInDrawableList );
+
+	for( DrawablePtrVector::iterator it = drawables.begin(); it != drawables.end(); ++it )
+	{
+		(*userFunc)( *it, userData );
+	}
 }
 
 /**Helper function to update fake GLA structures to become visible to certain players.
@@ -812,6 +923,8 @@ void GameClient::destroyDrawable( Drawable *draw )
 
 	// remove from the master list
 	draw->removeFromList(&m_drawableList);
+	if (draw->getGridCell() >= 0)
+		draw->removeFromGridCell(&m_drawableGrid[draw->getGridCell()]);
 
 	//
 	// because drawables and objects are tightly coupled, not only MUST we maintain
@@ -1030,6 +1143,19 @@ void GameClient::allocateShadows(void)
 		draw->allocateShadows();
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Preload the samples of all the sounds of a thing template */
+//-------------------------------------------------------------------------------------------------
+static void preloadTemplateAudio( const ThingTemplate *tTemplate )
+{
+	for( Int i = 0; i < TTAUDIO_COUNT; ++i )
+		TheAudio->preloadAudioEvent( tTemplate->getAudio( (ThingTemplateAudioType)i ) );
+
+	const PerUnitSoundMap *perUnitSounds = tTemplate->getAllPerUnitSounds();
+	for( PerUnitSoundMap::const_iterator it = perUnitSounds->begin(); it != perUnitSounds->end(); ++it )
+		TheAudio->preloadAudioEvent( &it->second );
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Preload assets for the currently loaded map.  Those assets include all the damage states
 	* for every building loaded, as well as any faction units/structures we can build and
@@ -1044,7 +1170,10 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 	// first, for every drawable in the map load the assets for all states we care about
 	Drawable *draw;
 	for( draw = firstDrawable(); draw; draw = draw->getNextDrawable() )
+	{
 		draw->preloadAssets( timeOfDay );
+		preloadTemplateAudio( draw->getTemplate() );
+	}
 
 	//
 	// now create a temporary drawable for each of the faction things we can create, preload
@@ -1068,6 +1197,7 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 
 			// preload the assets
 			draw->preloadAssets( timeOfDay );
+			preloadTemplateAudio( tTemplate );
 
 			// destroy the drawable
 			destroyDrawable( draw );
@@ -646,7 +646,7 @@ void InGameUI::objectChangedTeam(const Object *obj, Int oldPlayerIndex, Int newP
 	{
 		ObjectID id = obj->getID();
 		AsciiString powerName;
-		for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+		for (BehaviorModule** m = obj->getSpecialPowerModules(); *m; ++m)
 		{
 			SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 			if (!sp)
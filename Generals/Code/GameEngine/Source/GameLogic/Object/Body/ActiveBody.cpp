@@ -466,7 +466,7 @@ void ActiveBody::attemptDamage( DamageInfo *damageInfo )
 		// if our health has gone down then do run the damage module callback
 		if( m_currentHealth < m_prevHealth )
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -478,7 +478,7 @@ void ActiveBody::attemptDamage( DamageInfo *damageInfo )
 
 		if (m_curDamageState != oldState)
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -601,7 +601,7 @@ void ActiveBody::attemptHealing( DamageInfo *damageInfo )
 		// if our health has gone UP then do run the damage module callback
 		if( m_currentHealth > m_prevHealth )
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -613,7 +613,7 @@ void ActiveBody::attemptHealing( DamageInfo *damageInfo )
 
 		if (m_curDamageState != oldState)
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -133,6 +133,10 @@ static const ModelConditionFlags s_allWeaponFireFlags[WEAPONSLOT_COUNT] =
 	)
 };
 
+// ------------------------------------------------------------------------------------------------
+/// the module lists of objects without modules of that kind, or with no lookups built
+static BehaviorModule* s_noModules[1] = { nullptr };
+
 //-------------------------------------------------------------------------------------------------
 extern void addIcon(const Coord3D *pos, Real width, Int numFramesDuration, RGBColor color);
 
@@ -175,6 +179,9 @@ Object::Object( const ThingTemplate *tt, const ObjectStatusMaskType &objectStatu
 	m_xferContainedByID(INVALID_ID),
 	m_containedByFrame(0),
 	m_behaviors(nullptr),
+	m_moduleListStorage(nullptr),
+	m_moduleNameKeys(nullptr),
+	m_moduleNameKeyCount(0),
 	m_body(nullptr),
 	m_contain(nullptr),
 	m_stealth(nullptr),
@@ -220,6 +227,11 @@ Object::Object( const ThingTemplate *tt, const ObjectStatusMaskType &objectStatu
 		m_disabledTillFrame[ i ] = NEVER;
 	}
 
+	for( i = 0; i < MODULE_LIST_COUNT; i++ )
+	{
+		m_moduleLists[ i ] = s_noModules;
+	}
+
 	// sanity
 	if( TheGameLogic == nullptr || tt == nullptr )
 	{
@@ -382,6 +394,8 @@ Object::Object( const ThingTemplate *tt, const ObjectStatusMaskType &objectStatu
 
 	*curB = nullptr;
 
+	buildModuleLookups();
+
 	AIUpdateInterface *ai = getAIUpdateInterface();
 	if (ai) {
 		ai->setAttitude(getTeam()->getPrototype()->getTemplateInfo()->m_initialTeamAttitude);
@@ -476,7 +490,7 @@ void Object::initObject()
 
 	//For each special power module that we have, add it's type to the specialpower bits. This is
 	//for optimal access later.
-	for (BehaviorModule** m = m_behaviors; *m; ++m)
+	for (BehaviorModule** m = getSpecialPowerModules(); *m; ++m)
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if (!sp)
@@ -563,6 +577,9 @@ Object::~Object()
 	m_ai = nullptr;
 	m_physics = nullptr;
 
+	// the lookups must not hand out deleted modules
+	freeModuleLookups();
+
 	// delete any modules present
 	for (BehaviorModule** b = m_behaviors; *b; ++b)
 	{
@@ -2110,7 +2127,7 @@ void Object::checkDisabledStatus()
 //-------------------------------------------------------------------------------------------------
 void Object::pauseAllSpecialPowers( const Bool disabling ) const
 {
-	for (BehaviorModule** m = m_behaviors; *m; ++m)
+	for (BehaviorModule** m = getSpecialPowerModules(); *m; ++m)
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if (!sp)
@@ -2144,7 +2161,7 @@ void Object::updateTriggerAreaFlags()
 //-------------------------------------------------------------------------------------------------
 void Object::onCollide( Object *other, const Coord3D *loc, const Coord3D *normal )
 {
-	for (BehaviorModule** m = m_behaviors; *m; ++m)
+	for (BehaviorModule** m = getCollideModules(); *m; ++m)
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if (!collide)
@@ -2168,7 +2185,7 @@ void Object::onCollide( Object *other, const Coord3D *loc, const Coord3D *normal
 //-------------------------------------------------------------------------------------------------
 Bool Object::isSalvageCrate() const
 {
-	for( BehaviorModule** m = m_behaviors; *m; ++m )
+	for( BehaviorModule** m = getCollideModules(); *m; ++m )
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if( collide && collide->isSalvageCrateCollide() )
@@ -2192,7 +2209,7 @@ void Object::updateUpgradeModules()
 	// We need to add in all of the already owned upgrades to handle "AND" requiring upgrades.
 	// We combine all the masks in case someone has a Object AND Player combination
 
-	for (BehaviorModule** module = m_behaviors; *module; ++module)
+	for (BehaviorModule** module = getUpgradeModules(); *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
 		if (!upgrade)
@@ -2215,7 +2232,7 @@ void Object::updateUpgradeModules()
 //-------------------------------------------------------------------------------------------------
 void Object::forceRefreshSubObjectUpgradeStatus()
 {
-	for (BehaviorModule** module = m_behaviors; *module; ++module)
+	for (BehaviorModule** module = getUpgradeModules(); *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
 		if (!upgrade)
@@ -2608,29 +2625,140 @@ Module* Object::findModule(NameKeyType key) const
 {
 	Module* m = nullptr;
 
-	for (BehaviorModule** b = m_behaviors; *b; ++b)
+	if (m_moduleNameKeys == nullptr)
 	{
-		if ((*b)->getModuleNameKey() == key)
+		// the lookup is not built yet or already freed
+		for (BehaviorModule** b = m_behaviors; b && *b; ++b)
 		{
-#ifdef INTENSE_DEBUG
-			if (m == nullptr)
+			if ((*b)->getModuleNameKey() == key)
 			{
 				m = *b;
+				break;
 			}
-			else
-			{
-				DEBUG_CRASH(("Duplicate modules found for name %s!",TheNameKeyGenerator->keyToName(key).str()));
-			}
-#else
-			m = *b;
-			break;
-#endif
 		}
+		return m;
+	}
+
+	// binary search for the first entry with the key, which is the first such module in m_behaviors
+	Int lo = 0;
+	Int hi = m_moduleNameKeyCount;
+	while (lo < hi)
+	{
+		const Int mid = (lo + hi) / 2;
+		if (m_moduleNameKeys[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < m_moduleNameKeyCount && m_moduleNameKeys[lo].key == key)
+	{
+		m = m_moduleNameKeys[lo].module;
+#ifdef INTENSE_DEBUG
+		if (lo + 1 < m_moduleNameKeyCount && m_moduleNameKeys[lo + 1].key == key)
+		{
+			DEBUG_CRASH(("Duplicate modules found for name %s!",TheNameKeyGenerator->keyToName(key).str()));
+		}
+#endif
 	}
 
 	return m;
 }
 
+//-------------------------------------------------------------------------------------------------
+Bool Object::isModuleInList(BehaviorModule* module, Int list)
+{
+	switch (list)
+	{
+		case MODULE_LIST_COLLIDE: return module->getCollide() != nullptr;
+		case MODULE_LIST_DAMAGE: return module->getDamage() != nullptr;
+		case MODULE_LIST_DIE: return module->getDie() != nullptr;
+		case MODULE_LIST_SPECIAL_POWER: return module->getSpecialPower() != nullptr;
+		case MODULE_LIST_UPGRADE: return module->getUpgrade() != nullptr;
+	}
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Builds the per interface module lists and the name key lookup. The modules never change
+ * after construction, so this is done once. */
+//-------------------------------------------------------------------------------------------------
+void Object::buildModuleLookups()
+{
+	Int numModules = 0;
+	Int listCounts[MODULE_LIST_COUNT];
+	Int list;
+	for (list = 0; list < MODULE_LIST_COUNT; ++list)
+		listCounts[list] = 0;
+
+	BehaviorModule** b;
+	for (b = m_behaviors; *b; ++b)
+	{
+		++numModules;
+		for (list = 0; list < MODULE_LIST_COUNT; ++list)
+		{
+			if (isModuleInList(*b, list))
+				++listCounts[list];
+		}
+	}
+
+	Int storageSize = MODULE_LIST_COUNT;
+	for (list = 0; list < MODULE_LIST_COUNT; ++list)
+		storageSize += listCounts[list];
+
+	m_moduleListStorage = MSGNEW("ModulePtrs") BehaviorModule*[storageSize];
+	BehaviorModule** listEnds[MODULE_LIST_COUNT];
+	BehaviorModule** cur = m_moduleListStorage;
+	for (list = 0; list < MODULE_LIST_COUNT; ++list)
+	{
+		m_moduleLists[list] = cur;
+		listEnds[list] = cur;
+		cur += listCounts[list];
+		*cur++ = nullptr;
+	}
+
+	for (b = m_behaviors; *b; ++b)
+	{
+		for (list = 0; list < MODULE_LIST_COUNT; ++list)
+		{
+			if (isModuleInList(*b, list))
+				*listEnds[list]++ = *b;
+		}
+	}
+
+	// stable insertion sort, so equal keys keep the module order and findModule returns the first
+	m_moduleNameKeys = MSGNEW("ModulePtrs") ModuleNameKeyEntry[numModules > 0 ? numModules : 1];
+	m_moduleNameKeyCount = 0;
+	for (b = m_behaviors; *b; ++b)
+	{
+		ModuleNameKeyEntry entry;
+		entry.key = (*b)->getModuleNameKey();
+		entry.module = *b;
+
+		Int i = m_moduleNameKeyCount++;
+		while (i > 0 && m_moduleNameKeys[i - 1].key > entry.key)
+		{
+			m_moduleNameKeys[i] = m_moduleNameKeys[i - 1];
+			--i;
+		}
+		m_moduleNameKeys[i] = entry;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void Object::freeModuleLookups()
+{
+	for (Int list = 0; list < MODULE_LIST_COUNT; ++list)
+		m_moduleLists[list] = s_noModules;
+
+	delete [] m_moduleListStorage;
+	m_moduleListStorage = nullptr;
+
+	delete [] m_moduleNameKeys;
+	m_moduleNameKeys = nullptr;
+	m_moduleNameKeyCount = 0;
+}
+
 //-------------------------------------------------------------------------------------------------
 /**
  * Returns true if object is currently able to move.
@@ -3982,7 +4110,7 @@ Bool Object::affectedByUpgrade( const UpgradeTemplate *upgradeT ) const
 	// We need to add in all of the already owned upgrades to handle "AND" requiring upgrades.
 	// We combine all the masks in case someone has a Object AND Player combination
 
-	for (BehaviorModule** module = m_behaviors; *module; ++module)
+	for (BehaviorModule** module = getUpgradeModules(); *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
 		if (!upgrade)
@@ -4021,7 +4149,7 @@ void Object::giveUpgrade( const UpgradeTemplate *upgradeT )
 void Object::removeUpgrade( const UpgradeTemplate *upgradeT )
 {
 	m_objectUpgradesCompleted.clear( upgradeT->getUpgradeMask() );
-	for (BehaviorModule** module = m_behaviors; *module; ++module)
+	for (BehaviorModule** module = getUpgradeModules(); *module; ++module)
 	{
 		UpgradeModuleInterface* upgrade = (*module)->getUpgrade();
 		if (!upgrade)
@@ -4105,7 +4233,7 @@ void Object::onDie( DamageInfo *damageInfo )
 	Bool selfInflicted = (damageInfo->in.m_sourceID == getID());
 
 	// FIRST, call our die modules.
-	for (BehaviorModule** d = m_behaviors; *d; ++d)
+	for (BehaviorModule** d = getDieModules(); *d; ++d)
 	{
 		DieModuleInterface* die = (*d)->getDie();
 		if (die)
@@ -4698,7 +4826,7 @@ SpecialPowerModuleInterface *Object::getSpecialPowerModule( const SpecialPowerTe
 		return nullptr;
 
 	// search the modules for the one with the matching template
-	for (BehaviorModule** m = m_behaviors; *m; ++m)
+	for (BehaviorModule** m = getSpecialPowerModules(); *m; ++m)
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if (!sp)
@@ -5107,7 +5235,7 @@ DockUpdateInterface *Object::getDockUpdateInterface( void )
 // ------------------------------------------------------------------------------------------------
 SpecialPowerModuleInterface* Object::findSpecialPowerModuleInterface( SpecialPowerType type ) const
 {
-	for (BehaviorModule** m = m_behaviors; *m; ++m)
+	for (BehaviorModule** m = getSpecialPowerModules(); *m; ++m)
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if (!sp)
@@ -5127,7 +5255,7 @@ SpecialPowerModuleInterface* Object::findSpecialPowerModuleInterface( SpecialPow
 // ------------------------------------------------------------------------------------------------
 SpecialPowerModuleInterface* Object::findAnyShortcutSpecialPowerModuleInterface() const
 {
-	for( BehaviorModule** m = m_behaviors; *m; ++m )
+	for( BehaviorModule** m = getSpecialPowerModules(); *m; ++m )
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if (!sp)
@@ -892,7 +892,7 @@ Object* AIUpdateInterface::checkForCrateToPickup()
 		Object* crate = TheGameLogic->findObjectByID(m_crateCreated);
 		if (crate)
 		{
-			for (BehaviorModule** m = crate->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = crate->getCollideModules(); *m; ++m)
 			{
 				CollideModuleInterface* collide = (*m)->getCollide();
 				if (!collide)
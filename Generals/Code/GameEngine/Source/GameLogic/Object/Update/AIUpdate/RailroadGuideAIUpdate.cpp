@@ -221,7 +221,7 @@ void RailroadBehavior::onCollide( Object *other, const Coord3D *loc, const Coord
 	if (m_endOfLine)
 		return ;
 
-	for (BehaviorModule** m = other->getBehaviorModules(); *m; ++m)
+	for (BehaviorModule** m = other->getCollideModules(); *m; ++m)
 	{
 		CollideModuleInterface* collide = (*m)->getCollide();
 		if (!collide)
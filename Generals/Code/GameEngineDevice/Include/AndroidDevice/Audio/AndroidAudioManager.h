@@ -1,39 +1,57 @@
 /*
 **  AndroidAudioManager.h
-**  Oboe-based AudioManager implementation for Android with PCM mixing.
+**  Oboe-based AudioManager implementation for Android, mixed by StdAudioMixer.
 */
 
 #pragma once
 
 #include "Common/GameAudio.h"
 #include "Common/AsciiString.h"
+#include "StdDevice/Audio/StdAudioMixer.h"
 #include <oboe/Oboe.h>
+#include <atomic>
+#include <chrono>
 #include <vector>
-#include <mutex>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <cstdint>
 
 // ---------------------------------------------------------------------------
-// AndroidPlayingAudio — represents a single audio source being mixed
+// AndroidSampleData — decoded PCM of one sound file, shared by all sources
+// playing it and by the sample cache
+// ---------------------------------------------------------------------------
+struct AndroidSampleData
+{
+    std::vector<int16_t> m_pcm;                 // 16-bit signed, interleaved
+    int                  m_channels    = 1;
+    int                  m_sampleRate  = 44100;
+};
+
+typedef std::shared_ptr<const AndroidSampleData> AndroidSampleDataPtr;
+
+// ---------------------------------------------------------------------------
+// AndroidPlayingAudio — game thread state of a single voice of the mixer
 // ---------------------------------------------------------------------------
 struct AndroidPlayingAudio
 {
     AudioEventRTS *m_audioEventRTS = nullptr;
     AudioHandle    m_handle        = 0;
 
-    // PCM data (16-bit signed, mono or stereo, 44100 Hz)
-    int16_t       *m_pcmData       = nullptr;
-    uint32_t       m_pcmSize       = 0;   // total samples (not bytes)
-    uint32_t       m_pcmPos        = 0;   // current playback position (samples)
-    int            m_channels      = 1;   // 1=mono, 2=stereo
-    int            m_sampleRate    = 44100;
+    // PCM data, kept alive until the mixer has finished the voice
+    AndroidSampleDataPtr m_sample;
 
     float          m_volume        = 1.0f;
+    float          m_gainLeft      = 1.0f;  // gains last sent to the mixer
+    float          m_gainRight     = 1.0f;
     bool           m_looping       = false;
     bool           m_stopped       = false;
     bool           m_paused        = false;
+    bool           m_finished      = false; // the mixer no longer uses the voice
     bool           m_cleanupEvent  = true;
 
-    bool isFinished() const { return !m_looping && m_pcmPos >= m_pcmSize; }
+    bool isFinished() const { return m_finished; }
 };
 
 // ---------------------------------------------------------------------------
@@ -112,6 +130,8 @@ public:
 
     virtual void closeAnySamplesUsingFile(const void *fileToClose) override;
 
+    virtual void preloadAudioEvent(const AudioEventRTS *eventToPreload) override;
+
     // --- Oboe callbacks ---
     virtual oboe::DataCallbackResult onAudioReady(oboe::AudioStream *oboeStream, void *audioData, int32_t numFrames) override;
     virtual void onErrorAfterClose(oboe::AudioStream *oboeStream, oboe::Result error) override;
@@ -125,22 +145,44 @@ protected:
 private:
     void openStream();
     void closeStream();
+    bool startStream();
 
     // Audio source management
     void playAudioEvent(AudioEventRTS *event);
     void stopAudioEvent(AudioHandle handle);
-    int16_t *loadWavFile(const char *filename, uint32_t &outSampleCount, int &outChannels, int &outSampleRate);
+    AndroidSampleDataPtr loadWavFile(const char *filename);
     void cleanupFinishedAudio();
+    void freeSource(AndroidPlayingAudio *src);
+
+    // 3D attenuation and panning
+    void computeGains(AndroidPlayingAudio *src, float &gainLeft, float &gainRight);
+    void updateGains(AndroidPlayingAudio *src);
+
+    // Decoded sample cache (game thread only)
+    AndroidSampleDataPtr getSample(const char *filename);
+    void trimSampleCache();
 
     // Oboe stream
     std::shared_ptr<oboe::AudioStream> m_stream;
-    bool m_isStreamOpen;
+    std::atomic<bool> m_isStreamOpen;
+
+    // The mixer runs in the Oboe callback. Without a stream it renders into the
+    // null sink from update(), so that voices still finish.
+    StdAudioMixer m_mixer;
+    StdNullAudioSink m_nullSink;
+    std::chrono::steady_clock::time_point m_lastRenderTime;
 
-    // Active audio sources (accessed from both game thread and audio callback)
-    std::mutex m_audioMutex;
+    // Audio sources (game thread only)
     std::vector<AndroidPlayingAudio*> m_playingSources;
-    std::vector<AndroidPlayingAudio*> m_stoppedSources;
 
-    // Intermediate mix buffer (32-bit to avoid clipping during mixing)
-    std::vector<int32_t> m_mixBuffer;
+    // Decoded samples by filename, least recently used last. Files that failed
+    // to load are cached as null so they are not opened again on every play.
+    struct SampleCacheEntry
+    {
+        AndroidSampleDataPtr             m_sample;
+        std::list<std::string>::iterator m_lruPos;
+    };
+    std::unordered_map<std::string, SampleCacheEntry> m_sampleCache;
+    std::list<std::string> m_sampleLru;
+    size_t m_sampleCacheBytes;
 };
@@ -190,6 +190,7 @@ protected:
 		NetFPSAverages,		///< debug display all players' average fps.
 		SelectedInfo,			///< debug display for the selected object in the UI
 		TerrainStats,			///< debug display for the terrain renderer
+		TextStats,				///< debug display for the text layout work
 
 		DisplayStringCount
 	};
@@ -98,7 +98,8 @@ protected:
 	Bool m_textChanged;  ///< when contents of string change this is TRUE
 	Bool m_fontChanged;  ///< when font has chagned this is TRUE
 	UnicodeString m_hotkey;		///< holds the current hotkey marker.
-	Bool m_useHotKey;
+	Bool m_useHotKey;					///< parse the text for a hotkey
+	Bool m_drawHotKey;				///< a hotkey was found when the sentence was built
 	ICoord2D m_hotKeyPos;
 	Color m_hotKeyColor;
 	ICoord2D m_textPos;  ///< current text pos set in text renderer
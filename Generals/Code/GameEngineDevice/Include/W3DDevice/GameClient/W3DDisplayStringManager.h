@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "Common/STLTypedefs.h"
 #include "GameClient/DisplayStringManager.h"
 #include "W3DDevice/GameClient/W3DDisplayString.h"
 
@@ -43,6 +44,16 @@
 	#define MAX_GROUPS 10
 #endif
 
+//-------------------------------------------------------------------------------------------------
+/** Text layout work done in one frame */
+//-------------------------------------------------------------------------------------------------
+struct W3DTextLayoutStats
+{
+	Int sentenceBuilds;		///< sentences rendered into textures
+	Int layouts;					///< text extents computed
+	Int layoutCacheHits;	///< text extents taken from the layout cache
+};
+
 class W3DDisplayStringManager : public DisplayStringManager
 {
 
@@ -56,6 +67,7 @@ public:
 
 	/// update method for all our display strings
 	virtual void update( void );
+	virtual void reset( void );
 
 	/// allocate a new display string
 	virtual DisplayString *newDisplayString( void );
@@ -68,7 +80,34 @@ public:
 	virtual DisplayString *getGroupNumeralString( Int numeral );
 	virtual DisplayString *getFormationLetterString( void ) { return m_formationLetterDisplayString; };
 
+	/// Returns the extents of the text as laid out by the renderer, shared by all strings with the same layout
+	Vector2 getFormattedTextExtents( Render2DSentenceClass &renderer, const UnicodeString &text );
+	void countSentenceBuild( void ) { ++m_frameStats.sentenceBuilds; }
+	const W3DTextLayoutStats &getLastFrameStats( void ) const { return m_lastFrameStats; }
+
 protected:
+
+	// TheSuperHackers @performance 19/10/2026 Computing the extents of a string runs the whole
+	// word wrap layout. Many strings show the same text, so the results are cached by text and
+	// layout settings.
+	enum { MAX_TEXT_LAYOUTS = 2048 };
+
+	struct TextLayout
+	{
+		UnicodeString text;
+		FontCharsClass *font;
+		Real wrapWidth;
+		Bool hotKeyParse;
+		Bool hardWordWrap;
+		Vector2 extents;
+	};
+
+	typedef std::hash_map< UnsignedInt, TextLayout, rts::hash<UnsignedInt>, rts::equal_to<UnsignedInt> > TextLayoutMap;
+
+	TextLayoutMap m_textLayouts;
+	W3DTextLayoutStats m_frameStats;
+	W3DTextLayoutStats m_lastFrameStats;
+
 	DisplayString *m_groupNumeralStrings[ MAX_GROUPS ];
 	DisplayString *m_formationLetterDisplayString;
 
@@ -1,13 +1,17 @@
 /*
 **  AndroidAudioManager.cpp
-**  Oboe-based AudioManager with PCM mixing for Android.
+**  Oboe-based AudioManager for Android, mixed by StdAudioMixer.
 **
 **  Audio lifecycle:
 **    1. Game calls addAudioEvent() → base class queues AudioRequest
 **    2. processRequestList() dispatches AR_Play → playAudioEvent()
-**    3. playAudioEvent() loads WAV data and adds AndroidPlayingAudio to m_playingSources
-**    4. onAudioReady() mixes all active sources into the Oboe output buffer
-**    5. Finished sources move to m_stoppedSources → cleanupFinishedAudio()
+**    3. playAudioEvent() gets the decoded WAV data from the sample cache and adds
+**       AndroidPlayingAudio to m_playingSources
+**    4. onAudioReady() mixes all active voices into the Oboe output buffer
+**    5. The mixer hands finished voices back → cleanupFinishedAudio() frees them
+**
+**  The game thread only talks to the mixer through its lock-free command queue,
+**  so the real-time callback never waits for the game thread.
 */
 
 #include "PreRTS.h"
@@ -21,6 +25,7 @@
 #include "Common/File.h"
 
 #include <android/log.h>
+#include <cmath>
 #include <cstring>
 #include <algorithm>
 
@@ -32,12 +37,19 @@
 static constexpr int OUTPUT_SAMPLE_RATE  = 44100;
 static constexpr int OUTPUT_CHANNELS     = 2;  // stereo
 
+// Memory budget of the decoded sample cache. Samples still in use by a playing
+// source stay alive after eviction until the source is freed.
+static constexpr size_t SAMPLE_CACHE_BUDGET_BYTES = 32 * 1024 * 1024;
+
 // ===========================================================================
 // Construction / Destruction
 // ===========================================================================
 
 AndroidAudioManager::AndroidAudioManager()
     : m_isStreamOpen(false)
+    , m_mixer(OUTPUT_SAMPLE_RATE)
+    , m_lastRenderTime(std::chrono::steady_clock::now())
+    , m_sampleCacheBytes(0)
 {
     LOGI("AndroidAudioManager created");
 }
@@ -46,24 +58,15 @@ AndroidAudioManager::~AndroidAudioManager()
 {
     closeStream();
 
-    // Cleanup any remaining sources
-    std::lock_guard<std::mutex> lock(m_audioMutex);
+    // Cleanup any remaining sources, the mixer no longer runs
     for (auto *src : m_playingSources) {
-        delete[] src->m_pcmData;
-        if (src->m_cleanupEvent && src->m_audioEventRTS) {
-            releaseAudioEventRTS(src->m_audioEventRTS);
-        }
-        delete src;
+        freeSource(src);
     }
     m_playingSources.clear();
-    for (auto *src : m_stoppedSources) {
-        delete[] src->m_pcmData;
-        if (src->m_cleanupEvent && src->m_audioEventRTS) {
-            releaseAudioEventRTS(src->m_audioEventRTS);
-        }
-        delete src;
-    }
-    m_stoppedSources.clear();
+
+    m_sampleCache.clear();
+    m_sampleLru.clear();
+    m_sampleCacheBytes = 0;
 
     LOGI("AndroidAudioManager destroyed");
 }
@@ -81,13 +84,11 @@ void AndroidAudioManager::init()
 
 void AndroidAudioManager::reset()
 {
-    // Stop all playing audio
-    {
-        std::lock_guard<std::mutex> lock(m_audioMutex);
-        for (auto *src : m_playingSources) {
-            src->m_stopped = true;
-        }
+    // Stop all playing audio, the sources are freed once the mixer let go of them
+    for (auto *src : m_playingSources) {
+        src->m_stopped = true;
     }
+    m_mixer.stopAllVoices();
     cleanupFinishedAudio();
     AudioManager::reset();
     LOGI("AndroidAudioManager::reset()");
@@ -96,6 +97,23 @@ void AndroidAudioManager::reset()
 void AndroidAudioManager::update()
 {
     AudioManager::update();
+
+    for (auto *src : m_playingSources) {
+        if (!src->m_stopped && src->m_audioEventRTS && src->m_audioEventRTS->isPositionalAudio()) {
+            updateGains(src);
+        }
+    }
+
+    // Without an audio stream, render the elapsed time into the null sink
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!m_isStreamOpen) {
+        const double seconds = std::chrono::duration<double>(now - m_lastRenderTime).count();
+        const Int frames = (Int)std::min(seconds * OUTPUT_SAMPLE_RATE, (double)OUTPUT_SAMPLE_RATE);
+        m_mixer.render(m_nullSink, frames, OUTPUT_CHANNELS);
+    }
+    m_lastRenderTime = now;
+
+    m_mixer.flushCommands();
     cleanupFinishedAudio();
 }
 
@@ -124,12 +142,10 @@ void AndroidAudioManager::processRequestList(void)
                 break;
             case AR_Pause:
                 // Pause the audio with the given handle
-                {
-                    std::lock_guard<std::mutex> lock(m_audioMutex);
-                    for (auto *src : m_playingSources) {
-                        if (src->m_handle == req->m_handleToInteractOn) {
-                            src->m_paused = true;
-                        }
+                for (auto *src : m_playingSources) {
+                    if (src->m_handle == req->m_handleToInteractOn) {
+                        src->m_paused = true;
+                        m_mixer.pauseVoice(src->m_handle, true);
                     }
                 }
                 break;
@@ -145,15 +161,8 @@ void AndroidAudioManager::processRequestList(void)
 // ===========================================================================
 
 // Simple WAV header parser — loads 16-bit PCM data
-int16_t *AndroidAudioManager::loadWavFile(const char *filename,
-                                           uint32_t &outSampleCount,
-                                           int &outChannels,
-                                           int &outSampleRate)
+AndroidSampleDataPtr AndroidAudioManager::loadWavFile(const char *filename)
 {
-    outSampleCount = 0;
-    outChannels    = 1;
-    outSampleRate  = 44100;
-
     // Try to open via the game's file system
     File *file = TheFileSystem->openFile(filename, File::READ | File::BINARY);
     if (!file) {
@@ -229,19 +238,77 @@ int16_t *AndroidAudioManager::loadWavFile(const char *filename,
         return nullptr;
     }
 
-    uint32_t totalSamples = dataSize / sizeof(int16_t);
-    int16_t *pcmOut = new int16_t[totalSamples];
-    memcpy(pcmOut, dataStart, totalSamples * sizeof(int16_t));
+    // Clamp a truncated data chunk to the file
+    if (dataSize > (uint32_t)(rawData + fileSize - dataStart)) {
+        dataSize = (uint32_t)(rawData + fileSize - dataStart);
+    }
 
-    outSampleCount = totalSamples;
-    outChannels    = numChannels;
-    outSampleRate  = sampleRate;
+    uint32_t totalSamples = dataSize / sizeof(int16_t);
+    std::shared_ptr<AndroidSampleData> sample = std::make_shared<AndroidSampleData>();
+    sample->m_pcm.resize(totalSamples);
+    memcpy(sample->m_pcm.data(), dataStart, totalSamples * sizeof(int16_t));
+    sample->m_channels   = numChannels;
+    sample->m_sampleRate = sampleRate;
 
     delete[] rawData;
 
     LOGI("loadWavFile: '%s' loaded — %u samples, %d ch, %d Hz",
          filename, totalSamples, numChannels, sampleRate);
-    return pcmOut;
+    return sample;
+}
+
+// ===========================================================================
+// Decoded Sample Cache
+// ===========================================================================
+
+// Returns the decoded sample of the file, loading it on the first use
+AndroidSampleDataPtr AndroidAudioManager::getSample(const char *filename)
+{
+    std::string key(filename);
+    auto it = m_sampleCache.find(key);
+    if (it != m_sampleCache.end()) {
+        m_sampleLru.splice(m_sampleLru.begin(), m_sampleLru, it->second.m_lruPos);
+        return it->second.m_sample;
+    }
+
+    SampleCacheEntry entry;
+    entry.m_sample = loadWavFile(filename);
+    m_sampleLru.push_front(key);
+    entry.m_lruPos = m_sampleLru.begin();
+    if (entry.m_sample) {
+        m_sampleCacheBytes += entry.m_sample->m_pcm.size() * sizeof(int16_t);
+    }
+
+    AndroidSampleDataPtr sample = entry.m_sample;
+    m_sampleCache.emplace(std::move(key), std::move(entry));
+    trimSampleCache();
+    return sample;
+}
+
+// Evicts the least recently used samples until the cache fits its budget
+void AndroidAudioManager::trimSampleCache()
+{
+    while (m_sampleCacheBytes > SAMPLE_CACHE_BUDGET_BYTES && m_sampleLru.size() > 1) {
+        auto it = m_sampleCache.find(m_sampleLru.back());
+        if (it->second.m_sample) {
+            m_sampleCacheBytes -= it->second.m_sample->m_pcm.size() * sizeof(int16_t);
+        }
+        m_sampleCache.erase(it);
+        m_sampleLru.pop_back();
+    }
+}
+
+void AndroidAudioManager::preloadAudioEvent(const AudioEventRTS *eventToPreload)
+{
+    if (!eventToPreload || eventToPreload->getEventName().isEmpty()) return;
+
+    getInfoForAudioEvent(eventToPreload);
+    const AudioEventInfo *info = eventToPreload->getAudioEventInfo();
+    if (!info) return;
+
+    for (const AsciiString &sound : info->m_sounds) {
+        getSample(sound.str());
+    }
 }
 
 // ===========================================================================
@@ -273,35 +340,45 @@ void AndroidAudioManager::playAudioEvent(AudioEventRTS *event)
     int idx = (soundFiles.size() > 1) ? (rand() % (int)soundFiles.size()) : 0;
     const char *filename = soundFiles[idx].str();
 
-    // Load PCM data
-    uint32_t sampleCount = 0;
-    int channels = 1, sampleRate = 44100;
-    int16_t *pcmData = loadWavFile(filename, sampleCount, channels, sampleRate);
+    // Get PCM data
+    AndroidSampleDataPtr sample = getSample(filename);
 
-    if (!pcmData || sampleCount == 0) {
+    if (!sample || sample->m_pcm.empty()) {
         LOGW("playAudioEvent: failed to load '%s'", filename);
         return;
     }
+    const uint32_t sampleCount = (uint32_t)sample->m_pcm.size();
+
+    // Every source holds a mixer voice until the mixer hands it back
+    if (m_playingSources.size() >= StdAudioMixer::MAX_VOICES) {
+        LOGW("playAudioEvent: voice limit reached, dropping '%s'", event->getEventName().str());
+        releaseAudioEventRTS(event);
+        return;
+    }
 
     // Create playing source
     AndroidPlayingAudio *src = new AndroidPlayingAudio();
     src->m_audioEventRTS = event;
     src->m_handle       = allocateNewHandle();
-    src->m_pcmData      = pcmData;
-    src->m_pcmSize      = sampleCount;
-    src->m_pcmPos       = 0;
-    src->m_channels     = channels;
-    src->m_sampleRate   = sampleRate;
+    src->m_sample       = sample;
     src->m_looping      = info->m_loopCount != 1; // loop if not single-play
     src->m_volume       = event->getVolume();
+    computeGains(src, src->m_gainLeft, src->m_gainRight);
 
     // Set the handle on the event for tracking
     event->setPlayingHandle(src->m_handle);
 
-    {
-        std::lock_guard<std::mutex> lock(m_audioMutex);
-        m_playingSources.push_back(src);
-    }
+    StdAudioMixer::VoiceParams params;
+    params.pcm         = sample->m_pcm.data();
+    params.numFrames   = sampleCount / (uint32_t)std::max(sample->m_channels, 1);
+    params.numChannels = sample->m_channels;
+    params.sampleRate  = sample->m_sampleRate;
+    params.gainLeft    = src->m_gainLeft;
+    params.gainRight   = src->m_gainRight;
+    params.looping     = src->m_looping;
+    m_mixer.playVoice(src->m_handle, params);
+
+    m_playingSources.push_back(src);
 
     LOGI("playAudioEvent: '%s' -> handle %u, %u samples, vol=%.2f",
          event->getEventName().str(), src->m_handle, sampleCount, src->m_volume);
@@ -309,41 +386,114 @@ void AndroidAudioManager::playAudioEvent(AudioEventRTS *event)
 
 void AndroidAudioManager::stopAudioEvent(AudioHandle handle)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
-        if (src->m_handle == handle) {
+        if (src->m_handle == handle && !src->m_stopped) {
             src->m_stopped = true;
+            m_mixer.stopVoice(handle);
             return;
         }
     }
 }
 
+void AndroidAudioManager::freeSource(AndroidPlayingAudio *src)
+{
+    if (src->m_cleanupEvent && src->m_audioEventRTS) {
+        releaseAudioEventRTS(src->m_audioEventRTS);
+    }
+    delete src;
+}
+
 void AndroidAudioManager::cleanupFinishedAudio()
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
+    // Mark the voices the mixer has finished
+    StdAudioMixer::VoiceHandle handle;
+    bool anyFinished = false;
+    while (m_mixer.popFinishedVoice(handle)) {
+        for (auto *src : m_playingSources) {
+            if (src->m_handle == handle) {
+                src->m_finished = true;
+                anyFinished = true;
+                break;
+            }
+        }
+    }
 
-    // Move finished/stopped sources to stopped list
+    if (!anyFinished) return;
+
+    // Free finished sources
     auto it = m_playingSources.begin();
     while (it != m_playingSources.end()) {
         AndroidPlayingAudio *src = *it;
-        if (src->m_stopped || src->isFinished()) {
-            m_stoppedSources.push_back(src);
+        if (src->isFinished()) {
+            freeSource(src);
             it = m_playingSources.erase(it);
         } else {
             ++it;
         }
     }
+}
+
+// ===========================================================================
+// 3D Attenuation
+// ===========================================================================
+
+// Attenuates positional sounds linearly between their min and max distance
+// from the listener and pans them by their side of the camera
+void AndroidAudioManager::computeGains(AndroidPlayingAudio *src, float &gainLeft, float &gainRight)
+{
+    gainLeft = gainRight = src->m_volume;
+
+    AudioEventRTS *event = src->m_audioEventRTS;
+    if (!event || !event->isPositionalAudio()) return;
+
+    const Coord3D *pos = event->getCurrentPosition();
+    const AudioEventInfo *info = event->getAudioEventInfo();
+    if (!pos || !info) return;
+
+    const float dx = pos->x - m_listenerPosition.x;
+    const float dy = pos->y - m_listenerPosition.y;
+    const float dz = pos->z - m_listenerPosition.z;
+    const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+    float attenuation = 1.0f;
+    if (distance > info->m_minDistance) {
+        const float range = info->m_maxDistance - info->m_minDistance;
+        attenuation = range > 0.0f ? 1.0f - (distance - info->m_minDistance) / range : 0.0f;
+        attenuation = std::max(attenuation, 0.0f);
+    }
 
-    // Free stopped sources
-    for (auto *src : m_stoppedSources) {
-        delete[] src->m_pcmData;
-        src->m_pcmData = nullptr;
-        if (src->m_cleanupEvent && src->m_audioEventRTS) {
-            releaseAudioEventRTS(src->m_audioEventRTS);
+    // right of the listener is the view direction turned clockwise around z
+    float pan = 0.0f;
+    const float rightX = m_listenerOrientation.y;
+    const float rightY = -m_listenerOrientation.x;
+    const float rightLength = sqrtf(rightX * rightX + rightY * rightY);
+    const float planarDistance = sqrtf(dx * dx + dy * dy);
+    if (rightLength > 0.0f && planarDistance > 0.0f) {
+        pan = (dx * rightX + dy * rightY) / (rightLength * planarDistance);
+        // sounds inside the min distance move towards the center
+        if (info->m_minDistance > 0.0f && planarDistance < info->m_minDistance) {
+            pan *= planarDistance / info->m_minDistance;
         }
-        delete src;
     }
-    m_stoppedSources.clear();
+
+    gainLeft  *= attenuation * std::min(1.0f, 1.0f - pan);
+    gainRight *= attenuation * std::min(1.0f, 1.0f + pan);
+}
+
+void AndroidAudioManager::updateGains(AndroidPlayingAudio *src)
+{
+    float gainLeft, gainRight;
+    computeGains(src, gainLeft, gainRight);
+
+    // skip changes that are not audible
+    const float threshold = 1.0f / 256.0f;
+    if (fabsf(gainLeft - src->m_gainLeft) < threshold && fabsf(gainRight - src->m_gainRight) < threshold) {
+        return;
+    }
+
+    src->m_gainLeft = gainLeft;
+    src->m_gainRight = gainRight;
+    m_mixer.setVoiceGain(src->m_handle, gainLeft, gainRight);
 }
 
 // ===========================================================================
@@ -354,6 +504,11 @@ void AndroidAudioManager::openStream()
 {
     if (m_isStreamOpen) return;
 
+    m_isStreamOpen = startStream();
+}
+
+bool AndroidAudioManager::startStream()
+{
     oboe::AudioStreamBuilder builder;
     builder.setDirection(oboe::Direction::Output)
            ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
@@ -361,13 +516,15 @@ void AndroidAudioManager::openStream()
            ->setFormat(oboe::AudioFormat::I16)
            ->setChannelCount(OUTPUT_CHANNELS)
            ->setSampleRate(OUTPUT_SAMPLE_RATE)
+           ->setSampleRateConversionQuality(oboe::SampleRateConversionQuality::Medium)
            ->setDataCallback(this)
            ->setErrorCallback(this);
 
     oboe::Result result = builder.openStream(m_stream);
     if (result != oboe::Result::OK) {
         LOGE("Failed to open Oboe stream: %s", oboe::convertToText(result));
-        return;
+        m_stream.reset();
+        return false;
     }
 
     result = m_stream->requestStart();
@@ -375,14 +532,14 @@ void AndroidAudioManager::openStream()
         LOGE("Failed to start Oboe stream: %s", oboe::convertToText(result));
         m_stream->close();
         m_stream.reset();
-        return;
+        return false;
     }
 
-    m_isStreamOpen = true;
     LOGI("Oboe stream opened: sampleRate=%d, channelCount=%d, framesPerBurst=%d",
          m_stream->getSampleRate(),
          m_stream->getChannelCount(),
          m_stream->getFramesPerBurst());
+    return true;
 }
 
 void AndroidAudioManager::closeStream()
@@ -403,77 +560,7 @@ void AndroidAudioManager::closeStream()
 oboe::DataCallbackResult AndroidAudioManager::onAudioReady(
     oboe::AudioStream *oboeStream, void *audioData, int32_t numFrames)
 {
-    int16_t *output = static_cast<int16_t*>(audioData);
-    const int outChannels = oboeStream->getChannelCount();
-    const int totalOutSamples = numFrames * outChannels;
-
-    // Ensure mix buffer is large enough
-    if ((int)m_mixBuffer.size() < totalOutSamples) {
-        m_mixBuffer.resize(totalOutSamples);
-    }
-
-    // Clear mix buffer
-    std::fill(m_mixBuffer.begin(), m_mixBuffer.begin() + totalOutSamples, 0);
-
-    // Lock and mix all active sources
-    {
-        std::lock_guard<std::mutex> lock(m_audioMutex);
-
-        for (auto *src : m_playingSources) {
-            if (src->m_stopped || src->m_paused || !src->m_pcmData) continue;
-
-            float vol = src->m_volume;
-            int srcCh = src->m_channels;
-
-            for (int frame = 0; frame < numFrames; ++frame) {
-                if (src->m_pcmPos >= src->m_pcmSize) {
-                    if (src->m_looping) {
-                        src->m_pcmPos = 0;
-                    } else {
-                        break; // done
-                    }
-                }
-
-                // Read source sample(s)
-                int16_t left = 0, right = 0;
-                if (srcCh == 1) {
-                    // Mono: duplicate to both channels
-                    left = right = src->m_pcmData[src->m_pcmPos++];
-                } else if (srcCh == 2) {
-                    left  = src->m_pcmData[src->m_pcmPos++];
-                    if (src->m_pcmPos < src->m_pcmSize) {
-                        right = src->m_pcmData[src->m_pcmPos++];
-                    }
-                } else {
-                    // Multi-channel: just take first two
-                    left  = src->m_pcmData[src->m_pcmPos++];
-                    if (src->m_pcmPos < src->m_pcmSize) {
-                        right = src->m_pcmData[src->m_pcmPos++];
-                    }
-                    // Skip remaining channels
-                    for (int c = 2; c < srcCh && src->m_pcmPos < src->m_pcmSize; ++c) {
-                        src->m_pcmPos++;
-                    }
-                }
-
-                // Apply volume and accumulate into mix buffer (32-bit to avoid clipping)
-                int outIdx = frame * outChannels;
-                m_mixBuffer[outIdx]     += (int32_t)(left  * vol);
-                if (outChannels >= 2) {
-                    m_mixBuffer[outIdx + 1] += (int32_t)(right * vol);
-                }
-            }
-        }
-    }
-
-    // Clamp and write to output
-    for (int i = 0; i < totalOutSamples; ++i) {
-        int32_t sample = m_mixBuffer[i];
-        if (sample > 32767)  sample = 32767;
-        if (sample < -32768) sample = -32768;
-        output[i] = (int16_t)sample;
-    }
-
+    m_mixer.mix(static_cast<int16_t*>(audioData), numFrames, oboeStream->getChannelCount());
     return oboe::DataCallbackResult::Continue;
 }
 
@@ -481,8 +568,13 @@ void AndroidAudioManager::onErrorAfterClose(
     oboe::AudioStream *oboeStream, oboe::Result error)
 {
     LOGE("Oboe stream error: %s — attempting to reopen", oboe::convertToText(error));
-    m_isStreamOpen = false;
-    openStream();
+
+    // Keep m_isStreamOpen set until reopening failed, so that update() does not
+    // start rendering into the null sink while the new stream runs the mixer.
+    m_stream.reset();
+    if (!startStream()) {
+        m_isStreamOpen = false;
+    }
 }
 
 // ===========================================================================
@@ -491,26 +583,26 @@ void AndroidAudioManager::onErrorAfterClose(
 
 void AndroidAudioManager::stopAudio(AudioAffect which)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
         src->m_stopped = true;
     }
+    m_mixer.stopAllVoices();
 }
 
 void AndroidAudioManager::pauseAudio(AudioAffect which)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
         src->m_paused = true;
     }
+    m_mixer.pauseAllVoices(true);
 }
 
 void AndroidAudioManager::resumeAudio(AudioAffect which)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
         src->m_paused = false;
     }
+    m_mixer.pauseAllVoices(false);
 }
 
 void AndroidAudioManager::pauseAmbient(Bool shouldPause)
@@ -573,9 +665,8 @@ Bool AndroidAudioManager::isPlayingLowerPriority(AudioEventRTS *event) const { r
 
 Bool AndroidAudioManager::isPlayingAlready(AudioEventRTS *event) const
 {
-    std::lock_guard<std::mutex> lock(const_cast<AndroidAudioManager*>(this)->m_audioMutex);
     for (auto *src : m_playingSources) {
-        if (src->m_audioEventRTS && !src->m_stopped &&
+        if (src->m_audioEventRTS && !src->m_stopped && !src->m_finished &&
             src->m_audioEventRTS->getEventName() == event->getEventName()) {
             return TRUE;
         }
@@ -591,22 +682,22 @@ Bool AndroidAudioManager::isObjectPlayingVoice(UnsignedInt objID) const { return
 
 void AndroidAudioManager::adjustVolumeOfPlayingAudio(AsciiString eventName, Real newVolume)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
         if (src->m_audioEventRTS &&
             src->m_audioEventRTS->getEventName() == eventName) {
             src->m_volume = newVolume;
+            updateGains(src);
         }
     }
 }
 
 void AndroidAudioManager::removePlayingAudio(AsciiString eventName)
 {
-    std::lock_guard<std::mutex> lock(m_audioMutex);
     for (auto *src : m_playingSources) {
-        if (src->m_audioEventRTS &&
+        if (src->m_audioEventRTS && !src->m_stopped &&
             src->m_audioEventRTS->getEventName() == eventName) {
             src->m_stopped = true;
+            m_mixer.stopVoice(src->m_handle);
         }
     }
 }
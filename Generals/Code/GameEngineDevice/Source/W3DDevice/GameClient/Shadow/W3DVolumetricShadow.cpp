@@ -799,7 +799,7 @@ PolyNeighbor *W3DShadowGeometryMesh::GetPolyNeighbor( Int polyIndex )
 void W3DShadowGeometryMesh::buildPolygonNeighbors( void )
 {
 	Int numPolys;
-	Int i, j;
+	Int i, j, c;
 
 	// how many polygons are in our geometry
 	numPolys = GetNumPolygon();
@@ -857,6 +857,52 @@ void W3DShadowGeometryMesh::buildPolygonNeighbors( void )
 
 	}
 
+	//
+	// TheSuperHackers @performance 19/10/2026 Polygons can only be neighbors when they share a
+	// vertex, so build a table of the polygons that use each vertex and only test those. The
+	// candidates of a polygon are visited in ascending order, like the former test against all
+	// other polygons, so the neighbor slots are filled identically.
+	//
+	Int numVertIndices = 0;
+	for( i = 0; i < m_numPolyNeighbors; i++ )
+	{
+		Short poly[ 3 ];
+
+		GetPolygonIndex( i, poly, 3 );
+		for( j = 0; j < 3; j++ )
+			if( (UnsignedShort)poly[ j ] >= numVertIndices )
+				numVertIndices = (UnsignedShort)poly[ j ] + 1;
+	}
+
+	// vertPolys[ vertPolyStart[ v ] ] to vertPolys[ vertPolyStart[ v + 1 ] - 1 ] are the polygons using vertex v
+	Int *vertPolyStart = NEW Int[ numVertIndices + 1 ];
+	Int *vertPolyFill = NEW Int[ numVertIndices ];
+	Int *vertPolys = NEW Int[ m_numPolyNeighbors * 3 ];
+	Int *candidates = NEW Int[ m_numPolyNeighbors ];
+
+	memset( vertPolyStart, 0, sizeof( Int ) * ( numVertIndices + 1 ) );
+	for( i = 0; i < m_numPolyNeighbors; i++ )
+	{
+		Short poly[ 3 ];
+
+		GetPolygonIndex( i, poly, 3 );
+		for( j = 0; j < 3; j++ )
+			vertPolyStart[ (UnsignedShort)poly[ j ] + 1 ]++;
+	}
+	for( j = 0; j < numVertIndices; j++ )
+	{
+		vertPolyStart[ j + 1 ] += vertPolyStart[ j ];
+		vertPolyFill[ j ] = vertPolyStart[ j ];
+	}
+	for( i = 0; i < m_numPolyNeighbors; i++ )
+	{
+		Short poly[ 3 ];
+
+		GetPolygonIndex( i, poly, 3 );
+		for( j = 0; j < 3; j++ )
+			vertPolys[ vertPolyFill[ (UnsignedShort)poly[ j ] ]++ ] = i;
+	}
+
 	// assign polygon data for each of our polygons
 	for( i = 0; i < m_numPolyNeighbors; i++ )
 	{
@@ -868,9 +914,40 @@ void W3DShadowGeometryMesh::buildPolygonNeighbors( void )
 		GetPolygonIndex( i, poly, 3 );
 		GetPolygonNormal(i,&vNorm);
 
+		//
+		// merge the ascending polygon lists of our three vertices into one
+		// ascending list of candidates without duplicates
+		//
+		const Int *head[ 3 ];
+		const Int *tail[ 3 ];
+		Int numCandidates = 0;
+		for( c = 0; c < 3; c++ )
+		{
+			head[ c ] = &vertPolys[ vertPolyStart[ (UnsignedShort)poly[ c ] ] ];
+			tail[ c ] = &vertPolys[ vertPolyStart[ (UnsignedShort)poly[ c ] + 1 ] ];
+		}
+		for( ;; )
+		{
+			Int next = m_numPolyNeighbors;
+			for( c = 0; c < 3; c++ )
+				if( head[ c ] < tail[ c ] && *head[ c ] < next )
+					next = *head[ c ];
+
+			if( next == m_numPolyNeighbors )
+				break;
+
+			for( c = 0; c < 3; c++ )
+				while( head[ c ] < tail[ c ] && *head[ c ] == next )
+					head[ c ]++;
+
+			candidates[ numCandidates++ ] = next;
+		}
+
 		// find the neighbors of this polygon
-		for( j = 0; j < m_numPolyNeighbors; j++ )
+		for( c = 0; c < numCandidates; c++ )
 		{
+			j = candidates[ c ];
+
 			Int a, b;
 			Int index1, index2;
 			Int index1Pos[2]; //positions of shared edge vertices in triangle list. (0,1 or 2)
@@ -976,6 +1053,11 @@ void W3DShadowGeometryMesh::buildPolygonNeighbors( void )
 
 	}
 
+	delete [] vertPolyStart;
+	delete [] vertPolyFill;
+	delete [] vertPolys;
+	delete [] candidates;
+
 }
 
 // allocateNeighbors ==========================================================
@@ -66,6 +66,7 @@
 #include "font3d.h"
 #include "render2dsentence.h"
 #include "Common/PerfTimer.h"
+#include "Common/PerfTrace.h"
 #include "Common/GlobalData.h"
 
 
@@ -141,13 +142,15 @@ RenderObjClass * W3DPrototypeClass::Create(void)
 //---------------------------------------------------------------------
 
 //---------------------------------------------------------------------
-W3DAssetManager::W3DAssetManager(void)
+W3DAssetManager::W3DAssetManager(void) :
+	m_recoloredSurfaceBytes(0)
 {
 }
 
 //---------------------------------------------------------------------
 W3DAssetManager::~W3DAssetManager(void)
 {
+	Release_Recolored_Surfaces();
 }
 
 #ifdef DUMP_PERF_STATS
@@ -368,6 +371,38 @@ const UnsignedShort houseColorScale[TEAM_COLOR_PALETTE_SIZE] =
 	255,239,223,211,195,174,167,151,135,123,107,91,79,63,47,35
 };
 
+// TheSuperHackers @performance 19/10/2026 The texture remap functions below skip the palette search
+// for pixels that cannot be part of the team color palette, and compute the hue shift only once per
+// distinct source color. The recolored pixels are identical to before.
+
+//---------------------------------------------------------------------
+/** Hashes a pixel value to one of 256 bits of a palette filter. */
+static inline UnsignedInt paletteFilterBit(UnsignedInt value)
+{
+	return (value ^ (value >> 8) ^ (value >> 16) ^ (value >> 24)) & 0xff;
+}
+
+//---------------------------------------------------------------------
+/** Sets one bit for each palette color. Pixels that hash to a clear bit are not in the palette. */
+template <typename PixelType>
+static void buildPaletteFilter(UnsignedInt filter[8], const PixelType *palette)
+{
+	for (Int i=0; i<8; i++)
+		filter[i] = 0;
+
+	for (Int p=0; p<TEAM_COLOR_PALETTE_SIZE; p++)
+	{	const UnsignedInt bit = paletteFilterBit(palette[p]);
+		filter[bit>>5] |= 1u << (bit&31);
+	}
+}
+
+//---------------------------------------------------------------------
+static inline Bool mayBeInPalette(const UnsignedInt filter[8], UnsignedInt value)
+{
+	const UnsignedInt bit = paletteFilterBit(value);
+	return (filter[bit>>5] & (1u << (bit&31))) != 0;
+}
+
 //---------------------------------------------------------------------
 static void remapPalette16Bit(SurfaceClass::SurfaceDescription *sd, UnsignedShort *palette, unsigned int color)
 {
@@ -407,9 +442,15 @@ static void remapTexture16Bit(Int dx, Int dy, Int pitch, SurfaceClass::SurfaceDe
 		Convert_Pixel((unsigned char *)&pal[y],*sd,rgb);
 	}
 
+	UnsignedInt paletteFilter[8];
+	buildPaletteFilter(paletteFilter, palette);
+
 	for (y=0; y<dy; y++)
 	{	for (Int x=0; x<dx; x++)
-		{	//check if this pixel is part of team color palette
+		{	if (!mayBeInPalette(paletteFilter, data[x]))
+				continue;
+
+			//check if this pixel is part of team color palette
 			for (Int p=0; p<TEAM_COLOR_PALETTE_SIZE; p++)
 			{	if (palette[p]==data[x])
 				{	data[x]=pal[p];	//replace color with house color
@@ -441,6 +482,11 @@ static void remapAlphaTexture16Bit(Int dx, Int dy, Int pitch, SurfaceClass::Surf
 	Vector3 hsv;
 	Vector3 hsv_color;
 	RGB_To_HSV(hsv_color,v_color);
+
+	// The hue shifted color only depends on the 12 bit source color, so remember it.
+	UnsignedShort remapped[4096];
+	UnsignedByte remappedValid[4096/8];
+	memset(remappedValid, 0, sizeof(remappedValid));
 #endif
 
 	for (y=0; y<dy; y++)
@@ -453,18 +499,25 @@ static void remapAlphaTexture16Bit(Int dx, Int dy, Int pitch, SurfaceClass::Surf
 			{	//some house color needs to show through
 				///@todo: optimize this alpha blend to use fixed point math.
 #ifdef DO_HUE_SHIFT
-				RGB_To_HSV(hsv,Vector3(((pixel>>8)&0xf)/15.0f,((pixel>>4)&0xf)/15.0f,(pixel &0xf)/15.0f));
-				hsv.X=hsv_color.X;
-				hsv.Y*=hsv_color.Y;
-				HSV_To_RGB(rgb,hsv);
+				const UnsignedShort color12 = pixel & 0x0fff;
+				if ((remappedValid[color12>>3] & (1 << (color12&7))) == 0)
+				{
+					RGB_To_HSV(hsv,Vector3(((pixel>>8)&0xf)/15.0f,((pixel>>4)&0xf)/15.0f,(pixel &0xf)/15.0f));
+					hsv.X=hsv_color.X;
+					hsv.Y*=hsv_color.Y;
+					HSV_To_RGB(rgb,hsv);
+					remapped[color12] = REAL_TO_INT(rgb.X*15.0f)<<8 | REAL_TO_INT(rgb.Y*15.0f)<<4 | REAL_TO_INT(rgb.Z*15.0f);
+					remappedValid[color12>>3] |= 1 << (color12&7);
+				}
+				data[x] = remapped[color12];
 #else
 				fpixelAlpha=pixelAlpha/15.0f;
 				fpixelAlphaInv=1.0f-fpixelAlpha;
 				rgb.X=fpixelAlpha * v_color.X + fpixelAlphaInv*(Real)((pixel>>8)&0xf)/15.0f;	//red
 				rgb.Y=fpixelAlpha * v_color.Y + fpixelAlphaInv*(Real)((pixel>>4)&0xf)/15.0f; //green
 				rgb.Z=fpixelAlpha * v_color.Z + fpixelAlphaInv*(Real)(pixel&0xf)/15.0f; //blue
-#endif
 				data[x] = REAL_TO_INT(rgb.X*15.0f)<<8 | REAL_TO_INT(rgb.Y*15.0f)<<4 | REAL_TO_INT(rgb.Z*15.0f);
+#endif
 			}
 			data[x] |= 0xf000;	//force alpha to opaque.
 		}
@@ -511,9 +564,15 @@ static void remapTexture32Bit(Int dx, Int dy, Int pitch, SurfaceClass::SurfaceDe
 		Convert_Pixel((unsigned char *)&pal[y],*sd,rgb);
 	}
 
+	UnsignedInt paletteFilter[8];
+	buildPaletteFilter(paletteFilter, palette);
+
 	for (y=0; y<dy; y++)
 	{	for (Int x=0; x<dx; x++)
-		{	//check if this pixel is part of team color palette
+		{	if (!mayBeInPalette(paletteFilter, data[x]))
+				continue;
+
+			//check if this pixel is part of team color palette
 			for (Int p=0; p<TEAM_COLOR_PALETTE_SIZE; p++)
 			{	if (palette[p]==data[x])
 				{	data[x]=pal[p];	//replace color with house color
@@ -539,6 +598,13 @@ static void remapAlphaTexture32Bit(Int dx, Int dy, Int pitch, SurfaceClass::Surf
 	Vector3 hsv;
 	Vector3 hsv_color;
 	RGB_To_HSV(hsv_color,v_color);
+
+	// The hue shifted color only depends on the 24 bit source color. Remember recent results
+	// in a small direct mapped cache. The key holds the source color plus a valid bit.
+	enum { REMAP_CACHE_SIZE = 1024 };
+	UnsignedInt remapKey[REMAP_CACHE_SIZE];
+	UnsignedInt remapValue[REMAP_CACHE_SIZE];
+	memset(remapKey, 0, sizeof(remapKey));
 #endif
 
 	for (y=0; y<dy; y++)
@@ -549,10 +615,18 @@ static void remapAlphaTexture32Bit(Int dx, Int dy, Int pitch, SurfaceClass::Surf
 			if (pixelAlpha)
 			{	//some house color needs to show through
 #ifdef DO_HUE_SHIFT
-				RGB_To_HSV(hsv,Vector3(((pixel>>16)&0xff)/255.0f,((pixel>>8)&0xff)/255.0f,(pixel &0xff)/255.0f));
-				hsv.X=hsv_color.X;
-				hsv.Y*=hsv_color.Y;
-				HSV_To_RGB(rgb,hsv);
+				const UnsignedInt key = (pixel & 0x00ffffff) | 0x01000000;
+				const UnsignedInt slot = ((pixel & 0x00ffffff) * 2654435761u) >> 22;
+				if (remapKey[slot] != key)
+				{
+					RGB_To_HSV(hsv,Vector3(((pixel>>16)&0xff)/255.0f,((pixel>>8)&0xff)/255.0f,(pixel &0xff)/255.0f));
+					hsv.X=hsv_color.X;
+					hsv.Y*=hsv_color.Y;
+					HSV_To_RGB(rgb,hsv);
+					remapKey[slot] = key;
+					remapValue[slot] = REAL_TO_INT(rgb.X*255.0f)<<16 |	REAL_TO_INT(rgb.Y*255.0f)<<8 | REAL_TO_INT(rgb.Z*255.0f);
+				}
+				data[x] = remapValue[slot];
 #else
 				///@todo: optimize this alpha blend to use fixed point math.
 				fpixelAlpha=pixelAlpha/255.0f;
@@ -560,8 +634,8 @@ static void remapAlphaTexture32Bit(Int dx, Int dy, Int pitch, SurfaceClass::Surf
 				rgb.X=fpixelAlpha * v_color.X + fpixelAlphaInv*(Real)((pixel>>16)&0xff)/255.0f;	//red
 				rgb.Y=fpixelAlpha * v_color.Y + fpixelAlphaInv*(Real)((pixel>>8)&0xff)/255.0f; //green
 				rgb.Z=fpixelAlpha * v_color.Z + fpixelAlphaInv*(Real)(pixel&0xff)/255.0f; //blue
-#endif
 				data[x] = REAL_TO_INT(rgb.X*255.0f)<<16 |	REAL_TO_INT(rgb.Y*255.0f)<<8 | REAL_TO_INT(rgb.Z*255.0f);
+#endif
 			}
 			data[x] |= 0xff000000;	//force alpha to opaque.
 		}
@@ -637,16 +711,26 @@ TextureClass * W3DAssetManager::Recolor_Texture_One_Time(TextureClass *texture,
 	psize=Get_Bytes_Per_Pixel(desc.Format);
 	DEBUG_ASSERTCRASH( psize == 2 || psize == 4, ("Can't Recolor Texture %s", name) );
 
-	oldsurf=texture->Get_Surface_Level();
+	char newname[512];
+	Munge_Texture_Name(newname, ARRAY_SIZE(newname), name, color);
 
-	newsurf=NEW_REF(SurfaceClass,(desc.Width,desc.Height,desc.Format));
-	newsurf->Copy(0,0,0,0,desc.Width,desc.Height,oldsurf);
+	newsurf=Find_Recolored_Surface(newname, desc);
+	if (newsurf == nullptr)
+	{
+		oldsurf=texture->Get_Surface_Level();
 
-	if (*(name+3) == 'D' || *(name+3) == 'd')
-		Remap_Palette(newsurf,color, true, false );	//texture only contains a palette stored in top row.
-	else
-	if (*(name+3) == 'A' || *(name+3) == 'a')
-		Remap_Palette(newsurf,color, false, true );	//texture only contains a palette stored in top row.
+		newsurf=NEW_REF(SurfaceClass,(desc.Width,desc.Height,desc.Format));
+		newsurf->Copy(0,0,0,0,desc.Width,desc.Height,oldsurf);
+
+		if (*(name+3) == 'D' || *(name+3) == 'd')
+			Remap_Palette(newsurf,color, true, false );	//texture only contains a palette stored in top row.
+		else
+		if (*(name+3) == 'A' || *(name+3) == 'a')
+			Remap_Palette(newsurf,color, false, true );	//texture only contains a palette stored in top row.
+
+		REF_PTR_RELEASE(oldsurf);
+		Add_Recolored_Surface(newname, newsurf);
+	}
 
 	TextureClass * newtex=NEW_REF(TextureClass,(newsurf,(MipCountType)texture->Get_Mip_Level_Count()));
 	newtex->Get_Filter().Set_Mag_Filter(texture->Get_Filter().Get_Mag_Filter());
@@ -655,19 +739,66 @@ TextureClass * W3DAssetManager::Recolor_Texture_One_Time(TextureClass *texture,
 	newtex->Get_Filter().Set_U_Addr_Mode(texture->Get_Filter().Get_U_Addr_Mode());
 	newtex->Get_Filter().Set_V_Addr_Mode(texture->Get_Filter().Get_V_Addr_Mode());
 
-	char newname[512];
-	Munge_Texture_Name(newname, ARRAY_SIZE(newname), name, color);
 	newtex->Set_Texture_Name(newname);
 
 	TextureHash.Insert(newtex->Get_Texture_Name(), newtex);
 	newtex->Add_Ref();
 
-	REF_PTR_RELEASE(oldsurf);
 	REF_PTR_RELEASE(newsurf);
 
 	return newtex;
 }
 
+//---------------------------------------------------------------------
+/** Returns a reference to the kept recolored surface of the texture, or null if there is none
+	with this description. The description changes with the texture reduction setting. */
+//---------------------------------------------------------------------
+SurfaceClass * W3DAssetManager::Find_Recolored_Surface(const char * munged_name, const SurfaceClass::SurfaceDescription &desc)
+{
+	SurfaceClass *surface = m_recoloredSurfaceHash.Get(munged_name);
+	if (surface == nullptr)
+		return nullptr;
+
+	SurfaceClass::SurfaceDescription sd;
+	surface->Get_Description(sd);
+	if (sd.Width != desc.Width || sd.Height != desc.Height || sd.Format != desc.Format)
+	{
+		m_recoloredSurfaceBytes -= sd.Width * sd.Height * Get_Bytes_Per_Pixel(sd.Format);
+		m_recoloredSurfaceHash.Remove(munged_name);
+		REF_PTR_RELEASE(surface);
+		return nullptr;
+	}
+
+	surface->Add_Ref();
+	return surface;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::Add_Recolored_Surface(const char * munged_name, SurfaceClass *surface)
+{
+	SurfaceClass::SurfaceDescription sd;
+	surface->Get_Description(sd);
+	const UnsignedInt bytes = sd.Width * sd.Height * Get_Bytes_Per_Pixel(sd.Format);
+	if (m_recoloredSurfaceBytes + bytes > MAX_RECOLORED_SURFACE_BYTES)
+		return;
+
+	surface->Add_Ref();
+	m_recoloredSurfaceHash.Insert(munged_name, surface);
+	m_recoloredSurfaceBytes += bytes;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::Release_Recolored_Surfaces(void)
+{
+	HashTemplateIterator<StringClass,SurfaceClass*> ite(m_recoloredSurfaceHash);
+	for (ite.First();!ite.Is_Done();ite.Next()) {
+		SurfaceClass *surface=ite.Peek_Value();
+		REF_PTR_RELEASE(surface);
+	}
+	m_recoloredSurfaceHash.Remove_All();
+	m_recoloredSurfaceBytes = 0;
+}
+
 #ifdef DUMP_PERF_STATS
 __int64 Total_Create_Render_Obj_Time=0;
 #endif
@@ -683,6 +814,8 @@ RenderObjClass * W3DAssetManager::Create_Render_Obj(
 	const char *newTexture
 )
 {
+	PERF_TRACE_SCOPE(W3DAssetManager_Create_Render_Obj)
+
 	#ifdef DUMP_PERF_STATS
 	__int64 startTime64,endTime64;
 	GetPrecisionTimer(&startTime64);
@@ -68,6 +68,7 @@ static void drawFramerateBar(void);
 #include "W3DDevice/Common/W3DConvert.h"
 #include "W3DDevice/GameClient/W3DAssetManager.h"
 #include "W3DDevice/GameClient/W3DGameClient.h"
+#include "W3DDevice/GameClient/W3DDisplayStringManager.h"
 #include "W3DDevice/GameClient/W3DFileSystem.h"
 #include "W3DDevice/GameClient/W3DDynamicLight.h"
 #include "W3DDevice/GameClient/HeightMap.h"
@@ -657,6 +658,12 @@ void W3DDisplay::init( void )
 		WW3D::Set_Thumbnail_Enabled(false);
 		WW3D::Set_Screen_UV_Bias( TRUE );  ///< this makes text look good :)
 
+		// TheSuperHackers @performance 19/10/2026 Keep the rasterized font characters between runs.
+		AsciiString glyphCachePath = TheGlobalData->getPath_UserData();
+		glyphCachePath.concat("GlyphCache\\");
+		TheFileSystem->createDirectory(glyphCachePath);
+		FontCharsClass::Set_Glyph_Cache_Path(glyphCachePath.str());
+
 		setWindowed( TheGlobalData->m_windowed );
 
 		// create a 2D renderer helper
@@ -1167,6 +1174,12 @@ void W3DDisplay::gatherDebugStats( void )
 			TheTerrainRenderObject->getNumShoreLineTiles(FALSE));
 		m_displayStrings[TerrainStats]->setText( unibuffer );
 
+		// text layout stats
+		const W3DTextLayoutStats &textStats = static_cast<W3DDisplayStringManager *>(TheDisplayStringManager)->getLastFrameStats();
+		unibuffer.format( L"Text: %d sentence builds, %d layouts, %d layout cache hits per frame",
+			textStats.sentenceBuilds, textStats.layouts, textStats.layoutCacheHits );
+		m_displayStrings[TextStats]->setText( unibuffer );
+
 		// misc debug info
 		Coord3D camPos;
 		TheTacticalView->getPosition(&camPos);
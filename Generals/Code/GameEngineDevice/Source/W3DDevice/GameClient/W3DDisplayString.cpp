@@ -51,6 +51,7 @@
 // USER INCLUDES //////////////////////////////////////////////////////////////
 #include "GameClient/GameClient.h"
 #include "W3DDevice/GameClient/W3DDisplayString.h"
+#include "W3DDevice/GameClient/W3DDisplayStringManager.h"
 #include "GameClient/HotKey.h"
 #include "GameClient/GameFont.h"
 #include "GameClient/GlobalLanguage.h"
@@ -91,6 +92,7 @@ W3DDisplayString::W3DDisplayString( void )
 	m_clipRegion.hi.y = 0;
 	m_lastResourceFrame = 0;
 	m_useHotKey = FALSE;
+	m_drawHotKey = FALSE;
 	m_hotKeyPos.x = 0;
 	m_hotKeyPos.y = 0;
 	m_hotKeyColor = GameMakeColor(255,255,255,255);
@@ -167,21 +169,25 @@ void W3DDisplayString::draw( Int x, Int y, Color color, Color dropColor, Int xDr
 	// if our font or text has changed we need to build a new sentence
 	if( m_fontChanged || m_textChanged )
 	{
+		m_drawHotKey = FALSE;
 		if(m_useHotKey)
 		{
 			m_textRenderer.Set_Hot_Key_Parse(TRUE);
 			m_textRenderer.Build_Sentence( getText().str(), &m_hotKeyPos.x, &m_hotKeyPos.y );
 			m_hotkey.translate(TheHotKeyManager->searchHotKey(getText()));
 			if(!m_hotkey.isEmpty())
+			{
 				m_textRendererHotKey.Build_Sentence(m_hotkey.str(), nullptr, nullptr);
+				m_drawHotKey = TRUE;
+			}
 			else
-			{
-				m_useHotKey = FALSE;
 				m_textRendererHotKey.Reset();
-			}
 		}
 		else
 			m_textRenderer.Build_Sentence( getText().str(), nullptr, nullptr );
+
+		if( TheDisplayStringManager )
+			static_cast<W3DDisplayStringManager *>(TheDisplayStringManager)->countSentenceBuild();
 		m_fontChanged = FALSE;
 		m_textChanged = FALSE;
 		needNewPolys = TRUE;
@@ -216,7 +222,7 @@ void W3DDisplayString::draw( Int x, Int y, Color color, Color dropColor, Int xDr
 		m_textRenderer.Set_Location( Vector2( m_textPos.x, m_textPos.y ) );
 		m_textRenderer.Draw_Sentence( m_currTextColor );
 
-		if(m_useHotKey)
+		if(m_drawHotKey)
 		{
 			m_textRendererHotKey.Reset_Polys();
 			m_textRendererHotKey.Set_Location( Vector2( m_textPos.x + m_hotKeyPos.x , m_textPos.y +m_hotKeyPos.y) );
@@ -359,7 +365,11 @@ void W3DDisplayString::computeExtents( void )
 	else
 	{
 
-		Vector2 extents = m_textRenderer.Get_Formatted_Text_Extents(getText().str()); //Get_Text_Extents( getText().str() );
+		Vector2 extents;
+		if( TheDisplayStringManager )
+			extents = static_cast<W3DDisplayStringManager *>(TheDisplayStringManager)->getFormattedTextExtents( m_textRenderer, getText() );
+		else
+			extents = m_textRenderer.Get_Formatted_Text_Extents(getText().str()); //Get_Text_Extents( getText().str() );
 		m_size.x = extents.X;
 		m_size.y = extents.Y;
 
@@ -379,6 +389,10 @@ void W3DDisplayString::setWordWrap( Int wordWrap )
 
 void W3DDisplayString::setUseHotkey( Bool useHotkey, Color hotKeyColor )
 {
+	// TheSuperHackers @performance 19/10/2026 Static texts set this on every draw, only relayout on changes.
+	if( m_useHotKey == useHotkey && m_hotKeyColor == hotKeyColor )
+		return;
+
 	m_useHotKey = useHotkey;
 	m_hotKeyColor = hotKeyColor;
 	m_textRenderer.Set_Hot_Key_Parse(useHotkey);
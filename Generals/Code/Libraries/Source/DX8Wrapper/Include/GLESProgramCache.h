@@ -0,0 +1,44 @@
+#pragma once
+#include <GLES3/gl3.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Keeps linked GL programs on disk as glGetProgramBinary blobs, so later runs
+// skip compiling and linking the translated D3D8 shaders. Programs are keyed by
+// the hash of their translated sources and stored per driver, a driver update
+// starts a new cache. The keys every map uses are recorded as well, so the next
+// load of that map can prewarm its programs during the load screen.
+//
+// All functions need the device context to be current. Without Init they do nothing.
+class GLESProgramCache {
+public:
+    struct Stats {
+        unsigned int links;
+        unsigned int binaryLoads;
+        unsigned int binaryFailures;
+        double linkMs;
+        double binaryLoadMs;
+    };
+
+    static void Init(const char* directory);
+    static void Shutdown();
+
+    static uint64_t HashSource(const char* source, size_t length);
+    static uint64_t MakeKey(uint64_t vsHash, uint64_t psHash);
+
+    // Returns the cached program or 0. The cache owns the programs it returns.
+    static GLuint Find(uint64_t key);
+    // Takes ownership of a freshly linked program and writes its binary
+    static void Store(uint64_t key, GLuint program, double linkMs);
+    // Call before linking a program that is passed to Store
+    static void PrepareProgram(GLuint program);
+
+    // Records the programs the current map uses. The serial changes with every map.
+    static void RecordUse(uint64_t key);
+    static unsigned int GetMapSerial();
+
+    // Saves the keys of the previous map and loads the programs recorded for this one
+    static void BeginMap(const char* mapName);
+
+    static const Stats& GetStats();
+};
@@ -2,18 +2,25 @@
 #include "d3d8.h"
 #include <vector>
 #include <string>
+#include <stdint.h>
 
 #include <GLES3/gl3.h>
 
 // Preliminary shader class to hold tokens
+// The GLSL is compiled on the first GetShaderObject call. Programs found in the
+// program cache never need the shader objects, the source hash is their key.
 class GLESVertexShader {
 public:
     GLESVertexShader(const DWORD* declaration, const DWORD* function);
     ~GLESVertexShader();
     const std::vector<DWORD>& GetFunction() const { return m_function; }
-    GLuint GetShaderObject() const { return m_shaderObject; }
+    GLuint GetShaderObject();
+    uint64_t GetSourceHash() const { return m_sourceHash; }
 private:
     std::vector<DWORD> m_function;
+    std::string m_source;
+    uint64_t m_sourceHash = 0;
+    bool m_compiled = false;
     GLuint m_shaderObject = 0;
     GLuint m_program = 0;
 };
@@ -23,8 +30,12 @@ public:
     GLESPixelShader(const DWORD* function);
     ~GLESPixelShader();
     const std::vector<DWORD>& GetFunction() const { return m_function; }
-    GLuint GetShaderObject() const { return m_shaderObject; }
+    GLuint GetShaderObject();
+    uint64_t GetSourceHash() const { return m_sourceHash; }
 private:
     std::vector<DWORD> m_function;
+    std::string m_source;
+    uint64_t m_sourceHash = 0;
+    bool m_compiled = false;
     GLuint m_shaderObject = 0;
 };
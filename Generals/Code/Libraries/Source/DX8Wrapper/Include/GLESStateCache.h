@@ -0,0 +1,80 @@
+#pragma once
+#include <GLES3/gl3.h>
+
+// Shadow of the GL state the wrapper changes. Every setter only calls GL when
+// the value differs from the one sent last, so the device can translate its
+// D3D8 state at each draw without issuing redundant GL calls.
+class GLESStateCache {
+public:
+    enum Capability {
+        CAP_DEPTH_TEST,
+        CAP_BLEND,
+        CAP_CULL_FACE,
+        CAP_SCISSOR_TEST,
+        CAP_COUNT
+    };
+
+    enum { MAX_TEXTURE_UNITS = 8 };
+
+    struct Stats {
+        unsigned int glCalls;
+        unsigned int skippedCalls;
+    };
+
+    GLESStateCache();
+
+    // Needs a current context. The sampler objects hold the per stage filter and address state.
+    void Init();
+    void Shutdown();
+
+    // Forgets all shadowed values, the next setters always reach GL
+    void Invalidate();
+
+    void SetEnabled(Capability cap, bool enabled);
+    void SetDepthMask(bool enabled);
+    void SetDepthFunc(GLenum func);
+    void SetBlendFunc(GLenum src, GLenum dst);
+    void SetFrontFace(GLenum mode);
+    void UseProgram(GLuint program);
+
+    void BindTexture(unsigned int unit, GLuint texture);
+    // Binds to whichever unit is active, for uploads outside of draws
+    void BindTextureForUpdate(GLuint texture);
+    // GL unbinds deleted textures, so the names may be reused
+    void ForgetTexture(GLuint texture);
+
+    void SetSampler(unsigned int unit, GLenum minFilter, GLenum magFilter, GLenum wrapS, GLenum wrapT);
+
+    void EndFrame();
+    const Stats& GetLastFrameStats() const { return m_lastFrameStats; }
+
+private:
+    struct SamplerState {
+        GLenum minFilter;
+        GLenum magFilter;
+        GLenum wrapS;
+        GLenum wrapT;
+    };
+
+    void SetActiveTexture(unsigned int unit);
+    void SetSamplerParameter(unsigned int unit, GLenum pname, GLenum& current, GLenum value);
+    bool Skip(bool same) { if (same) m_frameStats.skippedCalls++; else m_frameStats.glCalls++; return same; }
+
+    static const GLenum INVALID_ENUM_VALUE = 0xFFFFFFFF;
+    static const GLuint INVALID_NAME = 0xFFFFFFFF;
+
+    signed char m_enabled[CAP_COUNT]; // -1 when unknown
+    signed char m_depthMask;
+    GLenum m_depthFunc;
+    GLenum m_blendSrc;
+    GLenum m_blendDst;
+    GLenum m_frontFace;
+    GLuint m_program;
+    unsigned int m_activeTexture;
+    GLuint m_boundTextures[MAX_TEXTURE_UNITS];
+    GLuint m_samplers[MAX_TEXTURE_UNITS];
+    SamplerState m_samplerStates[MAX_TEXTURE_UNITS];
+
+    Stats m_frameStats;
+    Stats m_lastFrameStats;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "d3d8.h"
 #include <GLES3/gl3.h>
+#include <stdint.h>
 #include <vector>
 
 class GLESTexture8 : public IDirect3DTexture8 {
@@ -38,7 +39,15 @@ public:
     // Internal
     GLuint GetGLTextureID() const { return m_textureID; }
 
+    // Upload statistics, EndFrame is called once per presented frame
+    static void EndFrame();
+    static uint64_t GetLastFrameUploadBytes() { return s_lastFrameUploadBytes; }
+    static UINT GetLastFrameUploadCount() { return s_lastFrameUploadCount; }
+
 private:
+    void MarkDirty(UINT Level, CONST RECT* pRect);
+    void UploadDirty(UINT Level);
+
     IDirect3DDevice8* m_device;
     ULONG m_refCount;
     UINT m_width;
@@ -47,10 +56,19 @@ private:
     D3DFORMAT m_format;
     GLuint m_textureID;
     
+    // The GL storage of all levels is allocated once. Locks only mark the locked
+    // rectangle dirty and unlocking uploads just that rectangle.
     struct MipLevel {
         std::vector<unsigned char> data;
         UINT width;
         UINT height;
+        RECT dirty;
+        bool isDirty;
     };
     std::vector<MipLevel> m_mipLevels;
+
+    static uint64_t s_frameUploadBytes;
+    static UINT s_frameUploadCount;
+    static uint64_t s_lastFrameUploadBytes;
+    static UINT s_lastFrameUploadCount;
 };
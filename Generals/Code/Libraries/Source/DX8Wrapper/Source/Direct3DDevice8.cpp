@@ -3,6 +3,8 @@
 #include "GLESVertexBuffer8.h"
 #include "GLESIndexBuffer8.h"
 #include "GLESSurface8.h"
+#include "GLESProgramCache.h"
+#include <chrono>
 
 #define LOG_TAG "DX8Wrapper"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
@@ -10,9 +12,20 @@
 
 DX8Wrapper_Direct3DDevice8::DX8Wrapper_Direct3DDevice8(HWND hWnd) {
     InitEGL(hWnd);
+    m_glState.Init();
+    // Relative to the game data directory
+    GLESProgramCache::Init("ShaderCache");
+    InitState();
 }
 
 DX8Wrapper_Direct3DDevice8::~DX8Wrapper_Direct3DDevice8() {
+    if (m_recordingBlock) DestroyStateBlock(m_recordingBlock);
+    for (auto* block : m_stateBlocks) {
+        if (block) DestroyStateBlock(block);
+    }
+    m_stateBlocks.clear();
+    GLESProgramCache::Shutdown();
+    m_glState.Shutdown();
     CleanupEGL();
     for (auto* shader : m_vertexShaders) delete shader;
     for (auto* shader : m_pixelShaders) delete shader;
@@ -87,6 +100,193 @@ void DX8Wrapper_Direct3DDevice8::CleanupEGL() {
     m_surface = EGL_NO_SURFACE;
 }
 
+void DX8Wrapper_Direct3DDevice8::InitState() {
+    // D3D8 device defaults
+    m_renderStates[D3DRS_ZENABLE] = D3DZB_TRUE;
+    m_renderStates[D3DRS_FILLMODE] = D3DFILL_SOLID;
+    m_renderStates[D3DRS_SHADEMODE] = D3DSHADE_GOURAUD;
+    m_renderStates[D3DRS_ZWRITEENABLE] = TRUE;
+    m_renderStates[D3DRS_LASTPIXEL] = TRUE;
+    m_renderStates[D3DRS_SRCBLEND] = D3DBLEND_ONE;
+    m_renderStates[D3DRS_DESTBLEND] = D3DBLEND_ZERO;
+    m_renderStates[D3DRS_CULLMODE] = D3DCULL_CCW;
+    m_renderStates[D3DRS_ZFUNC] = D3DCMP_LESSEQUAL;
+    m_renderStates[D3DRS_ALPHAFUNC] = D3DCMP_ALWAYS;
+    m_renderStates[D3DRS_STENCILFUNC] = D3DCMP_ALWAYS;
+    m_renderStates[D3DRS_STENCILFAIL] = D3DSTENCILOP_KEEP;
+    m_renderStates[D3DRS_STENCILZFAIL] = D3DSTENCILOP_KEEP;
+    m_renderStates[D3DRS_STENCILPASS] = D3DSTENCILOP_KEEP;
+    m_renderStates[D3DRS_STENCILMASK] = 0xFFFFFFFF;
+    m_renderStates[D3DRS_STENCILWRITEMASK] = 0xFFFFFFFF;
+    m_renderStates[D3DRS_TEXTUREFACTOR] = 0xFFFFFFFF;
+    m_renderStates[D3DRS_CLIPPING] = TRUE;
+    m_renderStates[D3DRS_LIGHTING] = TRUE;
+    m_renderStates[D3DRS_COLORVERTEX] = TRUE;
+    m_renderStates[D3DRS_LOCALVIEWER] = TRUE;
+    m_renderStates[D3DRS_DIFFUSEMATERIALSOURCE] = D3DMCS_COLOR1;
+    m_renderStates[D3DRS_SPECULARMATERIALSOURCE] = D3DMCS_COLOR2;
+    m_renderStates[D3DRS_MULTISAMPLEANTIALIAS] = TRUE;
+    m_renderStates[D3DRS_MULTISAMPLEMASK] = 0xFFFFFFFF;
+    m_renderStates[D3DRS_COLORWRITEENABLE] = 0x0000000F;
+    m_renderStates[D3DRS_BLENDOP] = D3DBLENDOP_ADD;
+
+    for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+        DWORD* tss = m_textureStageStates[stage];
+        tss[D3DTSS_COLOROP] = stage == 0 ? D3DTOP_MODULATE : D3DTOP_DISABLE;
+        tss[D3DTSS_COLORARG1] = D3DTA_TEXTURE;
+        tss[D3DTSS_COLORARG2] = D3DTA_CURRENT;
+        tss[D3DTSS_ALPHAOP] = stage == 0 ? D3DTOP_SELECTARG1 : D3DTOP_DISABLE;
+        tss[D3DTSS_ALPHAARG1] = D3DTA_TEXTURE;
+        tss[D3DTSS_ALPHAARG2] = D3DTA_CURRENT;
+        tss[D3DTSS_TEXCOORDINDEX] = stage;
+        tss[D3DTSS_ADDRESSU] = D3DTADDRESS_WRAP;
+        tss[D3DTSS_ADDRESSV] = D3DTADDRESS_WRAP;
+        tss[D3DTSS_ADDRESSW] = D3DTADDRESS_WRAP;
+        tss[D3DTSS_MAGFILTER] = D3DTEXF_POINT;
+        tss[D3DTSS_MINFILTER] = D3DTEXF_POINT;
+        tss[D3DTSS_MIPFILTER] = D3DTEXF_NONE;
+        tss[D3DTSS_MAXANISOTROPY] = 1;
+        tss[D3DTSS_COLORARG0] = D3DTA_CURRENT;
+        tss[D3DTSS_ALPHAARG0] = D3DTA_CURRENT;
+        tss[D3DTSS_RESULTARG] = D3DTA_CURRENT;
+    }
+
+    m_dirtyStates = DIRTY_ALL;
+    m_dirtySamplers = (1 << MAX_TEXTURE_STAGES) - 1;
+}
+
+unsigned int DX8Wrapper_Direct3DDevice8::GetRenderStateDirtyFlags(D3DRENDERSTATETYPE State) {
+    switch (State) {
+        case D3DRS_ZENABLE:
+        case D3DRS_ZWRITEENABLE:
+        case D3DRS_ZFUNC:
+            return DIRTY_DEPTH;
+        case D3DRS_ALPHABLENDENABLE:
+        case D3DRS_SRCBLEND:
+        case D3DRS_DESTBLEND:
+            return DIRTY_BLEND;
+        case D3DRS_CULLMODE:
+            return DIRTY_CULL;
+        default:
+            return 0;
+    }
+}
+
+static bool IsSamplerState(D3DTEXTURESTAGESTATETYPE Type) {
+    switch (Type) {
+        case D3DTSS_ADDRESSU:
+        case D3DTSS_ADDRESSV:
+        case D3DTSS_MAGFILTER:
+        case D3DTSS_MINFILTER:
+        case D3DTSS_MIPFILTER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static GLenum ConvertBlend(DWORD blend) {
+    switch (blend) {
+        case D3DBLEND_ZERO: return GL_ZERO;
+        case D3DBLEND_ONE: return GL_ONE;
+        case D3DBLEND_SRCCOLOR: return GL_SRC_COLOR;
+        case D3DBLEND_INVSRCCOLOR: return GL_ONE_MINUS_SRC_COLOR;
+        case D3DBLEND_SRCALPHA: return GL_SRC_ALPHA;
+        case D3DBLEND_INVSRCALPHA: return GL_ONE_MINUS_SRC_ALPHA;
+        case D3DBLEND_DESTALPHA: return GL_DST_ALPHA;
+        case D3DBLEND_INVDESTALPHA: return GL_ONE_MINUS_DST_ALPHA;
+        case D3DBLEND_DESTCOLOR: return GL_DST_COLOR;
+        case D3DBLEND_INVDESTCOLOR: return GL_ONE_MINUS_DST_COLOR;
+        case D3DBLEND_SRCALPHASAT: return GL_SRC_ALPHA_SATURATE;
+        default: return GL_ONE;
+    }
+}
+
+static GLenum ConvertCompareFunc(DWORD func) {
+    switch (func) {
+        case D3DCMP_NEVER: return GL_NEVER;
+        case D3DCMP_LESS: return GL_LESS;
+        case D3DCMP_EQUAL: return GL_EQUAL;
+        case D3DCMP_LESSEQUAL: return GL_LEQUAL;
+        case D3DCMP_GREATER: return GL_GREATER;
+        case D3DCMP_NOTEQUAL: return GL_NOTEQUAL;
+        case D3DCMP_GREATEREQUAL: return GL_GEQUAL;
+        default: return GL_ALWAYS;
+    }
+}
+
+static GLenum ConvertAddress(DWORD address) {
+    switch (address) {
+        case D3DTADDRESS_WRAP: return GL_REPEAT;
+        case D3DTADDRESS_MIRROR: return GL_MIRRORED_REPEAT;
+        default: return GL_CLAMP_TO_EDGE; // GLES has no border color
+    }
+}
+
+static GLenum ConvertMinFilter(DWORD minFilter, DWORD mipFilter) {
+    const bool linear = minFilter != D3DTEXF_POINT && minFilter != D3DTEXF_NONE;
+    switch (mipFilter) {
+        case D3DTEXF_NONE: return linear ? GL_LINEAR : GL_NEAREST;
+        case D3DTEXF_POINT: return linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+        default: return linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+    }
+}
+
+// Translates the state that changed since the last draw. Redundant GL calls are
+// dropped by the GL state cache.
+void DX8Wrapper_Direct3DDevice8::ApplyState() {
+    if (m_dirtyStates & DIRTY_DEPTH) {
+        m_glState.SetEnabled(GLESStateCache::CAP_DEPTH_TEST, m_renderStates[D3DRS_ZENABLE] != D3DZB_FALSE);
+        m_glState.SetDepthMask(m_renderStates[D3DRS_ZWRITEENABLE] != FALSE);
+        m_glState.SetDepthFunc(ConvertCompareFunc(m_renderStates[D3DRS_ZFUNC]));
+    }
+
+    if (m_dirtyStates & DIRTY_BLEND) {
+        m_glState.SetEnabled(GLESStateCache::CAP_BLEND, m_renderStates[D3DRS_ALPHABLENDENABLE] != FALSE);
+        const DWORD src = m_renderStates[D3DRS_SRCBLEND];
+        if (src == D3DBLEND_BOTHSRCALPHA) {
+            m_glState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        } else if (src == D3DBLEND_BOTHINVSRCALPHA) {
+            m_glState.SetBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+        } else {
+            m_glState.SetBlendFunc(ConvertBlend(src), ConvertBlend(m_renderStates[D3DRS_DESTBLEND]));
+        }
+    }
+
+    if (m_dirtyStates & DIRTY_CULL) {
+        const DWORD cullMode = m_renderStates[D3DRS_CULLMODE];
+        if (cullMode == D3DCULL_NONE) {
+            m_glState.SetEnabled(GLESStateCache::CAP_CULL_FACE, false);
+        } else {
+            m_glState.SetEnabled(GLESStateCache::CAP_CULL_FACE, true);
+            // CW vs CCW? DX is usually CW? OGL CCW?
+            // D3DCULL_CW: Cull CW faces.
+            // D3DCULL_CCW: Cull CCW faces.
+            // glCullFace(GL_BACK). glFrontFace(GL_CCW default).
+            if (cullMode == D3DCULL_CW) m_glState.SetFrontFace(GL_CCW); // Cull CW (Back)
+            else m_glState.SetFrontFace(GL_CW); // Cull CCW (Front) -> Back is CW?
+        }
+    }
+    m_dirtyStates = 0;
+
+    for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+        // Always checked, texture uploads may bind to any unit
+        IDirect3DBaseTexture8* texture = m_currentTextures[stage];
+        // Assume texture is GLESTexture8 (2D)
+        m_glState.BindTexture(stage, texture ? static_cast<GLESTexture8*>(texture)->GetGLTextureID() : 0);
+
+        if (m_dirtySamplers & (1 << stage)) {
+            const DWORD* tss = m_textureStageStates[stage];
+            m_glState.SetSampler(stage,
+                ConvertMinFilter(tss[D3DTSS_MINFILTER], tss[D3DTSS_MIPFILTER]),
+                tss[D3DTSS_MAGFILTER] == D3DTEXF_POINT ? GL_NEAREST : GL_LINEAR,
+                ConvertAddress(tss[D3DTSS_ADDRESSU]),
+                ConvertAddress(tss[D3DTSS_ADDRESSV]));
+        }
+    }
+    m_dirtySamplers = 0;
+}
+
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::TestCooperativeLevel() { return D3D_OK; }
 UINT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetAvailableTextureMem() { return 1024 * 1024 * 512; } // 512 MB
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::ResourceManagerDiscardBytes(DWORD Bytes) { return D3D_OK; }
@@ -164,6 +364,8 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::Present(CONST RECT* pSourc
             return D3DERR_DEVICELOST;
         }
     }
+    GLESTexture8::EndFrame();
+    m_glState.EndFrame();
     return D3D_OK; 
 }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetBackBuffer(UINT BackBuffer, D3DBACKBUFFER_TYPE Type, IDirect3DSurface8** ppBackBuffer) { 
@@ -221,6 +423,9 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::Clear(DWORD Count, CONST D
     if (Flags & D3DCLEAR_ZBUFFER) {
         mask |= GL_DEPTH_BUFFER_BIT;
         glClearDepthf(Z);
+        // D3D clears depth regardless of D3DRS_ZWRITEENABLE
+        m_glState.SetDepthMask(true);
+        m_dirtyStates |= DIRTY_DEPTH;
     }
     if (Flags & D3DCLEAR_STENCIL) {
         mask |= GL_STENCIL_BUFFER_BIT;
@@ -229,14 +434,14 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::Clear(DWORD Count, CONST D
     
     if (Count > 0 && pRects) {
         // Scissoring for partial clear
-        glEnable(GL_SCISSOR_TEST);
+        m_glState.SetEnabled(GLESStateCache::CAP_SCISSOR_TEST, true);
         for (DWORD i = 0; i < Count; ++i) {
             // D3DRECT is x1, y1, x2, y2. GLES Scissor is x, y, width, height (y from bottom)
             // TODO: Y-flip handling
             glScissor(pRects[i].x1, pRects[i].y1, pRects[i].x2 - pRects[i].x1, pRects[i].y2 - pRects[i].y1);
             glClear(mask);
         }
-        glDisable(GL_SCISSOR_TEST);
+        m_glState.SetEnabled(GLESStateCache::CAP_SCISSOR_TEST, false);
     } else {
         glClear(mask);
     }
@@ -262,44 +467,167 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetLightEnable(DWORD Index
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetClipPlane(DWORD Index, CONST float* pPlane) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetClipPlane(DWORD Index, float* pPlane) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetRenderState(D3DRENDERSTATETYPE State, DWORD Value) {
-    switch(State) {
-        case D3DRS_ZENABLE:
-            if (Value) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-            break;
-        case D3DRS_ZWRITEENABLE:
-            glDepthMask(Value ? GL_TRUE : GL_FALSE);
-            break;
-        case D3DRS_ALPHABLENDENABLE:
-            if (Value) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-            break;
-        case D3DRS_SRCBLEND:
-        case D3DRS_DESTBLEND:
-            // TODO: Map blend factors
-            break;
-        case D3DRS_CULLMODE:
-            if (Value == D3DCULL_NONE) glDisable(GL_CULL_FACE);
-            else {
-                glEnable(GL_CULL_FACE);
-                // CW vs CCW? DX is usually CW? OGL CCW?
-                // D3DCULL_CW: Cull CW faces.
-                // D3DCULL_CCW: Cull CCW faces.
-                // glCullFace(GL_BACK). glFrontFace(GL_CCW default).
-                if (Value == D3DCULL_CW) glFrontFace(GL_CCW); // Cull CW (Back)
-                else glFrontFace(GL_CW); // Cull CCW (Front) -> Back is CW?
-            }
-            break;
-        default:
-            break;
+    if ((DWORD)State >= MAX_RENDER_STATES) return D3DERR_INVALIDCALL;
+
+    if (m_recordingBlock) {
+        m_recordingBlock->renderStates[State] = Value;
+        m_recordingBlock->renderStateMask.set(State);
+        return D3D_OK;
     }
+
+    if (m_renderStates[State] == Value) return D3D_OK;
+    m_renderStates[State] = Value;
+    m_dirtyStates |= GetRenderStateDirtyFlags(State);
     return D3D_OK; 
 }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetRenderState(D3DRENDERSTATETYPE State, DWORD* pValue) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::BeginStateBlock() { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::EndStateBlock(DWORD* pToken) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::ApplyStateBlock(DWORD Token) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CaptureStateBlock(DWORD Token) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DeleteStateBlock(DWORD Token) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CreateStateBlock(D3DSTATEBLOCKTYPE Type, DWORD* pToken) { return D3D_OK; }
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetRenderState(D3DRENDERSTATETYPE State, DWORD* pValue) {
+    if ((DWORD)State >= MAX_RENDER_STATES || !pValue) return D3DERR_INVALIDCALL;
+    *pValue = m_renderStates[State];
+    return D3D_OK;
+}
+
+// Render states that belong to D3DSBT_PIXELSTATE and D3DSBT_VERTEXSTATE blocks
+static const D3DRENDERSTATETYPE s_pixelRenderStates[] = {
+    D3DRS_ZENABLE, D3DRS_FILLMODE, D3DRS_SHADEMODE, D3DRS_LINEPATTERN, D3DRS_ZWRITEENABLE,
+    D3DRS_ALPHATESTENABLE, D3DRS_LASTPIXEL, D3DRS_SRCBLEND, D3DRS_DESTBLEND, D3DRS_ZFUNC,
+    D3DRS_ALPHAREF, D3DRS_ALPHAFUNC, D3DRS_DITHERENABLE, D3DRS_FOGSTART, D3DRS_FOGEND,
+    D3DRS_FOGDENSITY, D3DRS_ALPHABLENDENABLE, D3DRS_ZBIAS, D3DRS_STENCILENABLE, D3DRS_STENCILFAIL,
+    D3DRS_STENCILZFAIL, D3DRS_STENCILPASS, D3DRS_STENCILFUNC, D3DRS_STENCILREF, D3DRS_STENCILMASK,
+    D3DRS_STENCILWRITEMASK, D3DRS_TEXTUREFACTOR, D3DRS_WRAP0, D3DRS_WRAP1, D3DRS_WRAP2,
+    D3DRS_WRAP3, D3DRS_WRAP4, D3DRS_WRAP5, D3DRS_WRAP6, D3DRS_WRAP7,
+    D3DRS_COLORWRITEENABLE, D3DRS_BLENDOP, D3DRS_EDGEANTIALIAS
+};
+static const D3DRENDERSTATETYPE s_vertexRenderStates[] = {
+    D3DRS_SHADEMODE, D3DRS_SPECULARENABLE, D3DRS_CULLMODE, D3DRS_FOGENABLE, D3DRS_FOGCOLOR,
+    D3DRS_FOGTABLEMODE, D3DRS_FOGSTART, D3DRS_FOGEND, D3DRS_FOGDENSITY, D3DRS_RANGEFOGENABLE,
+    D3DRS_AMBIENT, D3DRS_COLORVERTEX, D3DRS_FOGVERTEXMODE, D3DRS_CLIPPING, D3DRS_LIGHTING,
+    D3DRS_NORMALIZENORMALS, D3DRS_LOCALVIEWER, D3DRS_EMISSIVEMATERIALSOURCE, D3DRS_AMBIENTMATERIALSOURCE,
+    D3DRS_DIFFUSEMATERIALSOURCE, D3DRS_SPECULARMATERIALSOURCE, D3DRS_VERTEXBLEND, D3DRS_CLIPPLANEENABLE,
+    D3DRS_SOFTWAREVERTEXPROCESSING, D3DRS_POINTSIZE, D3DRS_POINTSIZE_MIN, D3DRS_POINTSPRITEENABLE,
+    D3DRS_POINTSCALEENABLE, D3DRS_POINTSCALE_A, D3DRS_POINTSCALE_B, D3DRS_POINTSCALE_C,
+    D3DRS_MULTISAMPLEANTIALIAS, D3DRS_MULTISAMPLEMASK, D3DRS_PATCHEDGESTYLE, D3DRS_PATCHSEGMENTS,
+    D3DRS_POINTSIZE_MAX, D3DRS_INDEXEDVERTEXBLENDENABLE, D3DRS_TWEENFACTOR
+};
+static const D3DTEXTURESTAGESTATETYPE s_pixelTextureStageStates[] = {
+    D3DTSS_COLOROP, D3DTSS_COLORARG1, D3DTSS_COLORARG2, D3DTSS_ALPHAOP, D3DTSS_ALPHAARG1,
+    D3DTSS_ALPHAARG2, D3DTSS_BUMPENVMAT00, D3DTSS_BUMPENVMAT01, D3DTSS_BUMPENVMAT10, D3DTSS_BUMPENVMAT11,
+    D3DTSS_ADDRESSU, D3DTSS_ADDRESSV, D3DTSS_BORDERCOLOR, D3DTSS_MAGFILTER, D3DTSS_MINFILTER,
+    D3DTSS_MIPFILTER, D3DTSS_MIPMAPLODBIAS, D3DTSS_MAXMIPLEVEL, D3DTSS_MAXANISOTROPY, D3DTSS_BUMPENVLSCALE,
+    D3DTSS_BUMPENVLOFFSET, D3DTSS_ADDRESSW, D3DTSS_COLORARG0, D3DTSS_ALPHAARG0, D3DTSS_RESULTARG
+};
+static const D3DTEXTURESTAGESTATETYPE s_vertexTextureStageStates[] = {
+    D3DTSS_TEXCOORDINDEX, D3DTSS_TEXTURETRANSFORMFLAGS
+};
+
+DX8Wrapper_Direct3DDevice8::StateBlock* DX8Wrapper_Direct3DDevice8::FindStateBlock(DWORD token) {
+    if (token == 0 || token > m_stateBlocks.size()) return nullptr;
+    return m_stateBlocks[token - 1];
+}
+
+void DX8Wrapper_Direct3DDevice8::SetStateBlockTexture(StateBlock* block, DWORD stage, IDirect3DBaseTexture8* texture) {
+    if (texture) texture->AddRef();
+    if (block->textureMask.test(stage) && block->textures[stage]) block->textures[stage]->Release();
+    block->textures[stage] = texture;
+    block->textureMask.set(stage);
+}
+
+void DX8Wrapper_Direct3DDevice8::DestroyStateBlock(StateBlock* block) {
+    for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+        if (block->textureMask.test(stage) && block->textures[stage]) block->textures[stage]->Release();
+    }
+    delete block;
+}
+
+// Copies the current values of all states the block holds
+void DX8Wrapper_Direct3DDevice8::CaptureState(StateBlock* block) {
+    for (DWORD i = 0; i < MAX_RENDER_STATES; i++) {
+        if (block->renderStateMask.test(i)) block->renderStates[i] = m_renderStates[i];
+    }
+    for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+        for (DWORD i = 0; i < MAX_TEXTURE_STAGE_STATES; i++) {
+            if (block->textureStageStateMask[stage].test(i)) block->textureStageStates[stage][i] = m_textureStageStates[stage][i];
+        }
+        if (block->textureMask.test(stage)) SetStateBlockTexture(block, stage, m_currentTextures[stage]);
+    }
+    if (block->hasVertexShader) block->vertexShader = m_currentVertexShader;
+    if (block->hasPixelShader) block->pixelShader = m_currentPixelShader;
+}
+
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::BeginStateBlock() {
+    if (m_recordingBlock) return D3DERR_INVALIDCALL;
+    m_recordingBlock = new StateBlock();
+    return D3D_OK;
+}
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::EndStateBlock(DWORD* pToken) {
+    if (!m_recordingBlock || !pToken) return D3DERR_INVALIDCALL;
+    m_stateBlocks.push_back(m_recordingBlock);
+    m_recordingBlock = nullptr;
+    *pToken = (DWORD)m_stateBlocks.size();
+    return D3D_OK;
+}
+// Goes through the regular Set calls, so states that already match are dropped
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::ApplyStateBlock(DWORD Token) {
+    StateBlock* block = FindStateBlock(Token);
+    if (!block || m_recordingBlock) return D3DERR_INVALIDCALL;
+
+    for (DWORD i = 0; i < MAX_RENDER_STATES; i++) {
+        if (block->renderStateMask.test(i)) SetRenderState((D3DRENDERSTATETYPE)i, block->renderStates[i]);
+    }
+    for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+        for (DWORD i = 0; i < MAX_TEXTURE_STAGE_STATES; i++) {
+            if (block->textureStageStateMask[stage].test(i)) SetTextureStageState(stage, (D3DTEXTURESTAGESTATETYPE)i, block->textureStageStates[stage][i]);
+        }
+        if (block->textureMask.test(stage)) SetTexture(stage, block->textures[stage]);
+    }
+    if (block->hasVertexShader) SetVertexShader(block->vertexShader);
+    if (block->hasPixelShader) SetPixelShader(block->pixelShader);
+    return D3D_OK;
+}
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CaptureStateBlock(DWORD Token) {
+    StateBlock* block = FindStateBlock(Token);
+    if (!block || m_recordingBlock) return D3DERR_INVALIDCALL;
+    CaptureState(block);
+    return D3D_OK;
+}
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DeleteStateBlock(DWORD Token) {
+    StateBlock* block = FindStateBlock(Token);
+    if (!block) return D3DERR_INVALIDCALL;
+    DestroyStateBlock(block);
+    m_stateBlocks[Token - 1] = nullptr;
+    return D3D_OK;
+}
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CreateStateBlock(D3DSTATEBLOCKTYPE Type, DWORD* pToken) {
+    if (!pToken || m_recordingBlock) return D3DERR_INVALIDCALL;
+
+    StateBlock* block = new StateBlock();
+    if (Type == D3DSBT_ALL) {
+        block->renderStateMask.set();
+        for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) block->textureStageStateMask[stage].set();
+        for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) SetStateBlockTexture(block, stage, nullptr);
+        block->hasVertexShader = true;
+        block->hasPixelShader = true;
+    } else if (Type == D3DSBT_PIXELSTATE) {
+        for (auto state : s_pixelRenderStates) block->renderStateMask.set(state);
+        for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+            for (auto type : s_pixelTextureStageStates) block->textureStageStateMask[stage].set(type);
+        }
+        block->hasPixelShader = true;
+    } else if (Type == D3DSBT_VERTEXSTATE) {
+        for (auto state : s_vertexRenderStates) block->renderStateMask.set(state);
+        for (DWORD stage = 0; stage < MAX_TEXTURE_STAGES; stage++) {
+            for (auto type : s_vertexTextureStageStates) block->textureStageStateMask[stage].set(type);
+        }
+        block->hasVertexShader = true;
+    } else {
+        delete block;
+        return D3DERR_INVALIDCALL;
+    }
+
+    CaptureState(block);
+    m_stateBlocks.push_back(block);
+    *pToken = (DWORD)m_stateBlocks.size();
+    return D3D_OK;
+}
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetClipStatus(CONST D3DCLIPSTATUS8* pClipStatus) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetClipStatus(D3DCLIPSTATUS8* pClipStatus) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetTexture(DWORD Stage, IDirect3DBaseTexture8** ppTexture) { 
@@ -311,26 +639,42 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetTexture(DWORD Stage, ID
 
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetTexture(DWORD Stage, IDirect3DBaseTexture8* pTexture) {
     if (Stage >= 8) return D3DERR_INVALIDCALL;
+
+    if (m_recordingBlock) {
+        SetStateBlockTexture(m_recordingBlock, Stage, pTexture);
+        return D3D_OK;
+    }
+
+    if (m_currentTextures[Stage] == pTexture) return D3D_OK;
     
     // Release old
     if (m_currentTextures[Stage]) m_currentTextures[Stage]->Release();
     
     m_currentTextures[Stage] = pTexture;
     if (pTexture) pTexture->AddRef();
-    
-    glActiveTexture(GL_TEXTURE0 + Stage);
-    if (pTexture) {
-        // Assume texture is GLESTexture8 (2D)
-        GLESTexture8* tex = static_cast<GLESTexture8*>(pTexture);
-        glBindTexture(GL_TEXTURE_2D, tex->GetGLTextureID());
-    } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-    
+
+    // Bound in ApplyState at the next draw
     return D3D_OK; 
 }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD* pValue) { return D3D_OK; }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD Value) { return D3D_OK; }
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD* pValue) {
+    if (Stage >= MAX_TEXTURE_STAGES || (DWORD)Type >= MAX_TEXTURE_STAGE_STATES || !pValue) return D3DERR_INVALIDCALL;
+    *pValue = m_textureStageStates[Stage][Type];
+    return D3D_OK;
+}
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD Value) {
+    if (Stage >= MAX_TEXTURE_STAGES || (DWORD)Type >= MAX_TEXTURE_STAGE_STATES) return D3DERR_INVALIDCALL;
+
+    if (m_recordingBlock) {
+        m_recordingBlock->textureStageStates[Stage][Type] = Value;
+        m_recordingBlock->textureStageStateMask[Stage].set(Type);
+        return D3D_OK;
+    }
+
+    if (m_textureStageStates[Stage][Type] == Value) return D3D_OK;
+    m_textureStageStates[Stage][Type] = Value;
+    if (IsSamplerState(Type)) m_dirtySamplers |= 1 << Stage;
+    return D3D_OK;
+}
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::ValidateDevice(DWORD* pNumPasses) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetInfo(DWORD DevInfoID, void* pDevInfoStruct, DWORD DevInfoStructSize) { return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetPaletteEntries(UINT PaletteNumber, CONST PALETTEENTRY* pEntries) { return D3D_OK; }
@@ -361,6 +705,8 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DrawPrimitive(D3DPRIMITIVE
         default: break;
     }
 
+    ApplyState();
+
     DWORD fvf = m_currentVertexShader;
     BOOL isFVF = (fvf < 0x1000); 
 
@@ -368,7 +714,7 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DrawPrimitive(D3DPRIMITIVE
         // Programmable Pipeline
         GLuint program = GetShaderProgram(fvf, m_currentPixelShader);
         if (program) {
-            glUseProgram(program);
+            m_glState.UseProgram(program);
             
             // Bind Uniforms
             GLint locVC = glGetUniformLocation(program, "vc");
@@ -475,6 +821,8 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DrawIndexedPrimitive(D3DPR
     
     BYTE* ptr = vData;
 
+    ApplyState();
+
     // FVF Logic (Duplicate... better to refactor)
     DWORD fvf = m_currentVertexShader;
     BOOL isFVF = (fvf < 0x1000); 
@@ -482,7 +830,7 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DrawIndexedPrimitive(D3DPR
     if (!isFVF) {
          GLuint program = GetShaderProgram(fvf, m_currentPixelShader);
          if (program) {
-            glUseProgram(program);
+            m_glState.UseProgram(program);
             GLint locVC = glGetUniformLocation(program, "vc");
             if (locVC != -1) glUniform4fv(locVC, 96, (const GLfloat*)m_vsConstants);
             GLint locPC = glGetUniformLocation(program, "pc");
@@ -570,10 +918,15 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CreateVertexShader(CONST D
     return D3D_OK;
 }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetVertexShader(DWORD Handle) {
+    if (m_recordingBlock) {
+        m_recordingBlock->vertexShader = Handle;
+        m_recordingBlock->hasVertexShader = true;
+        return D3D_OK;
+    }
     m_currentVertexShader = Handle;
     return D3D_OK; 
 }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetVertexShader(DWORD* pHandle) { *pHandle = 0; return D3D_OK; }
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetVertexShader(DWORD* pHandle) { *pHandle = m_currentVertexShader; return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DeleteVertexShader(DWORD Handle) {
     // Basic stub - we don't actually delete from vector to keep indices valid simple
     return D3D_OK; 
@@ -627,10 +980,15 @@ HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::CreatePixelShader(CONST DW
     return D3D_OK;
 }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::SetPixelShader(DWORD Handle) {
+    if (m_recordingBlock) {
+        m_recordingBlock->pixelShader = Handle;
+        m_recordingBlock->hasPixelShader = true;
+        return D3D_OK;
+    }
     m_currentPixelShader = Handle;
     return D3D_OK;
 }
-HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetPixelShader(DWORD* pHandle) { *pHandle = 0; return D3D_OK; }
+HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::GetPixelShader(DWORD* pHandle) { *pHandle = m_currentPixelShader; return D3D_OK; }
 HRESULT STDMETHODCALLTYPE DX8Wrapper_Direct3DDevice8::DeletePixelShader(DWORD Handle) {
     return D3D_OK; 
 }
@@ -649,18 +1007,23 @@ GLuint DX8Wrapper_Direct3DDevice8::GetShaderProgram(DWORD vsHandle, DWORD psHand
     unsigned long long key = ((unsigned long long)vsHandle << 32) | psHandle;
     auto it = m_programCache.find(key);
     if (it != m_programCache.end()) {
-        return it->second;
+        ProgramEntry& entry = it->second;
+        if (entry.mapSerial != GLESProgramCache::GetMapSerial()) {
+            entry.mapSerial = GLESProgramCache::GetMapSerial();
+            GLESProgramCache::RecordUse(entry.sourceKey);
+        }
+        return entry.program;
     }
 
     // Link new program
-    GLuint vs = 0;
-    GLuint ps = 0;
+    GLESVertexShader* vertexShader = nullptr;
+    GLESPixelShader* pixelShader = nullptr;
 
     // Resolve VS
     if (vsHandle >= 0x1000) {
         size_t index = vsHandle - 0x1000;
         if (index < m_vertexShaders.size() && m_vertexShaders[index]) {
-            vs = m_vertexShaders[index]->GetShaderObject();
+            vertexShader = m_vertexShaders[index];
         }
     } else {
         // FVF / Fixed Function - Not supported in this path yet
@@ -672,35 +1035,51 @@ GLuint DX8Wrapper_Direct3DDevice8::GetShaderProgram(DWORD vsHandle, DWORD psHand
     if (psHandle >= 0x2000) {
         size_t index = psHandle - 0x2000;
         if (index < m_pixelShaders.size() && m_pixelShaders[index]) {
-            ps = m_pixelShaders[index]->GetShaderObject();
+            pixelShader = m_pixelShaders[index];
         }
     } else {
         // Fixed function PS? 0 is valid for no PS?
         // If 0, use default white/texture PS?
     }
 
-    if (!vs) return 0; // VS is mandatory for programmable pipeline
+    if (!vertexShader) return 0; // VS is mandatory for programmable pipeline
 
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vs);
-    if (ps) glAttachShader(program, ps);
+    // Programs linked in an earlier run or for other handles with the same source skip compiling and linking
+    const uint64_t sourceKey = GLESProgramCache::MakeKey(vertexShader->GetSourceHash(), pixelShader ? pixelShader->GetSourceHash() : 0);
+    GLuint program = GLESProgramCache::Find(sourceKey);
 
-    glLinkProgram(program);
-    
-    GLint linked;
-    glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    if (!linked) {
-        GLint infoLen = 0;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
-        if (infoLen > 1) {
-            std::vector<char> infoLog(infoLen);
-            glGetProgramInfoLog(program, infoLen, nullptr, infoLog.data());
-            LOGE("Error linking program (VS %u, PS %u):\n%s", (unsigned int)vsHandle, (unsigned int)psHandle, infoLog.data());
+    if (!program) {
+        GLuint vs = vertexShader->GetShaderObject();
+        GLuint ps = pixelShader ? pixelShader->GetShaderObject() : 0;
+        if (!vs) return 0;
+
+        const auto linkStart = std::chrono::steady_clock::now();
+        program = glCreateProgram();
+        GLESProgramCache::PrepareProgram(program);
+        glAttachShader(program, vs);
+        if (ps) glAttachShader(program, ps);
+
+        glLinkProgram(program);
+        
+        GLint linked;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            GLint infoLen = 0;
+            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
+            if (infoLen > 1) {
+                std::vector<char> infoLog(infoLen);
+                glGetProgramInfoLog(program, infoLen, nullptr, infoLog.data());
+                LOGE("Error linking program (VS %u, PS %u):\n%s", (unsigned int)vsHandle, (unsigned int)psHandle, infoLog.data());
+            }
+            glDeleteProgram(program);
+            return 0;
         }
-        glDeleteProgram(program);
-        return 0;
+
+        const double linkMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - linkStart).count();
+        GLESProgramCache::Store(sourceKey, program, linkMs);
     }
 
-    m_programCache[key] = program;
+    GLESProgramCache::RecordUse(sourceKey);
+    m_programCache[key] = { program, sourceKey, GLESProgramCache::GetMapSerial() };
     return program;
 }
@@ -2,7 +2,9 @@
 #include <d3d8.h>
 #include <vector>
 #include <map>
+#include <bitset>
 #include "GLESShader.h"
+#include "GLESStateCache.h"
 
 #include <EGL/egl.h>
 #include <GLES3/gl3.h>
@@ -112,6 +114,9 @@ public:
     HRESULT STDMETHODCALLTYPE DrawTriPatch(UINT Handle, CONST float* pNumSegs, CONST D3DTRIPATCH_INFO* pTriPatchInfo) override;
     HRESULT STDMETHODCALLTYPE DeletePatch(UINT Handle) override;
 
+    // Internal
+    GLESStateCache& GetStateCache() { return m_glState; }
+
 private:
     std::vector<GLESVertexShader*> m_vertexShaders;
     std::vector<GLESPixelShader*> m_pixelShaders;
@@ -138,9 +143,60 @@ private:
     // Textures
     IDirect3DBaseTexture8* m_currentTextures[8] = {nullptr};
 
+    // Shadow of the D3D8 render and texture stage state. The Set calls only record
+    // changed values and mark their group dirty, ApplyState translates the dirty
+    // groups to GL right before a draw.
+    enum {
+        MAX_RENDER_STATES = 256,
+        MAX_TEXTURE_STAGES = 8,
+        MAX_TEXTURE_STAGE_STATES = 32
+    };
+    enum {
+        DIRTY_DEPTH = 1 << 0,
+        DIRTY_BLEND = 1 << 1,
+        DIRTY_CULL = 1 << 2,
+        DIRTY_ALL = DIRTY_DEPTH | DIRTY_BLEND | DIRTY_CULL
+    };
+    DWORD m_renderStates[MAX_RENDER_STATES] = {0};
+    DWORD m_textureStageStates[MAX_TEXTURE_STAGES][MAX_TEXTURE_STAGE_STATES] = {{0}};
+    unsigned int m_dirtyStates = DIRTY_ALL;
+    unsigned int m_dirtySamplers = 0xFF;
+    GLESStateCache m_glState;
+
+    void InitState();
+    void ApplyState();
+    static unsigned int GetRenderStateDirtyFlags(D3DRENDERSTATETYPE State);
+
+    // State blocks, the token is the index + 1
+    struct StateBlock {
+        DWORD renderStates[MAX_RENDER_STATES];
+        std::bitset<MAX_RENDER_STATES> renderStateMask;
+        DWORD textureStageStates[MAX_TEXTURE_STAGES][MAX_TEXTURE_STAGE_STATES];
+        std::bitset<MAX_TEXTURE_STAGE_STATES> textureStageStateMask[MAX_TEXTURE_STAGES];
+        IDirect3DBaseTexture8* textures[MAX_TEXTURE_STAGES];
+        std::bitset<MAX_TEXTURE_STAGES> textureMask;
+        DWORD vertexShader;
+        DWORD pixelShader;
+        bool hasVertexShader;
+        bool hasPixelShader;
+    };
+    std::vector<StateBlock*> m_stateBlocks;
+    StateBlock* m_recordingBlock = nullptr;
+
+    StateBlock* FindStateBlock(DWORD token);
+    void CaptureState(StateBlock* block);
+    void DestroyStateBlock(StateBlock* block);
+    static void SetStateBlockTexture(StateBlock* block, DWORD stage, IDirect3DBaseTexture8* texture);
+
     // Shader Program Cache
-    // Map key: (VertexShaderHandle << 16) | PixelShaderHandle
+    // Map key: (VertexShaderHandle << 32) | PixelShaderHandle
     // Note: Handles are indices + offset.
-    std::map<unsigned long long, GLuint> m_programCache;
+    // The programs are owned by GLESProgramCache, which keeps them on disk by source hash.
+    struct ProgramEntry {
+        GLuint program;
+        uint64_t sourceKey;
+        unsigned int mapSerial; // the map the use was last recorded for
+    };
+    std::map<unsigned long long, ProgramEntry> m_programCache;
     GLuint GetShaderProgram(DWORD vsHandle, DWORD psHandle);
 };
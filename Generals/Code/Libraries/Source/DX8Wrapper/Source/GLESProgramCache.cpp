@@ -0,0 +1,271 @@
+#include "GLESProgramCache.h"
+#include <android/log.h>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define LOG_TAG "DX8ProgramCache"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+const uint32_t PROGRAM_FILE_MAGIC = 0x38504C47; // "GLP8"
+const uint32_t MAP_FILE_MAGIC = 0x384D4C47;     // "GLM8"
+const uint32_t FILE_VERSION = 1;
+
+struct ProgramFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+struct MapFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+};
+
+bool s_enabled = false;
+std::string s_directory; // driver specific, ends with a slash
+std::unordered_map<uint64_t, GLuint> s_programs;
+std::string s_mapName;
+std::unordered_set<uint64_t> s_mapKeys;
+bool s_mapKeysChanged = false;
+unsigned int s_mapSerial = 1;
+GLESProgramCache::Stats s_stats = {};
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string MakePath(const char* prefix, uint64_t hash, const char* extension) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s%016llx%s", prefix, (unsigned long long)hash, extension);
+    return s_directory + name;
+}
+
+// Writes to a temporary file first, so an interrupted write never leaves a broken entry
+bool WriteFile(const std::string& path, const void* header, size_t headerSize, const void* data, size_t dataSize) {
+    const std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(header, headerSize, 1, file) == 1;
+    if (ok && dataSize > 0) ok = fwrite(data, dataSize, 1, file) == 1;
+    ok = fclose(file) == 0 && ok;
+    if (ok) ok = rename(tempPath.c_str(), path.c_str()) == 0;
+    if (!ok) remove(tempPath.c_str());
+    return ok;
+}
+
+GLuint LoadProgram(uint64_t key) {
+    const std::string path = MakePath("", key, ".bin");
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return 0;
+
+    ProgramFileHeader header;
+    std::vector<unsigned char> binary;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == PROGRAM_FILE_MAGIC
+        && header.version == FILE_VERSION
+        && header.key == key
+        && header.length > 0;
+    if (ok) {
+        binary.resize(header.length);
+        ok = fread(binary.data(), binary.size(), 1, file) == 1;
+    }
+    fclose(file);
+
+    GLuint program = 0;
+    if (ok) {
+        const auto start = std::chrono::steady_clock::now();
+        program = glCreateProgram();
+        glProgramBinary(program, header.format, binary.data(), header.length);
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            glDeleteProgram(program);
+            program = 0;
+        } else {
+            s_stats.binaryLoads++;
+            s_stats.binaryLoadMs += ElapsedMs(start);
+        }
+    }
+
+    if (!program) {
+        // Stale or broken, the program is linked from source again and stored anew
+        s_stats.binaryFailures++;
+        remove(path.c_str());
+        return 0;
+    }
+
+    s_programs[key] = program;
+    return program;
+}
+
+void SaveMapKeys() {
+    if (!s_enabled || s_mapName.empty() || !s_mapKeysChanged) return;
+
+    std::vector<uint64_t> keys(s_mapKeys.begin(), s_mapKeys.end());
+    MapFileHeader header;
+    header.magic = MAP_FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.count = (uint32_t)keys.size();
+
+    const uint64_t mapHash = GLESProgramCache::HashSource(s_mapName.c_str(), s_mapName.size());
+    if (!WriteFile(MakePath("map_", mapHash, ".keys"), &header, sizeof(header), keys.data(), keys.size() * sizeof(uint64_t))) {
+        LOGE("Failed to write the program keys of map %s", s_mapName.c_str());
+    }
+    s_mapKeysChanged = false;
+}
+
+void LogStats() {
+    LOGI("Programs linked %u (%.1f ms), loaded from binary %u (%.1f ms), stale binaries %u",
+        s_stats.links, s_stats.linkMs, s_stats.binaryLoads, s_stats.binaryLoadMs, s_stats.binaryFailures);
+}
+
+} // namespace
+
+void GLESProgramCache::Init(const char* directory) {
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    const char* vendor = (const char*)glGetString(GL_VENDOR);
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (formatCount <= 0 || !vendor || !renderer || !version) {
+        LOGI("Program binaries are not supported, the program cache is disabled");
+        return;
+    }
+
+    // Binaries are only valid for the driver that created them
+    std::string identity = vendor;
+    identity += '\n';
+    identity += renderer;
+    identity += '\n';
+    identity += version;
+    char driverName[32];
+    snprintf(driverName, sizeof(driverName), "%016llx", (unsigned long long)HashSource(identity.c_str(), identity.size()));
+
+    s_directory = directory;
+    mkdir(s_directory.c_str(), 0755);
+    s_directory += '/';
+    s_directory += driverName;
+    mkdir(s_directory.c_str(), 0755);
+    s_directory += '/';
+
+    s_enabled = true;
+    LOGI("Program cache at %s for %s", s_directory.c_str(), renderer);
+}
+
+void GLESProgramCache::Shutdown() {
+    SaveMapKeys();
+    LogStats();
+    for (auto& entry : s_programs) glDeleteProgram(entry.second);
+    s_programs.clear();
+    s_mapKeys.clear();
+    s_mapName.clear();
+    s_enabled = false;
+}
+
+uint64_t GLESProgramCache::HashSource(const char* source, size_t length) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)source[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t GLESProgramCache::MakeKey(uint64_t vsHash, uint64_t psHash) {
+    const uint64_t hashes[2] = { vsHash, psHash };
+    return HashSource((const char*)hashes, sizeof(hashes));
+}
+
+GLuint GLESProgramCache::Find(uint64_t key) {
+    auto it = s_programs.find(key);
+    if (it != s_programs.end()) return it->second;
+    return s_enabled ? LoadProgram(key) : 0;
+}
+
+void GLESProgramCache::PrepareProgram(GLuint program) {
+    if (s_enabled) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLESProgramCache::Store(uint64_t key, GLuint program, double linkMs) {
+    s_stats.links++;
+    s_stats.linkMs += linkMs;
+    s_programs[key] = program;
+    if (!s_enabled) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<unsigned char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    ProgramFileHeader header;
+    header.magic = PROGRAM_FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = (uint32_t)written;
+    if (!WriteFile(MakePath("", key, ".bin"), &header, sizeof(header), binary.data(), written)) {
+        LOGE("Failed to write program binary %016llx", (unsigned long long)key);
+    }
+}
+
+void GLESProgramCache::RecordUse(uint64_t key) {
+    if (!s_enabled || s_mapName.empty()) return;
+    if (s_mapKeys.insert(key).second) s_mapKeysChanged = true;
+}
+
+unsigned int GLESProgramCache::GetMapSerial() {
+    return s_mapSerial;
+}
+
+void GLESProgramCache::BeginMap(const char* mapName) {
+    SaveMapKeys();
+    LogStats();
+
+    s_mapName = mapName ? mapName : "";
+    s_mapKeys.clear();
+    s_mapKeysChanged = false;
+    s_mapSerial++;
+    if (!s_enabled || s_mapName.empty()) return;
+
+    const uint64_t mapHash = HashSource(s_mapName.c_str(), s_mapName.size());
+    FILE* file = fopen(MakePath("map_", mapHash, ".keys").c_str(), "rb");
+    if (!file) return;
+
+    MapFileHeader header;
+    std::vector<uint64_t> keys;
+    if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == MAP_FILE_MAGIC && header.version == FILE_VERSION) {
+        keys.resize(header.count);
+        if (header.count > 0 && fread(keys.data(), keys.size() * sizeof(uint64_t), 1, file) != 1) keys.clear();
+    }
+    fclose(file);
+
+    // Prewarm, the keys stay recorded even when this session does not use them
+    const auto start = std::chrono::steady_clock::now();
+    unsigned int loaded = 0;
+    for (uint64_t key : keys) {
+        s_mapKeys.insert(key);
+        if (Find(key)) loaded++;
+    }
+    LOGI("Prewarmed %u of %u programs for map %s in %.1f ms", loaded, (unsigned int)keys.size(), s_mapName.c_str(), ElapsedMs(start));
+}
+
+const GLESProgramCache::Stats& GLESProgramCache::GetStats() {
+    return s_stats;
+}
@@ -1,5 +1,6 @@
 #include "GLESShader.h"
 #include "GLESShaderTranslator.h"
+#include "GLESProgramCache.h"
 #include <GLES3/gl3.h>
 #include <android/log.h>
 #include <vector>
@@ -39,10 +40,16 @@ GLESVertexShader::GLESVertexShader(const DWORD* declaration, const DWORD* functi
         m_function.push_back(0x0000FFFF);
     }
     
-    std::string glsl = GLESShaderTranslator::TranslateVertexShader(function, declaration);
-    LOGI("Generated VS:\n%s", glsl.c_str());
-    
-    GLuint shader = CompileShader(GL_VERTEX_SHADER, glsl);
+    m_source = GLESShaderTranslator::TranslateVertexShader(function, declaration);
+    m_sourceHash = GLESProgramCache::HashSource(m_source.c_str(), m_source.size());
+    LOGI("Generated VS:\n%s", m_source.c_str());
+}
+
+GLuint GLESVertexShader::GetShaderObject() {
+    if (m_compiled) return m_shaderObject;
+    m_compiled = true;
+
+    GLuint shader = CompileShader(GL_VERTEX_SHADER, m_source);
     if (shader) {
         m_program = glCreateProgram();
         glAttachShader(m_program, shader);
@@ -55,6 +62,7 @@ GLESVertexShader::GLESVertexShader(const DWORD* declaration, const DWORD* functi
         // Let's store the compiled shader object for now.
         m_shaderObject = shader;
     }
+    return m_shaderObject;
 }
 
 GLESVertexShader::~GLESVertexShader() {
@@ -71,13 +79,17 @@ GLESPixelShader::GLESPixelShader(const DWORD* function) {
         m_function.push_back(0x0000FFFF);
     }
 
-    std::string glsl = GLESShaderTranslator::TranslatePixelShader(function);
-    LOGI("Generated PS:\n%s", glsl.c_str());
+    m_source = GLESShaderTranslator::TranslatePixelShader(function);
+    m_sourceHash = GLESProgramCache::HashSource(m_source.c_str(), m_source.size());
+    LOGI("Generated PS:\n%s", m_source.c_str());
+}
 
-    GLuint shader = CompileShader(GL_FRAGMENT_SHADER, glsl);
-    if (shader) {
-        m_shaderObject = shader;
-    }
+GLuint GLESPixelShader::GetShaderObject() {
+    if (m_compiled) return m_shaderObject;
+    m_compiled = true;
+
+    m_shaderObject = CompileShader(GL_FRAGMENT_SHADER, m_source);
+    return m_shaderObject;
 }
 
 GLESPixelShader::~GLESPixelShader() {
@@ -0,0 +1,130 @@
+#include "GLESStateCache.h"
+
+static const GLenum s_capabilities[GLESStateCache::CAP_COUNT] = {
+    GL_DEPTH_TEST,
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_SCISSOR_TEST
+};
+
+GLESStateCache::GLESStateCache() {
+    for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++) m_samplers[i] = 0;
+    m_frameStats.glCalls = 0;
+    m_frameStats.skippedCalls = 0;
+    m_lastFrameStats = m_frameStats;
+    Invalidate();
+}
+
+void GLESStateCache::Init() {
+    glGenSamplers(MAX_TEXTURE_UNITS, m_samplers);
+    for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        glBindSampler(i, m_samplers[i]);
+    }
+    Invalidate();
+}
+
+void GLESStateCache::Shutdown() {
+    if (m_samplers[0]) glDeleteSamplers(MAX_TEXTURE_UNITS, m_samplers);
+    for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++) m_samplers[i] = 0;
+}
+
+void GLESStateCache::Invalidate() {
+    for (int i = 0; i < CAP_COUNT; i++) m_enabled[i] = -1;
+    m_depthMask = -1;
+    m_depthFunc = INVALID_ENUM_VALUE;
+    m_blendSrc = INVALID_ENUM_VALUE;
+    m_blendDst = INVALID_ENUM_VALUE;
+    m_frontFace = INVALID_ENUM_VALUE;
+    m_program = INVALID_NAME;
+    m_activeTexture = MAX_TEXTURE_UNITS;
+    for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        m_boundTextures[i] = INVALID_NAME;
+        m_samplerStates[i].minFilter = INVALID_ENUM_VALUE;
+        m_samplerStates[i].magFilter = INVALID_ENUM_VALUE;
+        m_samplerStates[i].wrapS = INVALID_ENUM_VALUE;
+        m_samplerStates[i].wrapT = INVALID_ENUM_VALUE;
+    }
+}
+
+void GLESStateCache::SetEnabled(Capability cap, bool enabled) {
+    if (Skip(m_enabled[cap] == (enabled ? 1 : 0))) return;
+    m_enabled[cap] = enabled ? 1 : 0;
+    if (enabled) glEnable(s_capabilities[cap]); else glDisable(s_capabilities[cap]);
+}
+
+void GLESStateCache::SetDepthMask(bool enabled) {
+    if (Skip(m_depthMask == (enabled ? 1 : 0))) return;
+    m_depthMask = enabled ? 1 : 0;
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+
+void GLESStateCache::SetDepthFunc(GLenum func) {
+    if (Skip(m_depthFunc == func)) return;
+    m_depthFunc = func;
+    glDepthFunc(func);
+}
+
+void GLESStateCache::SetBlendFunc(GLenum src, GLenum dst) {
+    if (Skip(m_blendSrc == src && m_blendDst == dst)) return;
+    m_blendSrc = src;
+    m_blendDst = dst;
+    glBlendFunc(src, dst);
+}
+
+void GLESStateCache::SetFrontFace(GLenum mode) {
+    if (Skip(m_frontFace == mode)) return;
+    m_frontFace = mode;
+    glFrontFace(mode);
+}
+
+void GLESStateCache::UseProgram(GLuint program) {
+    if (Skip(m_program == program)) return;
+    m_program = program;
+    glUseProgram(program);
+}
+
+void GLESStateCache::SetActiveTexture(unsigned int unit) {
+    if (Skip(m_activeTexture == unit)) return;
+    m_activeTexture = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLESStateCache::BindTexture(unsigned int unit, GLuint texture) {
+    if (unit >= MAX_TEXTURE_UNITS) return;
+    if (Skip(m_boundTextures[unit] == texture)) return;
+    SetActiveTexture(unit);
+    m_boundTextures[unit] = texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLESStateCache::BindTextureForUpdate(GLuint texture) {
+    if (m_activeTexture >= MAX_TEXTURE_UNITS) SetActiveTexture(0);
+    BindTexture(m_activeTexture, texture);
+}
+
+void GLESStateCache::ForgetTexture(GLuint texture) {
+    for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        if (m_boundTextures[i] == texture) m_boundTextures[i] = 0;
+    }
+}
+
+void GLESStateCache::SetSamplerParameter(unsigned int unit, GLenum pname, GLenum& current, GLenum value) {
+    if (Skip(current == value)) return;
+    current = value;
+    glSamplerParameteri(m_samplers[unit], pname, value);
+}
+
+void GLESStateCache::SetSampler(unsigned int unit, GLenum minFilter, GLenum magFilter, GLenum wrapS, GLenum wrapT) {
+    if (unit >= MAX_TEXTURE_UNITS || !m_samplers[unit]) return;
+    SamplerState& state = m_samplerStates[unit];
+    SetSamplerParameter(unit, GL_TEXTURE_MIN_FILTER, state.minFilter, minFilter);
+    SetSamplerParameter(unit, GL_TEXTURE_MAG_FILTER, state.magFilter, magFilter);
+    SetSamplerParameter(unit, GL_TEXTURE_WRAP_S, state.wrapS, wrapS);
+    SetSamplerParameter(unit, GL_TEXTURE_WRAP_T, state.wrapT, wrapT);
+}
+
+void GLESStateCache::EndFrame() {
+    m_lastFrameStats = m_frameStats;
+    m_frameStats.glCalls = 0;
+    m_frameStats.skippedCalls = 0;
+}
@@ -1,41 +1,61 @@
 #include "GLESTexture8.h"
 #include "GLESSurface8.h"
+#include "Direct3DDevice8.h"
 #include <android/log.h>
 
 #define LOG_TAG "DX8Wrapper_Texture"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 
+uint64_t GLESTexture8::s_frameUploadBytes = 0;
+UINT GLESTexture8::s_frameUploadCount = 0;
+uint64_t GLESTexture8::s_lastFrameUploadBytes = 0;
+UINT GLESTexture8::s_lastFrameUploadCount = 0;
+
 GLESTexture8::GLESTexture8(IDirect3DDevice8* device, UINT width, UINT height, UINT levels, DWORD usage, D3DFORMAT format, D3DPOOL pool) 
     : m_device(device), m_width(width), m_height(height), m_levels(levels), m_format(format), m_refCount(1), m_textureID(0)
 {
     device->AddRef();
-    if (m_levels == 0) m_levels = 1; // Basic handling
+    if (m_width == 0) m_width = 1;
+    if (m_height == 0) m_height = 1;
+
+    // Levels == 0 asks for the full chain. Immutable storage rejects more levels than the chain has.
+    UINT maxLevels = 1;
+    for (UINT size = (m_width > m_height ? m_width : m_height); size > 1; size /= 2) maxLevels++;
+    if (m_levels == 0 || m_levels > maxLevels) m_levels = maxLevels;
 
     // Allocate mip levels
     m_mipLevels.resize(m_levels);
-    UINT w = width;
-    UINT h = height;
+    UINT w = m_width;
+    UINT h = m_height;
     for (UINT i = 0; i < m_levels; i++) {
         m_mipLevels[i].width = w;
         m_mipLevels[i].height = h;
         m_mipLevels[i].data.resize(w * h * 4); 
+        m_mipLevels[i].isDirty = false;
         if (w > 1) w /= 2;
         if (h > 1) h /= 2;
     }
 
+    // Binds through the device state cache, so the binding the next draw expects stays known
+    GLESStateCache& state = static_cast<DX8Wrapper_Direct3DDevice8*>(m_device)->GetStateCache();
+
     glGenTextures(1, &m_textureID);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    state.BindTextureForUpdate(m_textureID);
+    // Allocate all levels once, later uploads only replace sub rectangles
+    glTexStorage2D(GL_TEXTURE_2D, m_levels, GL_RGBA8, m_width, m_height);
     // Set default params
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 GLESTexture8::~GLESTexture8() {
+    if (m_textureID) {
+        static_cast<DX8Wrapper_Direct3DDevice8*>(m_device)->GetStateCache().ForgetTexture(m_textureID);
+        glDeleteTextures(1, &m_textureID);
+    }
     if (m_device) m_device->Release();
-    if (m_textureID) glDeleteTextures(1, &m_textureID);
 }
 
 HRESULT STDMETHODCALLTYPE GLESTexture8::QueryInterface(REFIID riid, void** ppvObj) {
@@ -105,13 +125,66 @@ HRESULT STDMETHODCALLTYPE GLESTexture8::LockRect(UINT Level, D3DLOCKED_RECT* pLo
         pLockedRect->pBits = m_mipLevels[Level].data.data();
         pLockedRect->Pitch = m_mipLevels[Level].width * 4;
     }
+
+    // With D3DLOCK_NO_DIRTY_UPDATE the caller reports the changes through AddDirtyRect
+    if (!(Flags & (D3DLOCK_READONLY | D3DLOCK_NO_DIRTY_UPDATE))) {
+        MarkDirty(Level, pRect);
+    }
     return D3D_OK;
 }
 
 HRESULT STDMETHODCALLTYPE GLESTexture8::UnlockRect(UINT Level) {
     if (Level >= m_levels) return D3DERR_INVALIDCALL;
 
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    UploadDirty(Level);
+    return D3D_OK;
+}
+
+HRESULT STDMETHODCALLTYPE GLESTexture8::AddDirtyRect(CONST RECT* pDirtyRect) {
+    // D3D8 tracks dirty regions of the top level only
+    MarkDirty(0, pDirtyRect);
+    UploadDirty(0);
+    return D3D_OK;
+}
+
+void GLESTexture8::MarkDirty(UINT Level, CONST RECT* pRect) {
+    MipLevel& mip = m_mipLevels[Level];
+
+    RECT rect;
+    rect.left = 0;
+    rect.top = 0;
+    rect.right = mip.width;
+    rect.bottom = mip.height;
+    if (pRect) {
+        if (pRect->left > rect.left) rect.left = pRect->left;
+        if (pRect->top > rect.top) rect.top = pRect->top;
+        if (pRect->right < rect.right) rect.right = pRect->right;
+        if (pRect->bottom < rect.bottom) rect.bottom = pRect->bottom;
+        if (rect.left >= rect.right || rect.top >= rect.bottom) return;
+    }
+
+    if (!mip.isDirty) {
+        mip.dirty = rect;
+        mip.isDirty = true;
+        return;
+    }
+
+    if (rect.left < mip.dirty.left) mip.dirty.left = rect.left;
+    if (rect.top < mip.dirty.top) mip.dirty.top = rect.top;
+    if (rect.right > mip.dirty.right) mip.dirty.right = rect.right;
+    if (rect.bottom > mip.dirty.bottom) mip.dirty.bottom = rect.bottom;
+}
+
+void GLESTexture8::UploadDirty(UINT Level) {
+    MipLevel& mip = m_mipLevels[Level];
+    if (!mip.isDirty) return;
+
+    const GLsizei width = mip.dirty.right - mip.dirty.left;
+    const GLsizei height = mip.dirty.bottom - mip.dirty.top;
+    const unsigned char* src = mip.data.data() + (mip.dirty.top * mip.width + mip.dirty.left) * 4;
+    const bool partialRows = width != (GLsizei)mip.width;
+
+    static_cast<DX8Wrapper_Direct3DDevice8*>(m_device)->GetStateCache().BindTextureForUpdate(m_textureID);
     // Assume RGBA for now
     // D3D8 uses BGRA usually?
     // Generals uses A8R8G8B8 (BGRA in memory on little endian)
@@ -119,18 +192,20 @@ HRESULT STDMETHODCALLTYPE GLESTexture8::UnlockRect(UINT Level) {
     // Standard GL ES 3.0 supports GL_RGBA.
     // Check m_format. D3DFMT_A8R8G8B8?
     // For now use GL_RGBA and bytes.
-    
-    // Upload
-    glTexImage2D(GL_TEXTURE_2D, Level, GL_RGBA, m_mipLevels[Level].width, m_mipLevels[Level].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_mipLevels[Level].data.data());
-    
-    if (m_levels > 1) {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return D3D_OK;
+    // Upload the dirty rectangle, the rows are read with the stride of the whole level
+    if (partialRows) glPixelStorei(GL_UNPACK_ROW_LENGTH, mip.width);
+    glTexSubImage2D(GL_TEXTURE_2D, Level, mip.dirty.left, mip.dirty.top, width, height, GL_RGBA, GL_UNSIGNED_BYTE, src);
+    if (partialRows) glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    s_frameUploadBytes += (uint64_t)width * height * 4;
+    s_frameUploadCount++;
+    mip.isDirty = false;
 }
 
-HRESULT STDMETHODCALLTYPE GLESTexture8::AddDirtyRect(CONST RECT* pDirtyRect) {
-    return D3D_OK;
+void GLESTexture8::EndFrame() {
+    s_lastFrameUploadBytes = s_frameUploadBytes;
+    s_lastFrameUploadCount = s_frameUploadCount;
+    s_frameUploadBytes = 0;
+    s_frameUploadCount = 0;
 }
@@ -237,6 +237,11 @@ Animatable3DObjClass & Animatable3DObjClass::operator = (const Animatable3DObjCl
  *=============================================================================================*/
 void Animatable3DObjClass::Release( void )
 {
+	// The released anim may be freed and its address reused by the next anim
+	if (HTree != nullptr) {
+		HTree->Invalidate_Pose();
+	}
+
 	switch (CurMotionMode) {
 
 		case BASE_POSE:
@@ -257,6 +257,10 @@ public:
 
 	Quaternion Get_QuatVector(float32 frame);
 
+	// Frame distance of the decoded checkpoints of channels loaded afterwards, 0 disables them
+	static void		Set_Checkpoint_Stride(uint32 stride) { DefaultCheckpointStride = stride; }
+	static uint32	Get_Checkpoint_Stride(void) { return DefaultCheckpointStride; }
+
 private:
 
 	uint32	PivotIdx;			// what pivot is this channel applied to
@@ -272,8 +276,16 @@ private:
 	uint32	CacheFrame;
 	float	  *CacheData;			// the data for CachedFrame, and CachedFrame+1, x VectorLen
 
+	uint32	CheckpointStride;	// frames between decoded checkpoints
+	uint32	NumCheckpoints;		// number of decoded checkpoints, the first one is at frame CheckpointStride
+	float	  *Checkpoints;		// the data for every CheckpointStride'th frame, x VectorLen
+
+	static uint32 DefaultCheckpointStride;
+
 	void 		Free(void);
 
+	void		build_checkpoints(void);
+	uint32	get_checkpoint(uint32 frame_idx);
 	float		getframe(uint32 frame_idx, uint32 vector_idx=0);
    void		decompress(uint32 frame_idx, float *outdata);
    void		decompress(uint32 src_idx, float *srcdata, uint32 frame_idx, float *outdata);
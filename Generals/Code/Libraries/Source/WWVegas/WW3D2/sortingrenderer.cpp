@@ -62,127 +62,93 @@ struct TempIndexStruct
 
 // ----------------------------------------------------------------------------
 //
-// InsertionSort (T* array, K *keys, int l, int r)
-// Performs insertion sort on array 'array' elements [l-r]. Uses values from array
-// 'keys' as sort keys.
+// Float_To_Sort_Key (float f)
+// Maps a float to an unsigned key that sorts in the same order. +0 and -0 map
+// to the same key, because they compare equal.
 //
 // ----------------------------------------------------------------------------
 
-template <class T, class K>
-void InsertionSort (
-	T* array,		// array to sort
-	K* keys,			// sort keys
-	int l,			//	first item
-	int r)			//	last item
+static inline unsigned Float_To_Sort_Key(float f)
 {
-	for (int i = l+1; i < r; i++) {
-		K v=keys[i];
-		T tv=array[i];
-		int j=i;
-
-		while (keys[j-1] > v) {
-			keys[j]=keys[j-1];
-			array[j]=array[j-1];
-			j--;
-			if (j == l) break;
-		};
-		keys[j]=v;
-		array[j]=tv;
+	if (f == 0.0f) {
+		f = 0.0f;
 	}
+	unsigned u;
+	memcpy(&u, &f, sizeof(u));
+	return (u & 0x80000000) ? ~u : (u | 0x80000000);
 }
 
 // ----------------------------------------------------------------------------
 //
-//	QuickSort (T* array, K* a, int l, int r)
-//
-//	Performs quicksort on array 'array'. Uses values from array 'keys' as sort keys.
-//
-// Once the length of the array to be sorted is less than 8, the routine calls
-// InsertionSort() to perform the actual sorting work.
+// Radix_Sort (T* array, T* temp_array, unsigned* keys, unsigned* temp_keys, unsigned count)
+// Stable sort of 'array' by ascending 'keys'. The temp arrays must hold 'count'
+// elements. Returns the array holding the sorted elements, which is either
+// 'array' or 'temp_array'.
 //
 // ----------------------------------------------------------------------------
 
-template <class T, class K>
-void QuickSort (
-	T* array,		//	array to sort
-	K* keys,			// sort keys
-	int l,			// first element
-	int r)			// last element
+template <class T>
+static T* Radix_Sort(T* array, T* temp_array, unsigned* keys, unsigned* temp_keys, unsigned count)
 {
-	if (r-l <= 8) {
-		InsertionSort(array,keys,l,r+1);
-		return;
+	if (count <= 32) {
+		// Insertion sort has less overhead for small arrays
+		for (unsigned i = 1; i < count; ++i) {
+			const unsigned key = keys[i];
+			const T val = array[i];
+			unsigned j = i;
+			while (j > 0 && keys[j-1] > key) {
+				keys[j] = keys[j-1];
+				array[j] = array[j-1];
+				--j;
+			}
+			keys[j] = key;
+			array[j] = val;
+		}
+		return array;
 	}
 
-	K t;
-	K v=keys[r];
-	T ttemp;
-	int i=l-1;
-	int j=r;
-
-	do {
-		do { i++; } while (i<r && keys[i]<v);
-		do { j--; } while (j>0 && keys[j]>v);
-
-		WWASSERT(j>=0);
-		WWASSERT(i<=r);
-
-		ttemp=array[i]; array[i]=array[j]; array[j]=ttemp;
-		t=keys[i]; keys[i]=keys[j]; keys[j]=t;
-	} while (j>i);
-
-	array[j]=array[i];
-	array[i]=array[r];
-	array[r]=ttemp;
-	keys[j]=keys[i];
-	keys[i]=keys[r];
-	keys[r]=t;
-
-	if (i-1>l) QuickSort(array,keys,l,i-1);
-	if (r>i+1) QuickSort(array,keys,i+1,r);
-}
-
-// ----------------------------------------------------------------------------
-//
-// Sorts and array. Uses values from array 'keys' as sort keys.
-//
-// ----------------------------------------------------------------------------
-
-template <class T, class K>
-void Sort (
-	T* array,		// array to sort
-	K *keys,	// sort keys
-	int count)		// array element count
-{
-	bool do_insertion = false;
-
-	if (count<=1) return;									// only one element.. return..
-
-	int c=0;														// count number of rise pairs
-	int i;
-	for (i = 1; i < count; i++)
-	if (keys[i] >= keys[i-1]) c++;
-
-	if (c+1 == count) return;								// array already sorted
-	if (c<50) do_insertion=true;							// array smaller than 50 should use insertion sort
+	unsigned histogram[4][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (unsigned i = 0; i < count; ++i) {
+		const unsigned key = keys[i];
+		++histogram[0][key & 0xff];
+		++histogram[1][(key >> 8) & 0xff];
+		++histogram[2][(key >> 16) & 0xff];
+		++histogram[3][key >> 24];
+	}
 
-	if (c<count/3) {											// if array is not rising
-		T tmp;
-		K tval;
+	for (unsigned pass = 0; pass < 4; ++pass) {
+		unsigned* offsets = histogram[pass];
+		const unsigned shift = pass * 8;
 
-		for (i=0;i<count/2;i++) {
-			int neg = count-1-i;
+		// Skip the pass if all keys share this digit, it would not move anything
+		if (offsets[(keys[0] >> shift) & 0xff] == count) {
+			continue;
+		}
 
-			tmp=array[i]; array[i]=array[neg]; array[neg]=tmp;
-			tval=keys[i]; keys[i] = keys[neg]; keys[neg]=tval;
+		unsigned offset = 0;
+		for (unsigned b = 0; b < 256; ++b) {
+			const unsigned c = offsets[b];
+			offsets[b] = offset;
+			offset += c;
 		}
 
-		if (!c) return;
+		for (unsigned i = 0; i < count; ++i) {
+			const unsigned key = keys[i];
+			const unsigned dest = offsets[(key >> shift) & 0xff]++;
+			temp_array[dest] = array[i];
+			temp_keys[dest] = key;
+		}
 
-		do_insertion = true;
+		T* swap_array = array;
+		array = temp_array;
+		temp_array = swap_array;
+		unsigned* swap_keys = keys;
+		keys = temp_keys;
+		temp_keys = swap_keys;
 	}
-	if (do_insertion) InsertionSort(array,keys,0,count);
-	else QuickSort(array,keys,0,count-1);			// quick sort
+
+	return array;
 }
 
 // ----------------------------------------------------------------------------
@@ -203,10 +169,18 @@ public:
 	unsigned short vertex_count;			// Number of vertices used in vb
 };
 
-static DLListClass<SortingNodeStruct> sorted_list;
 static DLListClass<SortingNodeStruct> clean_list;
 static unsigned total_sorting_vertices;
 
+// TheSuperHackers @performance 19/10/2026 Inserted nodes are appended to a flat array and sorted
+// once at flush time, instead of walking a sorted linked list on every insertion.
+static SortingNodeStruct** sorted_nodes;
+static SortingNodeStruct** sorted_nodes_temp;
+static unsigned* sorted_node_keys;
+static unsigned* sorted_node_keys_temp;
+static unsigned sorted_node_count;
+static unsigned sorted_node_array_count;
+
 static SortingNodeStruct* Get_Sorting_Struct()
 {
 
@@ -226,16 +200,18 @@ static SortingNodeStruct* Get_Sorting_Struct()
 // ----------------------------------------------------------------------------
 
 static float* vertex_z_array;
-static float* polygon_z_array;
+static unsigned* polygon_key_array;
+static unsigned* polygon_key_sort_array;
 static unsigned * node_id_array;
 static unsigned * sorted_node_id_array;
 static ShortVectorIStruct* polygon_index_array;
 static unsigned vertex_z_array_count;
-static unsigned polygon_z_array_count;
+static unsigned polygon_key_array_count;
 static unsigned node_id_array_count;
 static unsigned sorted_node_id_array_count;
 static unsigned polygon_index_array_count;
 TempIndexStruct* temp_index_array;
+TempIndexStruct* temp_index_sort_array;
 unsigned temp_index_array_count;
 
 static TempIndexStruct* Get_Temp_Index_Array(unsigned count)
@@ -244,7 +220,9 @@ static TempIndexStruct* Get_Temp_Index_Array(unsigned count)
 		count = DEFAULT_SORTING_POLY_COUNT;
 	if (count>temp_index_array_count) {
 		delete[] temp_index_array;
+		delete[] temp_index_sort_array;
 		temp_index_array=W3DNEWARRAY TempIndexStruct[count];
+		temp_index_sort_array=W3DNEWARRAY TempIndexStruct[count];
 		temp_index_array_count=count;
 	}
 	return temp_index_array;
@@ -262,16 +240,18 @@ static float* Get_Vertex_Z_Array(unsigned count)
 	return vertex_z_array;
 }
 
-static float* Get_Polygon_Z_Array(unsigned count)
+static unsigned* Get_Polygon_Key_Array(unsigned count)
 {
 	if (count < DEFAULT_SORTING_POLY_COUNT)
 		count = DEFAULT_SORTING_POLY_COUNT;
-	if (count>polygon_z_array_count) {
-		delete[] polygon_z_array;
-		polygon_z_array=W3DNEWARRAY float[count];
-		polygon_z_array_count=count;
+	if (count>polygon_key_array_count) {
+		delete[] polygon_key_array;
+		delete[] polygon_key_sort_array;
+		polygon_key_array=W3DNEWARRAY unsigned[count];
+		polygon_key_sort_array=W3DNEWARRAY unsigned[count];
+		polygon_key_array_count=count;
 	}
-	return polygon_z_array;
+	return polygon_key_array;
 }
 
 static unsigned * Get_Node_Id_Array(unsigned count)
@@ -311,6 +291,43 @@ static ShortVectorIStruct* Get_Polygon_Index_Array(unsigned count)
 }
 
 
+// ----------------------------------------------------------------------------
+//
+// Add a node to the sorted nodes. Nodes are drawn in order of decreasing z.
+// Nodes with equal z are drawn in the order they were inserted.
+//
+// ----------------------------------------------------------------------------
+
+static void Add_Sorted_Node(SortingNodeStruct* state)
+{
+	if (sorted_node_count==sorted_node_array_count) {
+		unsigned count=sorted_node_array_count*2;
+		if (count < 256)
+			count = 256;
+
+		SortingNodeStruct** nodes=W3DNEWARRAY SortingNodeStruct*[count];
+		unsigned* keys=W3DNEWARRAY unsigned[count];
+		if (sorted_node_count) {
+			memcpy(nodes,sorted_nodes,sizeof(SortingNodeStruct*)*sorted_node_count);
+			memcpy(keys,sorted_node_keys,sizeof(unsigned)*sorted_node_count);
+		}
+
+		delete[] sorted_nodes;
+		delete[] sorted_nodes_temp;
+		delete[] sorted_node_keys;
+		delete[] sorted_node_keys_temp;
+		sorted_nodes=nodes;
+		sorted_nodes_temp=W3DNEWARRAY SortingNodeStruct*[count];
+		sorted_node_keys=keys;
+		sorted_node_keys_temp=W3DNEWARRAY unsigned[count];
+		sorted_node_array_count=count;
+	}
+
+	sorted_nodes[sorted_node_count]=state;
+	sorted_node_keys[sorted_node_count]=~Float_To_Sort_Key(state->transformed_center.Z);
+	++sorted_node_count;
+}
+
 // ----------------------------------------------------------------------------
 //
 // Insert triangles to the sorting system.
@@ -361,20 +378,7 @@ void SortingRendererClass::Insert_Triangles(
 	state->transformed_center=Vector3(transformed_vec[0],transformed_vec[1],transformed_vec[2]);
 
 
-	/// @todo lorenzen sez use a bucket sort here... and stop copying so much data so many times
-
-	SortingNodeStruct* node=sorted_list.Head();
-	while (node) {
-		if (state->transformed_center.Z>node->transformed_center.Z) {
-			if (sorted_list.Head()==sorted_list.Tail())
-				sorted_list.Add_Head(state);
-			else
-				state->Insert_Before(node);
-			break;
-		}
-		node=node->Succ();
-	}
-	if (!node) sorted_list.Add_Tail(state);
+	Add_Sorted_Node(state);
 
 #ifdef WWDEBUG
 	unsigned short* indices=nullptr;
@@ -523,7 +527,7 @@ void SortingRendererClass::Flush_Sorting_Pool()
 	unsigned node_id;
 	// Fill dynamic index buffer with sorting index buffer vertices
 	unsigned * node_id_array=Get_Node_Id_Array(overlapping_polygon_count);
-	float* polygon_z_array=Get_Polygon_Z_Array(overlapping_polygon_count);
+	unsigned* polygon_key_array=Get_Polygon_Key_Array(overlapping_polygon_count);
 	ShortVectorIStruct* polygon_idx_array=(ShortVectorIStruct*)Get_Polygon_Index_Array(overlapping_polygon_count);
 
 	unsigned vertexAllocCount = overlapping_vertex_count;
@@ -582,7 +586,7 @@ void SortingRendererClass::Flush_Sorting_Pool()
 				float z=(z1+z2+z3)/3.0f;
 				unsigned array_index=i+polygon_array_offset;
 				WWASSERT(array_index<overlapping_polygon_count);
-				polygon_z_array[array_index]=z;
+				polygon_key_array[array_index]=Float_To_Sort_Key(z);
 				node_id_array[array_index]=node_id;
 				polygon_idx_array[array_index]=ShortVectorIStruct(
 					idx1+vertex_array_offset,
@@ -603,7 +607,8 @@ void SortingRendererClass::Flush_Sorting_Pool()
 	for (;a<overlapping_polygon_count;++a) {
 		tis[a]=TempIndexStruct(polygon_idx_array[a],node_id_array[a]);
 	}
-	Sort<TempIndexStruct,float>(tis,polygon_z_array,overlapping_polygon_count);
+	// TheSuperHackers @performance 19/10/2026 Sort the triangles with a stable radix sort on their z.
+	tis=Radix_Sort(tis,temp_index_sort_array,polygon_key_array,polygon_key_sort_array,overlapping_polygon_count);
 
 /*	///@todo: Add code to break up rendering into multiple index buffer fills to allow more than 65536/3 triangles.  -MW
 	int total_overlapping_polygon_count = overlapping_polygon_count;
@@ -701,8 +706,10 @@ void SortingRendererClass::Flush()
 	DX8Wrapper::Get_Transform(D3DTS_VIEW,old_view);
 	DX8Wrapper::Get_Transform(D3DTS_WORLD,old_world);
 
-	while (SortingNodeStruct* state=sorted_list.Head()) {
-		state->Remove();
+	SortingNodeStruct** nodes=Radix_Sort(sorted_nodes,sorted_nodes_temp,sorted_node_keys,sorted_node_keys_temp,sorted_node_count);
+
+	for (unsigned n=0;n<sorted_node_count;++n) {
+		SortingNodeStruct* state=nodes[n];
 
 		if ((state->sorting_state.index_buffer_type==BUFFER_TYPE_SORTING || state->sorting_state.index_buffer_type==BUFFER_TYPE_DYNAMIC_SORTING) &&
 			(state->sorting_state.vertex_buffer_type==BUFFER_TYPE_SORTING || state->sorting_state.vertex_buffer_type==BUFFER_TYPE_DYNAMIC_SORTING)) {
@@ -716,6 +723,7 @@ void SortingRendererClass::Flush()
 			clean_list.Add_Head(state);
 		}
 	}
+	sorted_node_count=0;
 
 	Flush_Sorting_Pool();
 
@@ -739,12 +747,21 @@ void SortingRendererClass::Deinit()
 	SortingNodeStruct *head = nullptr;
 
 	//
-	//	Flush the sorted list
+	//	Flush the sorted nodes
 	//
-	while ((head = sorted_list.Head ()) != nullptr) {
-		sorted_list.Remove_Head ();
-		delete head;
+	for (unsigned n = 0; n < sorted_node_count; ++n) {
+		delete sorted_nodes[n];
 	}
+	delete[] sorted_nodes;
+	delete[] sorted_nodes_temp;
+	delete[] sorted_node_keys;
+	delete[] sorted_node_keys_temp;
+	sorted_nodes=nullptr;
+	sorted_nodes_temp=nullptr;
+	sorted_node_keys=nullptr;
+	sorted_node_keys_temp=nullptr;
+	sorted_node_count=0;
+	sorted_node_array_count=0;
 
 	//
 	//	Flush the clean list
@@ -757,9 +774,11 @@ void SortingRendererClass::Deinit()
 	delete[] vertex_z_array;
 	vertex_z_array=nullptr;
 	vertex_z_array_count=0;
-	delete[] polygon_z_array;
-	polygon_z_array=nullptr;
-	polygon_z_array_count=0;
+	delete[] polygon_key_array;
+	delete[] polygon_key_sort_array;
+	polygon_key_array=nullptr;
+	polygon_key_sort_array=nullptr;
+	polygon_key_array_count=0;
 	delete[] node_id_array;
 	node_id_array=nullptr;
 	node_id_array_count=0;
@@ -770,7 +789,9 @@ void SortingRendererClass::Deinit()
 	polygon_index_array=nullptr;
 	polygon_index_array_count=0;
 	delete[] temp_index_array;
+	delete[] temp_index_sort_array;
 	temp_index_array=nullptr;
+	temp_index_sort_array=nullptr;
 	temp_index_array_count=0;
 }
 
@@ -831,20 +852,7 @@ void SortingRendererClass::Insert_VolumeParticle(
 
 	//THE TRANSFORMED CENTER[2] IS THE ZBUFFER DEPTH
 
-	/// @todo lorenzen sez use a bucket sort here... and stop copying so much data so many times
-
-	SortingNodeStruct* node=sorted_list.Head();
-	while (node) {
-		if (state->transformed_center.Z>node->transformed_center.Z) {
-			if (sorted_list.Head()==sorted_list.Tail())
-				sorted_list.Add_Head(state);
-			else
-				state->Insert_Before(node);
-			break;
-		}
-		node=node->Succ();
-	}
-	if (!node) sorted_list.Add_Tail(state);
+	Add_Sorted_Node(state);
 
 //#ifdef WWDEBUG
 //	unsigned short* indices=nullptr;
@@ -153,7 +153,7 @@ public:
 	// subsystem interface
 	virtual void init( void );
 	virtual void reset( void );
-	virtual void update( void ) { }
+	virtual void update( void );
 
 	// save game methods
 	SaveCode saveGame( AsciiString filename,
@@ -162,6 +162,8 @@ public:
 										 SnapshotType which = SNAPSHOT_SAVELOAD  );  ///< save a game
 	SaveCode missionSave( void );																	 ///< do a in between mission save
 	SaveCode loadGame( AvailableGameInfo gameInfo );							 ///< load a save file
+	Bool saveToBuffer( std::vector<UnsignedByte> &data );				 ///< save the game state into memory
+	Bool loadFromBuffer( const std::vector<UnsignedByte> &data );	 ///< load a game state from saveToBuffer
 	SaveGameInfo *getSaveGameInfo( void ) { return &m_gameInfo; }
 
 	// snapshot interaction
@@ -206,6 +208,26 @@ private:
 
 	void clearAvailableGames( void );		///< clear any available games resources we got in our list
 
+	void readSaveGameInfoFromFile( AsciiString filename, SaveGameInfo *saveGameInfo );	///< parse the save game info out of the file
+	void loadSaveGameIndex( void );			///< read the save game index file, if not done yet
+	void writeSaveGameIndex( void );		///< write the save game index file if it changed
+
+	// TheSuperHackers @performance 19/10/2026 The save game infos of all save files are kept in an index
+	// file in the save directory, so listing the saves does not parse every save file. An entry is
+	// used while the size and write time of its save file match, otherwise the file is parsed again.
+	struct SaveGameIndexEntry
+	{
+		Int64 fileSize;
+		Int64 fileTime;
+		SaveGameInfo saveGameInfo;
+		Bool listed;											///< seen by the last listing of the save files
+	};
+	typedef std::map< AsciiString, SaveGameIndexEntry > SaveGameIndex;
+	static void xferSaveGameIndexEntry( Xfer *xfer, AsciiString *key, SaveGameIndexEntry *entry );
+	SaveGameIndex m_saveGameIndex;			///< save game infos by save file name
+	Bool m_saveGameIndexLoaded;
+	Bool m_saveGameIndexChanged;
+
 	struct SnapshotBlock
 	{
 		Snapshot *snapshot;								///< the snapshot object that handles this block
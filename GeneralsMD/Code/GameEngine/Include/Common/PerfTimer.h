@@ -45,6 +45,7 @@
 #ifdef PERF_TIMERS
 #include "GameLogic/GameLogic.h"
 #include "Common/PerfMetrics.h"
+#include "Common/PerfTrace.h"
 #include "Common/GlobalData.h"
 #endif
 
@@ -121,6 +122,7 @@ private:
 
 	const char*		m_identifier;
 	Int64					m_startTime;
+	Int64					m_traceStartTime;	// PerfTrace time, or 0 if not traced
 	Int64					m_runningTimeGross;
 	Int64					m_runningTimeNet;
 	Int						m_callCount;
@@ -134,6 +136,7 @@ private:
 void PerfGather::startTimer()
 {
 	*++m_activeHead = this;
+	m_traceStartTime = PerfTrace::isEnabled() ? PerfTrace::getTime() : 0;
 	GetPrecisionTimer(&m_startTime);
 }
 
@@ -147,6 +150,12 @@ void PerfGather::stopTimer()
 
 	runTime -= m_startTime;
 
+	if (m_traceStartTime != 0)
+	{
+		PerfTrace::addScope(m_identifier, m_traceStartTime, PerfTrace::getTime());
+		m_traceStartTime = 0;
+	}
+
 	m_runningTimeGross += runTime;
 	m_runningTimeNet += runTime;
 
@@ -428,6 +428,13 @@ public:
 
 	void prependToList(Drawable **pListHead);
 	void removeFromList(Drawable **pListHead);
+
+	void prependToGridCell(Drawable **pCellHead, Int cell);
+	void removeFromGridCell(Drawable **pCellHead);
+	Drawable *getNextInGridCell( void ) const { return m_nextInGridCell; }
+	Int getGridCell( void ) const { return m_gridCell; }			///< the GameClient grid cell, or -1 if not in the grid
+	void setListOrder( UnsignedInt order ) { m_listOrder = order; }
+	UnsignedInt getListOrder( void ) const { return m_listOrder; }	///< drawables with a larger order come first in the global list
 	void setID( DrawableID id );											///< set this drawable's unique ID
 
 	const ModelConditionFlags& getModelConditionFlags( void ) const { return m_conditionState; }
@@ -678,6 +685,11 @@ private:
 	Drawable *m_nextDrawable;
 	Drawable *m_prevDrawable;		///< list links
 
+	Drawable *m_nextInGridCell;
+	Drawable *m_prevInGridCell;	///< grid cell list links
+	Int m_gridCell;
+	UnsignedInt m_listOrder;
+
   DynamicAudioEventInfo *m_customSoundAmbientInfo; ///< If not nullptr, info about the ambient sound to attach to this object
 
 	DrawableStatusBits m_status;		///< status bits (see DrawableStatus enum)
@@ -28,7 +28,10 @@
 #include "Common/ArchiveFileSystem.h"
 #include "Common/CommandLine.h"
 #include "Common/CRCDebug.h"
+#include "Common/LoadProfiler.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/LogicBenchmark.h"
+#include "Common/PerfTrace.h"
 #include "Common/Recorder.h"
 #include "Common/version.h"
 #include "GameClient/ClientInstance.h"
@@ -170,6 +173,37 @@ Int parseFullViewport(char *args[], int num)
 	return 1;
 }
 
+Int parsePerfTrace(char *args[], int num)
+{
+	if (num > 1)
+	{
+		PerfTrace::setOutputFile(args[1]);
+		PerfTrace::setEnabled(TRUE);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseLoadProfile(char *args[], int num)
+{
+	if (num > 1)
+	{
+		LoadProfiler::setOutputFile(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseLogicBenchmark(char *args[], int num)
+{
+	if (num > 1)
+	{
+		LogicBenchmark::setOutputFile(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
 #if defined(RTS_DEBUG)
 
 //=============================================================================
@@ -458,6 +492,16 @@ Int parseJobs(char *args[], int num)
 	return 1;
 }
 
+Int parseReplaySeek(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replaySeekFrame = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
 Int parseXRes(char *args[], int num)
 {
 	if (num > 1)
@@ -1163,6 +1207,13 @@ static CommandLineParam paramsForStartup[] =
 	// (If you have 4 cores, call it with -jobs 4)
 	// If you do not call this, all replays will be simulated in sequence in the same process.
 	{ "-jobs", parseJobs },
+
+	// TheSuperHackers @performance 19/10/2026
+	// Fast forward each replay passed with -replay to this logic frame, then continue at normal speed.
+	// Pass the same replay twice to restore the second pass from a checkpoint of the first pass and to
+	// check its checkpoints against the first pass. With -headless each replay is played a second time
+	// from the checkpoint at or before this frame.
+	{ "-replaySeek", parseReplaySeek },
 };
 
 // These Params are parsed during Engine Init before INI data is loaded
@@ -1183,6 +1234,18 @@ static CommandLineParam paramsForEngineInit[] =
 	// TheSuperHackers @feature xezon 03/08/2025 Force full viewport for 'Control Bar Pro' Addons like GenTool did it.
 	{ "-forcefullviewport", parseFullViewport },
 
+	// TheSuperHackers @performance 19/10/2026 Record a performance trace and write it to the given
+	// file on exit. The file can be opened with chrome://tracing or https://ui.perfetto.dev
+	{ "-perfTrace", parsePerfTrace },
+
+	// TheSuperHackers @performance 19/10/2026 Append the load phase timings of every map load to the
+	// given file, one JSON line per load.
+	{ "-loadProfile", parseLoadProfile },
+
+	// TheSuperHackers @performance 19/10/2026 Measure the logic frame times of the replays simulated
+	// with -headless -replay and append one JSON line per replay to the given file.
+	{ "-logicBenchmark", parseLogicBenchmark },
+
 #if defined(RTS_DEBUG)
 	{ "-noaudio", parseNoAudio },
 	{ "-map", parseMapName },
@@ -1382,7 +1382,7 @@ static void doFindMostReadySpecialPowerForThing( Object *obj, void *userData )
 				&& !obj->isEffectivelyDead() )
 		{
 			// search the modules for the one with the matching template
-			for( BehaviorModule** m = obj->getBehaviorModules(); *m; ++m )
+			for( BehaviorModule** m = obj->getSpecialPowerModules(); *m; ++m )
 			{
 				SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 				if (!sp)
@@ -2545,7 +2545,7 @@ Bool Player::addScience(ScienceType science)
 				if (!obj)
 					continue;
 
-				for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+				for (BehaviorModule** m = obj->getSpecialPowerModules(); *m; ++m)
 				{
 					SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 					if (!sp)
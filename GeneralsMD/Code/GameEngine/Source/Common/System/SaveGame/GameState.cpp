@@ -35,9 +35,12 @@
 #include "Common/GameState.h"
 #include "Common/GameStateMap.h"
 #include "Common/LatchRestore.h"
+#include "Common/LocalFileSystem.h"
 #include "Common/MapObject.h"
 #include "Common/PlayerList.h"
 #include "Common/RandomValue.h"
+#include "Common/SaveFileWriter.h"
+#include "Common/PerfTrace.h"
 #include "Common/Radar.h"
 #include "Common/Team.h"
 #include "Common/WellKnownKeys.h"
@@ -68,6 +71,7 @@ static const Char *SAVE_FILE_EOF       = "SG_EOF";
 static const Char *SAVE_GAME_EXTENSION = ".sav";
 static const Char *ZERO_NAME_ONLY      = "00000000";
 static const Int MAX_SAVE_FILE_NUMBER  =  99999999;
+static const Char *SAVE_GAME_INDEX_FILENAME = "SaveGameIndex.dat";
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #define GAME_STATE_BLOCK_STRING "CHUNK_GameState"  // block of save game data with game info data
@@ -277,6 +281,8 @@ GameState::GameState( void )
 
 	m_availableGames = nullptr;
 	m_isInLoadGame = FALSE;
+	m_saveGameIndexLoaded = FALSE;
+	m_saveGameIndexChanged = FALSE;
 
 }
 
@@ -295,6 +301,9 @@ GameState::~GameState( void )
 	// clear any available game
 	clearAvailableGames();
 
+	// finish any save that is still being written
+	SaveFileWriter::shutdown();
+
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -528,6 +537,48 @@ AsciiString GameState::findNextSaveFilename( UnicodeString desc )
 
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Reports the result of a save file write to the user */
+// ------------------------------------------------------------------------------------------------
+static void saveFileWritten( const char *filePath, Bool success, void *userData )
+{
+
+	if( success )
+	{
+
+		// print message to the user for game successfully saved
+		if( TheInGameUI )
+		{
+			UnicodeString msg = TheGameText->fetch( "GUI:GameSaveComplete" );
+			TheInGameUI->message( msg );
+		}
+
+	}
+	else
+	{
+
+		UnicodeString ufilepath;
+		ufilepath.translate( AsciiString( filePath ) );
+
+		UnicodeString msg;
+		msg.format( TheGameText->fetch("GUI:ErrorSavingGame"), ufilepath.str() );
+
+		MessageBoxOk(TheGameText->fetch("GUI:Error"), msg, nullptr);
+
+	}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Runs the completion of save files written in the background */
+// ------------------------------------------------------------------------------------------------
+void GameState::update( void )
+{
+
+	SaveFileWriter::update();
+
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Save the current state of the engine in a save file
 	* NOTE: filename is a *filename only* */
@@ -536,6 +587,14 @@ SaveCode GameState::saveGame( AsciiString filename, UnicodeString desc,
 															SaveFileType saveType, SnapshotType which )
 {
 
+	// TheSuperHackers @performance 19/10/2026 Only the serialization into memory runs on the game
+	// thread, the file is written by the SaveFileWriter. Saves never overlap, a new save first waits
+	// for the previous one to be written.
+	SaveFileWriter::flush();
+
+	PERF_TRACE_SCOPE(GameState_saveGame);
+	const UnsignedInt startTime = timeGetTime();
+
 	// if there is no filename, this is a new file being created, find an appropriate filename
 	if( filename.isEmpty() )
 		filename = findNextSaveFilename( desc );
@@ -588,6 +647,9 @@ SaveCode GameState::saveGame( AsciiString filename, UnicodeString desc,
 		// save file
 		xferSaveData( &xferSave, which );
 
+		// close the file, it is written to disk and replaces any previous save in the background
+		xferSave.closeAsync( saveFileWritten, nullptr );
+
 	}
 	catch( ... )
 	{
@@ -600,18 +662,14 @@ SaveCode GameState::saveGame( AsciiString filename, UnicodeString desc,
 
 		MessageBoxOk(TheGameText->fetch("GUI:Error"), msg, nullptr);
 
-		// close the file and get out of here
-		xferSave.close();
+		// throw away the partial save and get out of here, any previous save stays intact
+		xferSave.discard();
 		return SC_ERROR;
 
 	}
 
-	// close the file
-	xferSave.close();
-
-	// print message to the user for game successfully saved
-	UnicodeString msg = TheGameText->fetch( "GUI:GameSaveComplete" );
-	TheInGameUI->message( msg );
+	DEBUG_LOG(( "GameState::saveGame - Blocked the game thread for %u ms saving '%s'",
+		timeGetTime() - startTime, filepath.str() ));
 
 	return SC_OK;
 
@@ -757,6 +815,106 @@ SaveCode GameState::loadGame( AvailableGameInfo gameInfo )
 
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Save the current state of the engine into memory, used for the replay playback checkpoints */
+// ------------------------------------------------------------------------------------------------
+Bool GameState::saveToBuffer( std::vector<UnsignedByte> &data )
+{
+
+	// there is no mission data in a memory save
+	SaveGameInfo *gameInfo = getSaveGameInfo();
+	gameInfo->saveFileType = SAVE_FILE_TYPE_NORMAL;
+	gameInfo->missionMapName.clear();
+
+	XferSave xferSave;
+	try
+	{
+
+		xferSave.openBuffer( "Checkpoint" );
+		xferSaveData( &xferSave, SNAPSHOT_SAVELOAD );
+		xferSave.closeBuffer( data );
+
+	}
+	catch( ... )
+	{
+
+		DEBUG_LOG(( "GameState::saveToBuffer - Error saving the game state" ));
+		xferSave.discard();
+		data.clear();
+		return FALSE;
+
+	}
+
+	return TRUE;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Load a game state from saveToBuffer, this resets the engine just like loadGame */
+// ------------------------------------------------------------------------------------------------
+Bool GameState::loadFromBuffer( const std::vector<UnsignedByte> &data )
+{
+
+	if( data.empty() )
+		return FALSE;
+
+	// clear the save directory of any previously extracted "scratch pad" maps
+	TheGameStateMap->clearScratchPadMaps();
+
+	XferLoad xferLoad;
+	xferLoad.openBuffer( "Checkpoint", &data[0], (Int)data.size() );
+
+	// clear out the game engine
+	TheGameEngine->reset();
+
+	// lock creation of new ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( TRUE );
+
+	LatchRestore<Bool> inLoadGame(m_isInLoadGame, TRUE);
+
+	// load the save data
+	Bool error = FALSE;
+	try
+	{
+		xferSaveData( &xferLoad, SNAPSHOT_SAVELOAD );
+	}
+	catch( ... )
+	{
+		error = TRUE;
+	}
+
+	xferLoad.close();
+
+	// un-savelock the ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( FALSE );
+
+	try
+	{
+		// do the post-process from a save game load
+		gameStatePostProcessLoad();
+	}
+	catch (...)
+	{
+		error = TRUE;
+	}
+
+	if( error == TRUE )
+	{
+
+		DEBUG_LOG(( "GameState::loadFromBuffer - Error loading the game state" ));
+
+		// clear it out, again
+		if (TheGameLogic->isInGame())
+			TheGameLogic->clearGameData( FALSE );
+		TheGameEngine->reset();
+		return FALSE;
+
+	}
+
+	return TRUE;
+
+}
+
 //-------------------------------------------------------------------------------------------------
 AsciiString GameState::getSaveDirectory() const
 {
@@ -942,6 +1100,9 @@ AsciiString GameState::portableMapPathToRealMapPath(const AsciiString& in) const
 Bool GameState::doesSaveGameExist( AsciiString filename )
 {
 
+	// make sure a save still being written is on disk
+	SaveFileWriter::flush();
+
 	// construct full path to file
 	AsciiString filepath = getFilePathInSaveDirectory(filename);
 
@@ -970,14 +1131,10 @@ Bool GameState::doesSaveGameExist( AsciiString filename )
 }
 
 // ------------------------------------------------------------------------------------------------
-/** Get save game info from the filename specified */
+/** Get save game info from the filename specified, from the save game index when it is current */
 // ------------------------------------------------------------------------------------------------
 void GameState::getSaveGameInfoFromFile( AsciiString filename, SaveGameInfo *saveGameInfo )
 {
-	AsciiString token;
-	Int blockSize;
-	Bool done = FALSE;
-	SnapshotBlock *blockInfo;
 
 	// sanity
 	if( filename.isEmpty() == TRUE || saveGameInfo == nullptr )
@@ -988,6 +1145,198 @@ void GameState::getSaveGameInfoFromFile( AsciiString filename, SaveGameInfo *sav
 
 	}
 
+	// make sure a save still being written is on disk
+	SaveFileWriter::flush();
+
+	// without the size and time of the file the index can't tell if the entry is current
+	FileInfo fileInfo;
+	if( TheLocalFileSystem->getFileInfo( filename, &fileInfo ) == FALSE )
+	{
+
+		readSaveGameInfoFromFile( filename, saveGameInfo );
+		return;
+
+	}
+
+	loadSaveGameIndex();
+
+	// the index is keyed by the file name only, the path is always the save directory
+	AsciiString key = filename;
+	const char *leaf = filename.reverseFind( '\\' );
+	if( leaf == nullptr )
+		leaf = filename.reverseFind( '/' );
+	if( leaf != nullptr )
+		key.set( leaf + 1 );
+	key.toLower();
+
+	SaveGameIndex::iterator it = m_saveGameIndex.find( key );
+	if( it != m_saveGameIndex.end() &&
+			it->second.fileSize == fileInfo.size() &&
+			it->second.fileTime == fileInfo.timestamp() )
+	{
+
+		*saveGameInfo = it->second.saveGameInfo;
+		it->second.listed = TRUE;
+		return;
+
+	}
+
+	// parse the file, this throws when the file is broken
+	SaveGameIndexEntry entry;
+	readSaveGameInfoFromFile( filename, &entry.saveGameInfo );
+	entry.fileSize = fileInfo.size();
+	entry.fileTime = fileInfo.timestamp();
+	entry.listed = TRUE;
+	m_saveGameIndex[ key ] = entry;
+	m_saveGameIndexChanged = TRUE;
+
+	*saveGameInfo = entry.saveGameInfo;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Save or load one entry of the save game index file */
+// ------------------------------------------------------------------------------------------------
+void GameState::xferSaveGameIndexEntry( Xfer *xfer, AsciiString *key, SaveGameIndexEntry *entry )
+{
+	SaveGameInfo *info = &entry->saveGameInfo;
+
+	xfer->xferAsciiString( key );
+	xfer->xferInt64( &entry->fileSize );
+	xfer->xferInt64( &entry->fileTime );
+
+	xfer->xferUser( &info->saveFileType, sizeof( SaveFileType ) );
+	xfer->xferAsciiString( &info->missionMapName );
+	xfer->xferAsciiString( &info->saveGameMapName );
+	xfer->xferAsciiString( &info->pristineMapName );
+	xfer->xferAsciiString( &info->mapLabel );
+	xfer->xferUnsignedShort( &info->date.year );
+	xfer->xferUnsignedShort( &info->date.month );
+	xfer->xferUnsignedShort( &info->date.day );
+	xfer->xferUnsignedShort( &info->date.dayOfWeek );
+	xfer->xferUnsignedShort( &info->date.hour );
+	xfer->xferUnsignedShort( &info->date.minute );
+	xfer->xferUnsignedShort( &info->date.second );
+	xfer->xferUnsignedShort( &info->date.milliseconds );
+	xfer->xferUnicodeString( &info->description );
+	xfer->xferAsciiString( &info->campaignSide );
+	xfer->xferInt( &info->missionNumber );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Read the save game index file. A missing or broken index is rebuilt from the save files */
+// ------------------------------------------------------------------------------------------------
+void GameState::loadSaveGameIndex( void )
+{
+
+	if( m_saveGameIndexLoaded )
+		return;
+	m_saveGameIndexLoaded = TRUE;
+
+	m_saveGameIndex.clear();
+	m_saveGameIndexChanged = FALSE;
+
+	AsciiString filepath = getFilePathInSaveDirectory( SAVE_GAME_INDEX_FILENAME );
+	if( TheLocalFileSystem->doesFileExist( filepath.str() ) == FALSE )
+		return;
+
+	XferLoad xferLoad;
+	Bool isOpen = FALSE;
+	try
+	{
+
+		xferLoad.open( filepath );
+		isOpen = TRUE;
+
+		XferVersion currentVersion = 1;
+		XferVersion version = currentVersion;
+		xferLoad.xferVersion( &version, currentVersion );
+
+		UnsignedInt count = 0;
+		xferLoad.xferUnsignedInt( &count );
+		for( UnsignedInt i = 0; i < count; ++i )
+		{
+			AsciiString key;
+			SaveGameIndexEntry entry;
+			xferSaveGameIndexEntry( &xferLoad, &key, &entry );
+			entry.listed = FALSE;
+			m_saveGameIndex[ key ] = entry;
+		}
+
+		xferLoad.close();
+		isOpen = FALSE;
+
+	}
+	catch( ... )
+	{
+
+		if( isOpen )
+			xferLoad.close();
+
+		// not usable, everything is parsed from the save files again
+		DEBUG_LOG(( "GameState::loadSaveGameIndex - Discarding the broken save game index '%s'", filepath.str() ));
+		m_saveGameIndex.clear();
+		m_saveGameIndexChanged = TRUE;
+
+	}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Write the save game index file if any entry changed */
+// ------------------------------------------------------------------------------------------------
+void GameState::writeSaveGameIndex( void )
+{
+
+	if( m_saveGameIndexChanged == FALSE )
+		return;
+	m_saveGameIndexChanged = FALSE;
+
+	AsciiString filepath = getFilePathInSaveDirectory( SAVE_GAME_INDEX_FILENAME );
+
+	XferSave xferSave;
+	try
+	{
+
+		xferSave.open( filepath );
+
+		XferVersion currentVersion = 1;
+		XferVersion version = currentVersion;
+		xferSave.xferVersion( &version, currentVersion );
+
+		UnsignedInt count = (UnsignedInt)m_saveGameIndex.size();
+		xferSave.xferUnsignedInt( &count );
+		for( SaveGameIndex::iterator it = m_saveGameIndex.begin(); it != m_saveGameIndex.end(); ++it )
+		{
+			AsciiString key = it->first;
+			xferSaveGameIndexEntry( &xferSave, &key, &it->second );
+		}
+
+		xferSave.close();
+
+	}
+	catch( ... )
+	{
+
+		// the index is only a cache, the saves are parsed again next time
+		DEBUG_LOG(( "GameState::writeSaveGameIndex - Unable to write the save game index '%s'", filepath.str() ));
+		xferSave.discard();
+
+	}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Parse the save game info out of the save file specified */
+// ------------------------------------------------------------------------------------------------
+void GameState::readSaveGameInfoFromFile( AsciiString filename, SaveGameInfo *saveGameInfo )
+{
+	AsciiString token;
+	Int blockSize;
+	Bool done = FALSE;
+	SnapshotBlock *blockInfo;
+
 	// open file for partial loading
 	XferLoad xferLoad;
 	xferLoad.open( filename );
@@ -1176,9 +1525,36 @@ void GameState::populateSaveGameListbox( GameWindow *listbox, SaveLoadLayoutType
 	// clear the available games
 	clearAvailableGames();
 
+	const UnsignedInt startTime = timeGetTime();
+
+	// entries of save files that no longer exist are dropped from the index below
+	loadSaveGameIndex();
+	SaveGameIndex::iterator indexIt;
+	for( indexIt = m_saveGameIndex.begin(); indexIt != m_saveGameIndex.end(); ++indexIt )
+		indexIt->second.listed = FALSE;
+
 	// iterate all the save files in the directory and populate the listbox
 	iterateSaveFiles( addGameToAvailableList, &m_availableGames );
 
+	indexIt = m_saveGameIndex.begin();
+	while( indexIt != m_saveGameIndex.end() )
+	{
+		if( indexIt->second.listed == FALSE )
+		{
+			m_saveGameIndex.erase( indexIt++ );
+			m_saveGameIndexChanged = TRUE;
+		}
+		else
+		{
+			++indexIt;
+		}
+	}
+
+	writeSaveGameIndex();
+
+	DEBUG_LOG(( "GameState::populateSaveGameListbox - Listed %d save games in %u ms",
+		(Int)m_saveGameIndex.size(), timeGetTime() - startTime ));
+
 	// add all games found to the list box
 	AvailableGameInfo *info;
 	SaveGameInfo *saveGameInfo;
@@ -1256,6 +1632,9 @@ void GameState::iterateSaveFiles( IterateSaveFileCallback callback, void *userDa
 	if( callback == nullptr )
 		return;
 
+	// make sure a save still being written is listed
+	SaveFileWriter::flush();
+
 	// save the current directory
 	char currentDirectory[ _MAX_PATH ];
 	GetCurrentDirectory( _MAX_PATH, currentDirectory );
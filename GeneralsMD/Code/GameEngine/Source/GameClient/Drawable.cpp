@@ -352,6 +352,11 @@ Drawable::Drawable( const ThingTemplate *thingTemplate, DrawableStatusBits statu
 	m_nextDrawable = nullptr;
 	m_prevDrawable = nullptr;
 
+	m_nextInGridCell = nullptr;
+	m_prevInGridCell = nullptr;
+	m_gridCell = -1;
+	m_listOrder = 0;
+
   m_customSoundAmbientInfo = nullptr;
 
 	// register drawable with the GameClient ... do this first before we start doing anything
@@ -4224,6 +4229,9 @@ void Drawable::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* old
 	{
 		(*dm)->reactToTransformChange(oldMtx, oldPos, oldAngle);
 	}
+
+	if (m_gridCell >= 0)
+		TheGameClient->updateDrawableGridCell(this);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -4647,6 +4655,37 @@ void Drawable::removeFromList(Drawable **pListHead)
 		*pListHead = m_nextDrawable;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** add self to the linked list of a GameClient grid cell */
+//-------------------------------------------------------------------------------------------------
+void Drawable::prependToGridCell(Drawable **pCellHead, Int cell)
+{
+	m_prevInGridCell = nullptr;
+	m_nextInGridCell = *pCellHead;
+	if (*pCellHead)
+		(*pCellHead)->m_prevInGridCell = this;
+	*pCellHead = this;
+	m_gridCell = cell;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** remove self from the linked list of a GameClient grid cell */
+//-------------------------------------------------------------------------------------------------
+void Drawable::removeFromGridCell(Drawable **pCellHead)
+{
+	if (m_nextInGridCell)
+		m_nextInGridCell->m_prevInGridCell = m_prevInGridCell;
+
+	if (m_prevInGridCell)
+		m_prevInGridCell->m_nextInGridCell = m_nextInGridCell;
+	else
+		*pCellHead = m_nextInGridCell;
+
+	m_nextInGridCell = nullptr;
+	m_prevInGridCell = nullptr;
+	m_gridCell = -1;
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 void Drawable::updateHiddenStatus()
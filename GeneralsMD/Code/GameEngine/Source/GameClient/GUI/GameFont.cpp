@@ -29,6 +29,7 @@
 
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
+#include "GameClient/DisplayStringManager.h"
 #include "GameClient/GameFont.h"
 
 // PUBLIC DATA ////////////////////////////////////////////////////////////////////////////////////
@@ -170,6 +171,10 @@ void FontLibrary::reset( void )
 	// delete all font data
 	deleteAllFonts();
 
+	// the display strings may hold on to layouts of the deleted fonts
+	if( TheDisplayStringManager )
+		TheDisplayStringManager->reset();
+
 }
 
 //-------------------------------------------------------------------------------------------------
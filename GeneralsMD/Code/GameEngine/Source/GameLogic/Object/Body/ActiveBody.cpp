@@ -611,7 +611,7 @@ void ActiveBody::attemptDamage( DamageInfo *damageInfo )
 		// if our health has gone down then do run the damage module callback
 		if( m_currentHealth < m_prevHealth )
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -623,7 +623,7 @@ void ActiveBody::attemptDamage( DamageInfo *damageInfo )
 
 		if (m_curDamageState != oldState)
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -850,7 +850,7 @@ void ActiveBody::attemptHealing( DamageInfo *damageInfo )
 		// if our health has gone UP then do run the damage module callback
 		if( m_currentHealth > m_prevHealth )
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -862,7 +862,7 @@ void ActiveBody::attemptHealing( DamageInfo *damageInfo )
 
 		if (m_curDamageState != oldState)
 		{
-			for (BehaviorModule** m = obj->getBehaviorModules(); *m; ++m)
+			for (BehaviorModule** m = obj->getDamageModules(); *m; ++m)
 			{
 				DamageModuleInterface* d = (*m)->getDamage();
 				if (!d)
@@ -142,7 +142,7 @@ Bool SabotageCommandCenterCrateCollide::executeCrateBehavior( Object *other )
 	}
 
 	//Reset ALL special powers!
-	for( BehaviorModule **m = other->getBehaviorModules(); *m; ++m )
+	for( BehaviorModule **m = other->getSpecialPowerModules(); *m; ++m )
 	{
 		SpecialPowerModuleInterface* sp = (*m)->getSpecialPower();
 		if( !sp )
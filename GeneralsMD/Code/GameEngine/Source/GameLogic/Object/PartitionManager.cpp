@@ -57,6 +57,7 @@
 #include "Common/MessageStream.h"
 #include "Common/NameKeyGenerator.h"
 #include "Common/PerfTimer.h"
+#include "Common/PerfTrace.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
 #include "Common/Radar.h"
@@ -3240,6 +3241,7 @@ Object *PartitionManager::getClosestObjects(
 )
 {
 	//USE_PERF_TIMER(getClosestObjects)
+	PERF_TRACE_SCOPE(PartitionManager_getClosestObjects)
 
 #ifdef DUMP_PERF_STATS
 	if (TheGameLogic->getFrame() != s_gcoPerfFrame)
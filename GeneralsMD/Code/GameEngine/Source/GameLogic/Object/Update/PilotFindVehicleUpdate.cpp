@@ -166,7 +166,7 @@ Object* PilotFindVehicleUpdate::scanClosestTarget()
 			continue;
 		}
 		// first, see if we'd like to collide with 'other'
-		for (BehaviorModule** m = me->getBehaviorModules(); *m; ++m)
+		for (BehaviorModule** m = me->getCollideModules(); *m; ++m)
 		{
 			CollideModuleInterface* collide = (*m)->getCollide();
 			if (!collide)
@@ -41,10 +41,13 @@
 #include "Common/GameUtility.h"
 #include "Common/INI.h"
 #include "Common/LatchRestore.h"
+#include "Common/LoadProfiler.h"
+#include "Common/LogicBenchmark.h"
 #include "Common/MapObject.h"
 #include "Common/MultiplayerSettings.h"
 #include "Common/OSDisplay.h"
 #include "Common/PerfTimer.h"
+#include "Common/PerfTrace.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
 #include "Common/PlayerTemplate.h"
@@ -175,6 +178,34 @@ enum
 	LOAD_PROGRESS_END = 100,
 };
 
+// ------------------------------------------------------------------------------------------------
+/** Returns the name of the load phase that ends at this load progress, or null if the progress
+	* is not the end of a phase */
+// ------------------------------------------------------------------------------------------------
+static const char *getLoadPhaseName( Int progress )
+{
+	switch( progress )
+	{
+		case LOAD_PROGRESS_POST_PARTICLE_INI_LOAD:												return "Setup";
+		case LOAD_PROGRESS_POST_LOAD_MAP:																	return "LoadMap";
+		case LOAD_PROGRESS_POST_SIDE_LIST_INIT:														return "SideList";
+		case LOAD_PROGRESS_POST_PLAYER_LIST_RESET:												return "PlayerList";
+		case LOAD_PROGRESS_POST_SCRIPT_ENGINE_NEW_MAP:										return "ScriptEngine";
+		case LOAD_PROGRESS_POST_VICTORY_CONDITION_SETUP:									return "VictoryConditionSetup";
+		case LOAD_PROGRESS_POST_VICTORY_CONDITION_SET_VICTORY_CONDITION:	return "VictoryCondition";
+		case LOAD_PROGRESS_POST_GHOST_OBJECT_MANAGER_RESET:								return "GhostObjectManager";
+		case LOAD_PROGRESS_POST_TERRAIN_LOGIC_NEW_MAP:										return "TerrainLogic";
+		case LOAD_PROGRESS_POST_BRIDGE_LOAD:															return "Bridges";
+		case LOAD_PROGRESS_POST_PATHFINDER_NEW_MAP:												return "Pathfinder";
+		case LOAD_PROGRESS_POST_INITIAL_NETWORK_BUILDINGS:								return "InitialBuildings";
+		case LOAD_PROGRESS_POST_PRELOAD_ASSETS:														return "PreloadAssets";
+		case LOAD_PROGRESS_POST_STARTING_CAMERA:													return "StartingCamera";
+		case LOAD_PROGRESS_POST_STARTING_CAMERA_2:												return "StartingCamera2";
+		case LOAD_PROGRESS_END:																						return "Finish";
+	}
+	return nullptr;
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 static Waypoint * findNamedWaypoint(AsciiString name)
@@ -1058,6 +1089,10 @@ static void populateRandomStartPosition( GameInfo *game )
 void GameLogic::updateLoadProgress( Int progress )
 {
 
+	const char *phaseName = getLoadPhaseName( progress );
+	if( phaseName )
+		LoadProfiler::endPhase( phaseName );
+
 	if( m_loadScreen )
 		m_loadScreen->update( progress );
 
@@ -1102,6 +1137,7 @@ void GameLogic::setGameMode( GameMode mode )
 // ------------------------------------------------------------------------------------------------
 void GameLogic::startNewGame( Bool loadingSaveGame )
 {
+	PERF_TRACE_SCOPE(GameLogic_startNewGame)
 
 	#ifdef DUMP_PERF_STATS
 	__int64 startTime64;
@@ -1122,6 +1158,9 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	setLoadingMap( TRUE );
 
+	// TheSuperHackers @performance 19/10/2026 Profile the phases of the load, see updateLoadProgress.
+	LoadProfiler::begin( TheGlobalData->m_mapName.str() );
+
 	if( loadingSaveGame == FALSE )
 	{
 
@@ -1286,8 +1325,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	m_startNewGame = FALSE;
 
 	// update the loadscreen
-	if(m_loadScreen)
-		updateLoadProgress(LOAD_PROGRESS_POST_PARTICLE_INI_LOAD);
+	updateLoadProgress(LOAD_PROGRESS_POST_PARTICLE_INI_LOAD);
 
 	DEBUG_ASSERTCRASH(m_frame == 0, ("framecounter expected to be 0 here"));
 
@@ -1922,6 +1960,8 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	}
 
+	LoadProfiler::endPhase( "Objects" );
+
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
 	sprintf(Buf,"After loading objects=%f",((double)(endTime64-startTime64)/(double)(freq64)*1000.0));
@@ -2163,6 +2203,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	}
 
 	updateLoadProgress(LOAD_PROGRESS_END);
+	LoadProfiler::end( TheGlobalData->m_headless );
 
 	if(isInMultiplayerGame() && TheNetwork)
 	{
@@ -3606,6 +3647,8 @@ void GameLogic::update( void )
 {
 	USE_PERF_TIMER(GameLogic_update)
 
+	PerfTrace::markLogicFrame(m_frame);
+
 	LatchRestore<Bool> inUpdateLatch(m_isInUpdate, TRUE);
 #ifdef DO_UNIT_TIMINGS
 	unitTimings();
@@ -3651,14 +3694,19 @@ void GameLogic::update( void )
 	UnsignedInt now = getFrame();
 	TheGameClient->setFrame(now);
 
+	// TheSuperHackers @performance 19/10/2026 Measure the phases of the logic frame, see LogicBenchmark.h
+	LogicBenchmark::beginFrame();
+
 	// update (execute) scripts
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_SCRIPTS)
 		TheScriptEngine->UPDATE();
 	}
 
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_TERRAIN)
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3676,6 +3724,7 @@ void GameLogic::update( void )
 
 	if (generateForSolo || generateForMP)
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_CRC)
 		m_CRC = getCRC( CRC_RECALC );
 		bool isPlayback = (TheRecorder && TheRecorder->isPlaybackMode());
 
@@ -3707,11 +3756,13 @@ void GameLogic::update( void )
 
 	// process client commands
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_COMMANDS)
 		processCommandList( TheCommandList );
 	}
 
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_OBJECTS)
 		for (std::list<UpdateModulePtr>::const_iterator it = m_normalUpdates.begin(); it != m_normalUpdates.end(); ++it)
 		{
 			UpdateModulePtr u = *it;
@@ -3736,6 +3787,7 @@ void GameLogic::update( void )
 #endif
 
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_OBJECTS)
 		while (!m_sleepyUpdates.empty())
 		{
 			UpdateModulePtr u = peekSleepyUpdate();
@@ -3782,6 +3834,7 @@ void GameLogic::update( void )
 
 	// update the Artificial Intelligence system
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_AI)
 		TheAI->UPDATE();
 	}
 
@@ -3792,6 +3845,7 @@ void GameLogic::update( void )
 
 	// update partition info
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_PARTITION)
 		ThePartitionManager->UPDATE();
 	}
 
@@ -3805,11 +3859,15 @@ void GameLogic::update( void )
 	// reset the command list, destroying all messages
 	TheCommandList->reset();
 
-	TheWeaponStore->UPDATE();
+	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_WEAPONS)
+		TheWeaponStore->UPDATE();
+	}
 	TheLocomotorStore->UPDATE();
 	TheVictoryConditions->UPDATE();
 
 	{
+		LOGIC_BENCHMARK_SCOPE(LOGIC_BENCHMARK_OBJECTS)
 		//Handle disabled statii (and re-enable objects once frame matches)
 		for( Object *obj = m_objList; obj; obj = obj->getNextObject() )
 		{
@@ -3824,6 +3882,8 @@ void GameLogic::update( void )
 
 
 
+	LogicBenchmark::endFrame();
+
 	// increment world time
 	if (!m_startNewGame)
 	{
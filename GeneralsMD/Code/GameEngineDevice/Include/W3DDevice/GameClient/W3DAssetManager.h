@@ -102,6 +102,17 @@ private:
 	int replaceHLODTexture(RenderObjClass *robj, TextureClass *oldTex, TextureClass *newTex);
 	int replaceMeshTexture(RenderObjClass *robj, TextureClass *oldTex, TextureClass *newTex);
 
+	// TheSuperHackers @performance 19/10/2026 The recolored textures are released with the other unused
+	// assets at the end of a match. Their recolored surfaces are kept, up to a size limit, so the next
+	// match creates the textures from them instead of recoloring the same textures again.
+	enum { MAX_RECOLORED_SURFACE_BYTES = 32 * 1024 * 1024 };
+	SurfaceClass * Find_Recolored_Surface(const char * munged_name, const SurfaceClass::SurfaceDescription &desc);
+	void Add_Recolored_Surface(const char * munged_name, SurfaceClass *surface);
+	void Release_Recolored_Surfaces(void);
+
+	HashTemplateClass<StringClass, SurfaceClass *> m_recoloredSurfaceHash;	///< recolored surfaces by munged texture name
+	UnsignedInt m_recoloredSurfaceBytes;
+
 	//'E&B' customizations
 /*	virtual RenderObjClass * Create_Render_Obj(const char * name, float scale, const Vector3 &hsv_shift);
 	TextureClass * Get_Texture_With_HSV_Shift(const char * filename, const Vector3 &hsv_shift, TextureClass::MipCountType mip_level_count = TextureClass::MIP_LEVELS_ALL);
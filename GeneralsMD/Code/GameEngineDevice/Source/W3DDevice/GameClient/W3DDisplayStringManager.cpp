@@ -51,6 +51,9 @@ W3DDisplayStringManager::W3DDisplayStringManager( void )
 
 	m_formationLetterDisplayString = nullptr;
 
+	memset( &m_frameStats, 0, sizeof( m_frameStats ) );
+	memset( &m_lastFrameStats, 0, sizeof( m_lastFrameStats ) );
+
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -176,6 +179,9 @@ void W3DDisplayStringManager::update( void )
 	// call base in case we add something later
 	DisplayStringManager::update();
 
+	m_lastFrameStats = m_frameStats;
+	memset( &m_frameStats, 0, sizeof( m_frameStats ) );
+
 	W3DDisplayString *string = static_cast<W3DDisplayString *>(m_stringList);
 
 	// if the m_currentCheckpoint is valid, use it for the starting point for the search
@@ -228,6 +234,64 @@ void W3DDisplayStringManager::update( void )
 	m_currentCheckpoint = string;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The fonts may be released on reset, so the cached layouts can't be trusted anymore */
+//-------------------------------------------------------------------------------------------------
+void W3DDisplayStringManager::reset( void )
+{
+	DisplayStringManager::reset();
+
+	m_textLayouts.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+Vector2 W3DDisplayStringManager::getFormattedTextExtents( Render2DSentenceClass &renderer, const UnicodeString &text )
+{
+	FontCharsClass *font = renderer.Peek_Font();
+	const Real wrapWidth = renderer.Get_Wrapping_Width();
+	const Bool hotKeyParse = renderer.Get_Hot_Key_Parse();
+	const Bool hardWordWrap = renderer.Get_Use_Hard_Word_Wrap();
+
+	// FNV-1a over the text and the layout settings
+	UnsignedInt key = 2166136261u;
+	for( const WideChar *c = text.str(); *c != 0; ++c )
+		key = (key ^ (UnsignedInt)*c) * 16777619u;
+	key = (key ^ (UnsignedInt)(size_t)font) * 16777619u;
+	key = (key ^ (UnsignedInt)REAL_TO_INT( wrapWidth )) * 16777619u;
+	key = (key ^ (UnsignedInt)((hotKeyParse ? 1 : 0) | (hardWordWrap ? 2 : 0))) * 16777619u;
+
+	TextLayoutMap::iterator it = m_textLayouts.find( key );
+	if( it != m_textLayouts.end() )
+	{
+		const TextLayout &layout = it->second;
+		if( layout.font == font &&
+				layout.wrapWidth == wrapWidth &&
+				layout.hotKeyParse == hotKeyParse &&
+				layout.hardWordWrap == hardWordWrap &&
+				layout.text == text )
+		{
+			++m_frameStats.layoutCacheHits;
+			return layout.extents;
+		}
+	}
+
+	Vector2 extents = renderer.Get_Formatted_Text_Extents( text.str() );
+	++m_frameStats.layouts;
+
+	if( m_textLayouts.size() >= MAX_TEXT_LAYOUTS )
+		m_textLayouts.clear();
+
+	TextLayout &layout = m_textLayouts[ key ];
+	layout.text = text;
+	layout.font = font;
+	layout.wrapWidth = wrapWidth;
+	layout.hotKeyParse = hotKeyParse;
+	layout.hardWordWrap = hardWordWrap;
+	layout.extents = extents;
+
+	return extents;
+}
+
 //-------------------------------------------------------------------------------------------------
 DisplayString *W3DDisplayStringManager::getGroupNumeralString( Int numeral )
 {
@@ -78,6 +78,11 @@ static float filtertable[FILTER_TABLE_SIZE] = {
 };
 static bool table_valid = false;
 
+// TheSuperHackers @performance 19/10/2026 Adaptive delta channels keep the decoded values of every
+// 64th frame, so any frame is decompressed from at most 63 deltas instead of from the beginning.
+// This costs 4 bytes per 64 frames and vector element, about 10% of the compressed data.
+uint32 AdaptiveDeltaMotionChannelClass::DefaultCheckpointStride = 64;
+
 /***********************************************************************************************
  * MotionChannelClass::MotionChannelClass -- constructor                                       *
  *                                                                                             *
@@ -849,6 +854,9 @@ AdaptiveDeltaMotionChannelClass::AdaptiveDeltaMotionChannelClass(void) :
 	Data(nullptr),
 	NumFrames(0),
 	CacheData(nullptr),
+	CheckpointStride(0),
+	NumCheckpoints(0),
+	Checkpoints(nullptr),
 	Scale(0.0f)
 {
 
@@ -905,8 +913,12 @@ void AdaptiveDeltaMotionChannelClass::Free(void)
 	delete[] Data;
 	Data = nullptr;
 
-	delete CacheData;
+	delete[] CacheData;
 	CacheData = nullptr;
+
+	delete[] Checkpoints;
+	Checkpoints = nullptr;
+	NumCheckpoints = 0;
 }
 
 
@@ -948,11 +960,77 @@ bool AdaptiveDeltaMotionChannelClass::Load_W3D(ChunkLoadClass & cload)
 		Free();
 		return false;
 	}
+
+	build_checkpoints();
 	return true;
 
 }
 
 
+/***********************************************************************************************
+ * AdaptiveDeltaMotionChannelClass::build_checkpoints -- decodes the checkpoint frames         *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   10/19/2026 TheSuperHackers : Created.                                                     *
+ *=============================================================================================*/
+void AdaptiveDeltaMotionChannelClass::build_checkpoints(void)
+{
+	CheckpointStride = DefaultCheckpointStride;
+	NumCheckpoints = 0;
+
+	if (CheckpointStride == 0 || NumFrames <= CheckpointStride) {
+		return;
+	}
+
+	NumCheckpoints = (NumFrames - 1) / CheckpointStride;
+	Checkpoints = MSGW3DNEWARRAY("AdaptiveDeltaMotionChannelClass::Checkpoints") float[NumCheckpoints * VectorLen];
+
+	// Each checkpoint continues from the previous one, which accumulates the deltas in the same
+	// order as decompressing from the beginning does. The decoded values are therefore identical.
+	uint32 src_idx = 0;
+	float *srcdata = (float *) &Data[0];
+
+	for (uint32 ci=0; ci<NumCheckpoints; ci++) {
+		uint32 frame_idx = (ci + 1) * CheckpointStride;
+		float *outdata = &Checkpoints[ci * VectorLen];
+
+		decompress(src_idx, srcdata, frame_idx, outdata);
+
+		src_idx = frame_idx;
+		srcdata = outdata;
+	}
+}
+
+
+/***********************************************************************************************
+ * AdaptiveDeltaMotionChannelClass::get_checkpoint -- returns the last checkpoint up to frame  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT: checkpoint number, 0 is the beginning of the data                                   *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   10/19/2026 TheSuperHackers : Created.                                                     *
+ *=============================================================================================*/
+uint32 AdaptiveDeltaMotionChannelClass::get_checkpoint(uint32 frame_idx)
+{
+	if (NumCheckpoints == 0) {
+		return 0;
+	}
+
+	uint32 checkpoint = frame_idx / CheckpointStride;
+	return (checkpoint < NumCheckpoints) ? checkpoint : NumCheckpoints;
+}
+
+
 /***********************************************************************************************
  * AdaptiveDeltaMotionChannelClass::decompress																  *
  *                                                                                             *
@@ -968,13 +1046,30 @@ bool AdaptiveDeltaMotionChannelClass::Load_W3D(ChunkLoadClass & cload)
 #define PACKET_SIZE (9)
 void AdaptiveDeltaMotionChannelClass::decompress(uint32 frame_idx, float *outdata)
 {
+	// Start from the closest checkpoint, if there is one
+	uint32 checkpoint = get_checkpoint(frame_idx);
+
+	if (checkpoint != 0) {
+		uint32 src_idx = checkpoint * CheckpointStride;
+		float *srcdata = &Checkpoints[(checkpoint - 1) * VectorLen];
+
+		if (src_idx == frame_idx) {
+			memcpy(outdata, srcdata, VectorLen * sizeof(float));
+		}
+		else {
+			decompress(src_idx, srcdata, frame_idx, outdata);
+		}
+		return;
+	}
+
 	// Start Over from the beginning
 	float *base	= (float *) &Data[0];	// pointer to our true know beginning values
 
-	bool done = false;
-
 	for(int vi=0; vi<VectorLen; vi++) {
 		// Decompress all the vector indices, since they will probably all be needed
+		// TheSuperHackers @bugfix 19/10/2026 Reset the done flag for every vector index. Previously all
+		// indices after the first one stopped decoding at the end of their first packet.
+		bool done = false;
 		unsigned char *pPacket = (unsigned char *) Data;	// pointer to current packet
 		pPacket+= (sizeof(float) * VectorLen);					// skip non-compressed header information
 		pPacket+= PACKET_SIZE * vi;								// skip to the appropriate packet start
@@ -1048,10 +1143,9 @@ void AdaptiveDeltaMotionChannelClass::decompress(uint32 src_idx, float *srcdata,
 	float *base	= (float *) &Data[0];	// pointer to our true know beginning values
    base += VectorLen;						// skip header information
 
-	bool done = false;
-
 	for(int vi=0; vi<VectorLen; vi++) {
 		// Decompress all the vector indices, since they will probably all be needed
+		bool done = false;
 		unsigned char *pPacket = (unsigned char *) base;	// pointer to current packet
 		pPacket+= PACKET_SIZE * vi;								// skip to the appropriate packet start
 		pPacket+= (PACKET_SIZE * VectorLen) * ((src_idx-1)>>4); // skip out to current packet
@@ -1148,9 +1242,9 @@ float AdaptiveDeltaMotionChannelClass::getframe(uint32 frame_idx, uint32 vector_
 		return(CacheData[vector_idx + VectorLen]);
 	}
 
-	if (frame_idx < CacheFrame)  {
+	if (frame_idx < CacheFrame || get_checkpoint(frame_idx) * CheckpointStride > CacheFrame + 1)  {
 		// Requested Frame isn't cached, so cache it, and frame_idx+1, and return the decompressed data
-      // from frame_idx
+      // from frame_idx. This is also done when a checkpoint is closer than the cached frame.
 
       decompress(frame_idx, &CacheData[0]);
 
@@ -1185,7 +1279,8 @@ float AdaptiveDeltaMotionChannelClass::getframe(uint32 frame_idx, uint32 vector_
 
    memcpy(&temp[0], &CacheData[VectorLen], VectorLen * sizeof(float));
 
-   decompress(CacheFrame, &temp[0], frame_idx, &CacheData[0]);
+   // TheSuperHackers @bugfix 19/10/2026 The copied data belongs to CacheFrame+1, not CacheFrame.
+   decompress(CacheFrame + 1, &temp[0], frame_idx, &CacheData[0]);
    CacheFrame = frame_idx;
 
    if (frame_idx != (NumFrames - 1))  {
@@ -48,7 +48,6 @@
 #include "d3dx8math.h"
 #include "statistics.h"
 #include <wwprofile.h>
-#include <algorithm>
 
 
 bool SortingRendererClass::_EnableTriangleDraw=true;
@@ -72,80 +71,97 @@ struct TempIndexStruct
 {
 	ShortVectorIStruct tri;
 	unsigned short idx;
-	float z;
 };
 
-bool operator <(const TempIndexStruct &l, const TempIndexStruct &r) { return l.z < r.z; }
-bool operator <=(const TempIndexStruct &l, const TempIndexStruct &r) { return l.z <= r.z; }
-bool operator >(const TempIndexStruct &l, const TempIndexStruct &r) { return l.z > r.z; }
-bool operator >=(const TempIndexStruct &l, const TempIndexStruct &r) { return l.z >= r.z; }
-bool operator ==(const TempIndexStruct &l, const TempIndexStruct &r) { return l.z == r.z; }
 // ----------------------------------------------------------------------------
-static
-void InsertionSort(TempIndexStruct *begin, TempIndexStruct *end)
+//
+// Float_To_Sort_Key (float f)
+// Maps a float to an unsigned key that sorts in the same order. +0 and -0 map
+// to the same key, because they compare equal.
+//
+// ----------------------------------------------------------------------------
+
+static inline unsigned Float_To_Sort_Key(float f)
 {
-	for (TempIndexStruct *iter = begin + 1; iter < end; ++iter) {
-		TempIndexStruct val = iter[0];
-		TempIndexStruct *insert = iter;
-		while (insert != begin && insert[-1] > val) {
-			insert[0] = insert[-1];
-			insert -= 1;
-		}
-		insert[0] = val;
+	if (f == 0.0f) {
+		f = 0.0f;
 	}
+	unsigned u;
+	memcpy(&u, &f, sizeof(u));
+	return (u & 0x80000000) ? ~u : (u | 0x80000000);
 }
 
 // ----------------------------------------------------------------------------
-static
-void Sort(TempIndexStruct *begin, TempIndexStruct *end)
+//
+// Radix_Sort (T* array, T* temp_array, unsigned* keys, unsigned* temp_keys, unsigned count)
+// Stable sort of 'array' by ascending 'keys'. The temp arrays must hold 'count'
+// elements. Returns the array holding the sorted elements, which is either
+// 'array' or 'temp_array'.
+//
+// ----------------------------------------------------------------------------
+
+template <class T>
+static T* Radix_Sort(T* array, T* temp_array, unsigned* keys, unsigned* temp_keys, unsigned count)
 {
-	const int diff = end - begin;
-	if (diff <= 16) {
+	if (count <= 32) {
 		// Insertion sort has less overhead for small arrays
-		InsertionSort(begin, end);
-	} else {
-		// Choose the median of begin, mid, and (end - 1) as the partitioning element.
-		// Rearrange so that *(begin + 1) <= *begin <= *(end - 1).  These will be guard
-		// elements.
-		TempIndexStruct *mid = begin + diff/2;
-		std::swap(mid[0], begin[1]);
-		if (begin[1] > end[-1]) {
-			std::swap(begin[1], end[-1]);
-		}
-		if (begin[0] > end[-1]) {
-			std::swap(begin[0], end[-1]);
+		for (unsigned i = 1; i < count; ++i) {
+			const unsigned key = keys[i];
+			const T val = array[i];
+			unsigned j = i;
+			while (j > 0 && keys[j-1] > key) {
+				keys[j] = keys[j-1];
+				array[j] = array[j-1];
+				--j;
+			}
+			keys[j] = key;
+			array[j] = val;
 		}
-		if (begin[1] > begin[0]) {
-			std::swap(begin[1], begin[0]);
+		return array;
+	}
+
+	unsigned histogram[4][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (unsigned i = 0; i < count; ++i) {
+		const unsigned key = keys[i];
+		++histogram[0][key & 0xff];
+		++histogram[1][(key >> 8) & 0xff];
+		++histogram[2][(key >> 16) & 0xff];
+		++histogram[3][key >> 24];
+	}
+
+	for (unsigned pass = 0; pass < 4; ++pass) {
+		unsigned* offsets = histogram[pass];
+		const unsigned shift = pass * 8;
+
+		// Skip the pass if all keys share this digit, it would not move anything
+		if (offsets[(keys[0] >> shift) & 0xff] == count) {
+			continue;
 		}
 
-		// *begin is now the partitioning element
-		TempIndexStruct *begin1 = begin + 1;	// TODO: Temp fix until I find out who is passing me NaN
-		TempIndexStruct *end1 = end - 1;			// TODO: Temp fix until I find out who is passing me NaN
-		TempIndexStruct *left = begin + 1;
-		TempIndexStruct *right = end - 1;
-		for (;;) {
-#if 0		// TODO: Temp fix until I find out who is passing me NaN.
-			do ++left; while (left[0] < begin[0]);		// Scan up to find element >= than partition
-			do --right; while (right[0] > begin[0]);	// Scan down to find element <= than partition
-#else
-			do ++left; while (left < end1 && left[0] < begin[0]);		// Scan up to find element >= than partition
-			do --right; while (right > begin1 && right[0] > begin[0]);	// Scan down to find element <= than partition
-#endif
-			if (right < left) break;									// Pointers crossed.  Partitioning completed.
-			std::swap(left[0], right[0]);							// Exchange elements.
+		unsigned offset = 0;
+		for (unsigned b = 0; b < 256; ++b) {
+			const unsigned c = offsets[b];
+			offsets[b] = offset;
+			offset += c;
 		}
-		std::swap(begin[0], right[0]);							// Insert partition element
-
-		// Sort the smaller subarray first then the larger
-		if (right - begin > end - (right + 1)) {
-			Sort(right + 1, end);
-			Sort(begin, right);
-		} else {
-			Sort(begin, right);
-			Sort(right + 1, end);
+
+		for (unsigned i = 0; i < count; ++i) {
+			const unsigned key = keys[i];
+			const unsigned dest = offsets[(key >> shift) & 0xff]++;
+			temp_array[dest] = array[i];
+			temp_keys[dest] = key;
 		}
+
+		T* swap_array = array;
+		array = temp_array;
+		temp_array = swap_array;
+		unsigned* swap_keys = keys;
+		keys = temp_keys;
+		temp_keys = swap_keys;
 	}
+
+	return array;
 }
 
 // ----------------------------------------------------------------------------
@@ -166,10 +182,18 @@ public:
 	unsigned short vertex_count;			// Number of vertices used in vb
 };
 
-static DLListClass<SortingNodeStruct> sorted_list;
 static DLListClass<SortingNodeStruct> clean_list;
 static unsigned total_sorting_vertices;
 
+// TheSuperHackers @performance 19/10/2026 Inserted nodes are appended to a flat array and sorted
+// once at flush time, instead of walking a sorted linked list on every insertion.
+static SortingNodeStruct** sorted_nodes;
+static SortingNodeStruct** sorted_nodes_temp;
+static unsigned* sorted_node_keys;
+static unsigned* sorted_node_keys_temp;
+static unsigned sorted_node_count;
+static unsigned sorted_node_array_count;
+
 static SortingNodeStruct* Get_Sorting_Struct()
 {
 
@@ -189,6 +213,9 @@ static SortingNodeStruct* Get_Sorting_Struct()
 // ----------------------------------------------------------------------------
 
 static TempIndexStruct* temp_index_array;
+static TempIndexStruct* temp_index_sort_array;
+static unsigned* temp_index_keys;
+static unsigned* temp_index_sort_keys;
 static unsigned temp_index_array_count;
 
 static TempIndexStruct* Get_Temp_Index_Array(unsigned count)
@@ -197,12 +224,68 @@ static TempIndexStruct* Get_Temp_Index_Array(unsigned count)
 		count = DEFAULT_SORTING_POLY_COUNT;
 	if (count>temp_index_array_count) {
 		delete[] temp_index_array;
+		delete[] temp_index_sort_array;
+		delete[] temp_index_keys;
+		delete[] temp_index_sort_keys;
 		temp_index_array=W3DNEWARRAY TempIndexStruct[count];
+		temp_index_sort_array=W3DNEWARRAY TempIndexStruct[count];
+		temp_index_keys=W3DNEWARRAY unsigned[count];
+		temp_index_sort_keys=W3DNEWARRAY unsigned[count];
 		temp_index_array_count=count;
 	}
 	return temp_index_array;
 }
 
+static void Release_Temp_Index_Array()
+{
+	delete[] temp_index_array;
+	delete[] temp_index_sort_array;
+	delete[] temp_index_keys;
+	delete[] temp_index_sort_keys;
+	temp_index_array=nullptr;
+	temp_index_sort_array=nullptr;
+	temp_index_keys=nullptr;
+	temp_index_sort_keys=nullptr;
+	temp_index_array_count=0;
+}
+
+// ----------------------------------------------------------------------------
+//
+// Add a node to the sorted nodes. Nodes are drawn in order of decreasing z.
+// Nodes with equal z are drawn in the order they were inserted.
+//
+// ----------------------------------------------------------------------------
+
+static void Add_Sorted_Node(SortingNodeStruct* state)
+{
+	if (sorted_node_count==sorted_node_array_count) {
+		unsigned count=sorted_node_array_count*2;
+		if (count < 256)
+			count = 256;
+
+		SortingNodeStruct** nodes=W3DNEWARRAY SortingNodeStruct*[count];
+		unsigned* keys=W3DNEWARRAY unsigned[count];
+		if (sorted_node_count) {
+			memcpy(nodes,sorted_nodes,sizeof(SortingNodeStruct*)*sorted_node_count);
+			memcpy(keys,sorted_node_keys,sizeof(unsigned)*sorted_node_count);
+		}
+
+		delete[] sorted_nodes;
+		delete[] sorted_nodes_temp;
+		delete[] sorted_node_keys;
+		delete[] sorted_node_keys_temp;
+		sorted_nodes=nodes;
+		sorted_nodes_temp=W3DNEWARRAY SortingNodeStruct*[count];
+		sorted_node_keys=keys;
+		sorted_node_keys_temp=W3DNEWARRAY unsigned[count];
+		sorted_node_array_count=count;
+	}
+
+	sorted_nodes[sorted_node_count]=state;
+	sorted_node_keys[sorted_node_count]=~Float_To_Sort_Key(state->transformed_center.Z);
+	++sorted_node_count;
+}
+
 // ----------------------------------------------------------------------------
 //
 // Insert triangles to the sorting system.
@@ -256,20 +339,7 @@ void SortingRendererClass::Insert_Triangles(
 	state->transformed_center=Vector3(transformed_vec[0],transformed_vec[1],transformed_vec[2]);
 
 
-	/// @todo lorenzen sez use a bucket sort here... and stop copying so much data so many times
-
-	SortingNodeStruct* node=sorted_list.Head();
-	while (node) {
-		if (state->transformed_center.Z>node->transformed_center.Z) {
-			if (sorted_list.Head()==sorted_list.Tail())
-				sorted_list.Add_Head(state);
-			else
-				state->Insert_Before(node);
-			break;
-		}
-		node=node->Succ();
-	}
-	if (!node) sorted_list.Add_Tail(state);
+	Add_Sorted_Node(state);
 
 #ifdef WWDEBUG
 	unsigned short* indices=nullptr;
@@ -410,6 +480,7 @@ void SortingRendererClass::Flush_Sorting_Pool()
 
 	// Fill dynamic index buffer with sorting index buffer vertices
 	TempIndexStruct* tis=Get_Temp_Index_Array(overlapping_polygon_count);
+	unsigned* tis_keys=temp_index_keys;
 
 	unsigned vertexAllocCount = overlapping_vertex_count;
 	if (DynamicVBAccessClass::Get_Default_Vertex_Count() < DEFAULT_SORTING_VERTEX_COUNT)
@@ -471,8 +542,9 @@ void SortingRendererClass::Flush_Sorting_Pool()
 					tis_ptr->tri.j = idx2 + vertex_array_offset;
 					tis_ptr->tri.k = idx3 + vertex_array_offset;
 					tis_ptr->idx = node_id;
-					tis_ptr->z = (v1->z + v2->z + v3->z)/3.0f;
-					DEBUG_ASSERTCRASH((! _isnan(tis_ptr->z) && _finite(tis_ptr->z)), ("Triangle has invalid center"));
+					const float z = (v1->z + v2->z + v3->z)/3.0f;
+					DEBUG_ASSERTCRASH((! _isnan(z) && _finite(z)), ("Triangle has invalid center"));
+					tis_keys[array_index] = Float_To_Sort_Key(z);
 				}
 			} else {
 				for (int i=0;i<state->polygon_count;++i) {
@@ -492,10 +564,11 @@ void SortingRendererClass::Flush_Sorting_Pool()
 					tis_ptr->tri.j = idx2 + vertex_array_offset;
 					tis_ptr->tri.k = idx3 + vertex_array_offset;
 					tis_ptr->idx = node_id;
-					tis_ptr->z = (mtx[0][2]*(v1->x + v2->x + v3->x) +
+					const float z = (mtx[0][2]*(v1->x + v2->x + v3->x) +
 												mtx[1][2]*(v1->y + v2->y + v3->y) +
 												mtx[2][2]*(v1->z + v2->z + v3->z))/3.0f + mtx[3][2];
-					DEBUG_ASSERTCRASH((! _isnan(tis_ptr->z) && _finite(tis_ptr->z)), ("Triangle has invalid center"));
+					DEBUG_ASSERTCRASH((! _isnan(z) && _finite(z)), ("Triangle has invalid center"));
+					tis_keys[array_index] = Float_To_Sort_Key(z);
 				}
 			}
 
@@ -506,7 +579,8 @@ void SortingRendererClass::Flush_Sorting_Pool()
 		}
 	}
 
-	Sort(tis, tis + overlapping_polygon_count);
+	// TheSuperHackers @performance 19/10/2026 Sort the triangles with a stable radix sort on their z.
+	tis=Radix_Sort(tis,temp_index_sort_array,tis_keys,temp_index_sort_keys,overlapping_polygon_count);
 
 /*	///@todo: Add code to break up rendering into multiple index buffer fills to allow more than 65536/3 triangles.  -MW
 	int total_overlapping_polygon_count = overlapping_polygon_count;
@@ -605,8 +679,10 @@ void SortingRendererClass::Flush()
 	DX8Wrapper::Get_Transform(D3DTS_VIEW,old_view);
 	DX8Wrapper::Get_Transform(D3DTS_WORLD,old_world);
 
-	while (SortingNodeStruct* state=sorted_list.Head()) {
-		state->Remove();
+	SortingNodeStruct** nodes=Radix_Sort(sorted_nodes,sorted_nodes_temp,sorted_node_keys,sorted_node_keys_temp,sorted_node_count);
+
+	for (unsigned n=0;n<sorted_node_count;++n) {
+		SortingNodeStruct* state=nodes[n];
 
 		if ((state->sorting_state.index_buffer_type==BUFFER_TYPE_SORTING || state->sorting_state.index_buffer_type==BUFFER_TYPE_DYNAMIC_SORTING) &&
 			(state->sorting_state.vertex_buffer_types[0]==BUFFER_TYPE_SORTING || state->sorting_state.vertex_buffer_types[0]==BUFFER_TYPE_DYNAMIC_SORTING)) {
@@ -620,6 +696,7 @@ void SortingRendererClass::Flush()
 			clean_list.Add_Head(state);
 		}
 	}
+	sorted_node_count=0;
 
 	bool old_enable=DX8Wrapper::_Is_Triangle_Draw_Enabled();
 	DX8Wrapper::_Enable_Triangle_Draw(_EnableTriangleDraw);
@@ -646,12 +723,21 @@ void SortingRendererClass::Deinit()
 	SortingNodeStruct *head = nullptr;
 
 	//
-	//	Flush the sorted list
+	//	Flush the sorted nodes
 	//
-	while ((head = sorted_list.Head ()) != nullptr) {
-		sorted_list.Remove_Head ();
-		delete head;
+	for (unsigned n = 0; n < sorted_node_count; ++n) {
+		delete sorted_nodes[n];
 	}
+	delete[] sorted_nodes;
+	delete[] sorted_nodes_temp;
+	delete[] sorted_node_keys;
+	delete[] sorted_node_keys_temp;
+	sorted_nodes=nullptr;
+	sorted_nodes_temp=nullptr;
+	sorted_node_keys=nullptr;
+	sorted_node_keys_temp=nullptr;
+	sorted_node_count=0;
+	sorted_node_array_count=0;
 
 	//
 	//	Flush the clean list
@@ -661,9 +747,7 @@ void SortingRendererClass::Deinit()
 		delete head;
 	}
 
-	delete[] temp_index_array;
-	temp_index_array=nullptr;
-	temp_index_array_count=0;
+	Release_Temp_Index_Array();
 }
 
 
@@ -723,18 +807,5 @@ void SortingRendererClass::Insert_VolumeParticle(
 
 	//THE TRANSFORMED CENTER[2] IS THE ZBUFFER DEPTH
 
-	/// @todo lorenzen sez use a bucket sort here... and stop copying so much data so many times
-
-	SortingNodeStruct* node=sorted_list.Head();
-	while (node) {
-		if (state->transformed_center.Z>node->transformed_center.Z) {
-			if (sorted_list.Head()==sorted_list.Tail())
-				sorted_list.Add_Head(state);
-			else
-				state->Insert_Before(node);
-			break;
-		}
-		node=node->Succ();
-	}
-	if (!node) sorted_list.Add_Tail(state);
+	Add_Sorted_Node(state);
 }